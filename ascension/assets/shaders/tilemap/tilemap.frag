@@ -0,0 +1,50 @@
+#version 430 core
+in vec2 f_world_position;
+
+out vec4 f_frag_color;
+
+uniform sampler2D u_texture;
+uniform usampler2D u_tiles;
+uniform sampler2D u_tile_rects;
+
+uniform vec2 u_map_position;
+uniform vec2 u_tile_size;
+uniform ivec2 u_map_size;
+uniform int u_tile_count;
+
+const uint EMPTY_TILE = 0xFFFFu;
+// Matches TILE_RECTS_PER_ROW in gpu_tilemap.cpp.
+const int TILE_RECTS_PER_ROW = 256;
+
+void main()
+{
+    vec2 map_position = (f_world_position - u_map_position) / u_tile_size;
+    ivec2 tile_position = ivec2(floor(map_position));
+    if (any(lessThan(tile_position, ivec2(0))) || any(greaterThanEqual(tile_position, u_map_size))) {
+        discard;
+    }
+
+    uint tile = texelFetch(u_tiles, tile_position, 0).r;
+    if (tile == EMPTY_TILE || tile >= uint(u_tile_count)) {
+        discard;
+    }
+
+    int index = int(tile);
+    vec4 rect = texelFetch(u_tile_rects, ivec2(index % TILE_RECTS_PER_ROW, index / TILE_RECTS_PER_ROW), 0);
+    // Tiles missing from the atlas have an empty rect.
+    if (rect.x == rect.z) {
+        discard;
+    }
+
+    // Kept half a texel inside the region so filtering doesn't pull in the neighbouring sub-textures.
+    vec2 half_texel = 0.5 / vec2(textureSize(u_texture, 0));
+    vec2 rect_min = min(rect.xy, rect.zw) + half_texel;
+    vec2 rect_max = max(rect.xy, rect.zw) - half_texel;
+    vec2 tex_coords = clamp(mix(rect.xy, rect.zw, fract(map_position)), rect_min, rect_max);
+
+    // Derivatives of fract jump at tile edges, the unwrapped coordinates give the same gradients without the seams.
+    vec2 tex_coords_scale = rect.zw - rect.xy;
+    f_frag_color = textureGrad(
+        u_texture, tex_coords, dFdx(map_position) * tex_coords_scale, dFdy(map_position) * tex_coords_scale
+    );
+}
@@ -0,0 +1,14 @@
+#version 430 core
+layout (location = 0) in vec2 v_position;
+
+out vec2 f_world_position;
+
+uniform mat4 m_inverse_projection_view;
+
+void main()
+{
+    // The quad covers the screen, each corner is unprojected to find the world position the camera sees there.
+    vec4 world_position = m_inverse_projection_view * vec4(v_position.x, v_position.y, 0.0, 1.0);
+    f_world_position = world_position.xy / world_position.w;
+    gl_Position = vec4(v_position.x, v_position.y, 0.0, 1.0);
+}
@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-02-24 19:27:40
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-08-07 13:37:42
+ * Last Modified: 2026-10-18 15:30:22
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -26,7 +26,14 @@
 
 #include "core/application.hpp"
 
+#include "graphics/animation_system.hpp"
+#include "graphics/gpu_tilemap.hpp"
+#include "graphics/particle_emitter.hpp"
 #include "graphics/sprite_batch.hpp"
+#include "graphics/sprite_font.hpp"
+#include "graphics/tilemap.hpp"
+
+#include "yuki/thread_pool.hpp"
 
 namespace ascension {
 
@@ -45,8 +52,22 @@ public:
     Ascension& operator=(Ascension&&) = delete;
 
 private:
+    void draw_render_stats();
+
     graphics::Sprite_Batch m_sprite_batch;
     graphics::Sprite_Batch m_font_batch;
+    graphics::Animation_System m_animation_system;
+    graphics::Tilemap m_tilemap;
+    graphics::Gpu_Tilemap m_gpu_tilemap;
+    graphics::Particle_Emitter m_particle_emitter;
+    // Shares per frame work such as particle updates between cores.
+    std::unique_ptr<yuki::Thread_Pool> m_thread_pool;
+    m4 m_projection_view{ 1.0f };
+
+    std::shared_ptr<graphics::Sprite_Font> m_debug_font;
+    bool m_show_render_stats{ false };
+    bool m_render_stats_key_down{ false };
+    bool m_flight_dump_key_down{ false };
 };
 
 } // namespace ascension
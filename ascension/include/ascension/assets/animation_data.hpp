@@ -0,0 +1,43 @@
+/**
+ * File: animation_data.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:14:11
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:18:17
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <array>
+
+#include "graphics/animation.hpp"
+
+namespace ascension::assets {
+
+// Frame lists of animations. Written as text .anim files, a "sub_texture_name seconds" line per frame in play order,
+// which the asset packer converts to a binary list of sub-texture ids & durations.
+constexpr std::array<char, 4> ANIMATION_DATA_MAGIC = { 'A', 'N', 'I', 'M' };
+constexpr u32 ANIMATION_DATA_VERSION = 1;
+
+// Parse either format from a buffer, returns false if the data is malformed.
+[[nodiscard]] bool parse_animation_data(const u8* data, u64 size, std::vector<graphics::Animation_Frame>& frames);
+
+[[nodiscard]] std::vector<u8> write_animation_data(const std::vector<graphics::Animation_Frame>& frames);
+
+}
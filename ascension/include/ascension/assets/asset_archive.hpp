@@ -0,0 +1,104 @@
+/**
+ * File: asset_archive.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:25:01
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:18:17
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <array>
+#include <unordered_map>
+
+#include <magic_enum/magic_enum.hpp>
+
+#include "yuki/platform/mapped_file.hpp"
+
+#include "assets/asset_id.hpp"
+#include "assets/asset_types.hpp"
+#include "assets/block_compression.hpp"
+
+namespace ascension::assets {
+
+// A single file bundling pre-processed assets, built offline by the asset packer.
+// Layout: header, asset data (each blob 16 byte aligned), then the index of every entry.
+// The archive is memory mapped & assets are read straight out of the mapping, nothing is copied until the
+// data is handed to OpenGL/FreeType.
+class Asset_Archive {
+public:
+    static constexpr std::array<char, 4> MAGIC = { 'A', 'A', 'R', 'C' };
+    static constexpr u32 VERSION = 4;
+    static constexpr u64 DATA_ALIGNMENT = 16;
+
+    struct Entry {
+        std::string name;
+        // Name of the asset this one is built on, the texture of a Texture_Atlas or the atlas of an Animation.
+        std::string dependency;
+        Asset_Type type{ Asset_Type::Texture };
+        u64 offset{ 0 };
+        u64 size{ 0 };
+
+        // Texture: the dimensions & channel count of the decoded pixels, & the blocks they're compressed into if any.
+        u32 width{ 0 };
+        u32 height{ 0 };
+        u32 channels{ 0 };
+        Block_Compression compression{ Block_Compression::None };
+        // Levels stored one after another from the base level, 1 unless the packer built a mip chain.
+        u32 mip_levels{ 1 };
+        // Shader: the length of the vertex source, which the fragment source follows.
+        u32 vertex_size{ 0 };
+    };
+    using Entry_Map = std::unordered_map<Asset_Id, Entry>;
+
+    Asset_Archive() = default;
+
+    bool open(const std::string& filepath);
+    void close();
+
+    [[nodiscard]] const Entry* find(Asset_Type type, Asset_Id id) const;
+    [[nodiscard]] const u8* data(const Entry& entry) const;
+    [[nodiscard]] const Entry_Map& entries(Asset_Type type) const;
+    [[nodiscard]] bool is_open() const;
+
+    Asset_Archive(const Asset_Archive&) = delete;
+    Asset_Archive(Asset_Archive&&) = delete;
+    Asset_Archive& operator=(const Asset_Archive&) = delete;
+    Asset_Archive& operator=(Asset_Archive&&) = delete;
+
+private:
+    yuki::platform::Mapped_File m_file;
+    // Names are only unique per type, an atlas & its texture share a name.
+    std::array<Entry_Map, magic_enum::enum_count<Asset_Type>()> m_entries;
+};
+
+// Builds an Asset_Archive, used by the asset packer.
+class Asset_Archive_Writer {
+public:
+    // Append an asset, the entry's offset & size are filled in from the data.
+    void add(Asset_Archive::Entry entry, const u8* data, u64 size);
+
+    bool write(const std::string& filepath) const;
+
+private:
+    std::vector<Asset_Archive::Entry> m_entries;
+    std::vector<u8> m_data;
+};
+
+}
@@ -0,0 +1,53 @@
+/**
+ * File: asset_id.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:30:24
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 14:33:56
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "yuki/hash.hpp"
+
+namespace ascension::assets {
+
+// Hash of an asset's full name e.g. textures/unicorn, the same at compile time & runtime.
+using Asset_Id = u64;
+
+constexpr Asset_Id
+make_asset_id(std::string_view asset_name)
+{
+    return yuki::hash_fnv1a_64(asset_name);
+}
+
+namespace literals {
+
+// "textures/unicorn"_asset, resolves the id of an asset at compile time.
+constexpr Asset_Id
+operator""_asset(const char* asset_name, size_t length)
+{
+    return make_asset_id({ asset_name, length });
+}
+
+}
+
+}
@@ -0,0 +1,114 @@
+/**
+ * File: asset_index.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:30:33
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:46:32
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <array>
+#include <optional>
+
+#include "assets/asset_id.hpp"
+#include "assets/asset_types.hpp"
+
+namespace ascension::assets {
+
+class Asset_Manifest;
+
+// The asset descriptions of the manifests, compiled into a flat table looked up by asset id through a minimal
+// perfect hash. Built offline by the asset packer into a .idx file which is loaded with a single read, or built
+// at startup from the xml manifests in development.
+class Asset_Index {
+public:
+    static constexpr std::array<char, 4> MAGIC = { 'A', 'I', 'D', 'X' };
+    static constexpr u32 VERSION = 3;
+
+    Asset_Index() = default;
+
+    void clear();
+
+    // Compile the index from parsed xml manifests, returns false if two assets hash to the same id.
+    bool build(const Asset_Manifest& manifest);
+
+    bool load(const std::string& filepath);
+    bool write(const std::string& filepath) const;
+
+    [[nodiscard]] std::optional<Animation_Asset> find_animation(Asset_Id id) const;
+    [[nodiscard]] std::optional<Font_Asset> find_font(Asset_Id id) const;
+    [[nodiscard]] std::optional<Shader_Asset> find_shader(Asset_Id id) const;
+    [[nodiscard]] std::optional<Texture_Asset> find_texture(Asset_Id id) const;
+    [[nodiscard]] std::optional<Texture_Atlas_Asset> find_texture_atlas(Asset_Id id) const;
+
+    // Get the assets loaded from a file, shaders match either of their source files. A linear search, for reloading
+    // changed files rather than loading.
+    [[nodiscard]] std::vector<Asset_Reference> find_by_file(const std::string& filepath) const;
+    // Get the textures packed into a generated atlas, ordered by id so they always pack the same way.
+    [[nodiscard]] std::vector<Asset_Id> find_atlas_members(const std::string& atlas) const;
+
+    [[nodiscard]] size_t count(Asset_Type type) const;
+    [[nodiscard]] size_t size() const;
+
+private:
+    // Fixed size so the table can be read & written as is, strings are offsets into m_strings.
+    struct Record {
+        u64 key;
+        u32 type;
+        u32 flags;
+        u32 name;
+        u32 filepath;
+        // The texture of a Texture_Atlas, or the texture atlas of an Animation.
+        u32 sub_texture_id;
+        u32 vertex_src_file;
+        u32 fragment_src_file;
+        f32 scale;
+        u32 scale_filter;
+        u32 atlas;
+    };
+    static_assert(sizeof(Record) == 48, "Asset_Index::Record is written to disk as is, changes need a VERSION bump");
+
+    static constexpr u32 FLAG_FLIP_ON_LOAD = 1U << 0U;
+    static constexpr u32 FLAG_MIPMAPS = 1U << 1U;
+    // The page texture & atlas records of a generated atlas.
+    static constexpr u32 FLAG_GENERATED_ATLAS = 1U << 2U;
+
+    // Names are only unique per type, an atlas & its texture share a name, so the type is folded into the key.
+    [[nodiscard]] static u64 make_key(Asset_Type type, Asset_Id id);
+    [[nodiscard]] static Asset_Id get_id(const Record& record);
+
+    [[nodiscard]] const Record* find(Asset_Type type, Asset_Id id) const;
+    [[nodiscard]] const char* get_string(u32 offset) const;
+    [[nodiscard]] Asset get_asset(const Record& record) const;
+    u32 add_string(const std::string& value);
+    void add_record(const Asset& asset, Record record);
+
+    // Compute the displacements & slots of the perfect hash over m_records.
+    bool build_hash();
+
+    // Records sorted by type then key, so the assets of a type are contiguous.
+    std::vector<Record> m_records;
+    // Perfect hash: the key picks a bucket, the bucket's displacement picks the slot, the slot holds the record index.
+    std::vector<u32> m_displacements;
+    std::vector<u32> m_slots;
+    std::vector<char> m_strings;
+};
+
+}
@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-13 14:45:21
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-07-22 16:05:51
+ * Last Modified: 2026-10-18 16:25:12
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -24,11 +24,23 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <type_traits>
 
+#include "assets/asset_archive.hpp"
+#include "assets/asset_index.hpp"
 #include "assets/asset_types.hpp"
+#include "assets/handle.hpp"
+
+namespace yuki {
+class Thread_Pool;
+}
+
+namespace yuki::platform {
+class File_Watcher;
+}
 
 namespace ascension::graphics {
+class Animation;
 class Shader;
 class Sprite_Font;
 class Texture_2D;
@@ -37,11 +49,15 @@ class Texture_Atlas;
 
 namespace ascension::assets {
 
+using Animation_Handle = Handle<graphics::Animation>;
+using Font_Handle = Handle<graphics::Sprite_Font>;
+using Shader_Handle = Handle<graphics::Shader>;
+using Texture_Handle = Handle<graphics::Texture_2D>;
+using Texture_Atlas_Handle = Handle<graphics::Texture_Atlas>;
+
 // TODO: Look at registering loaders for asset types through templates so we can move internal implementation
 // /t    details of asset loading away from the asset manager to specific loader classes.
 // /t    register_loader<Font_Asset, Sprite_Font>(std::shared_ptr<AssetLoader<>());
-// /t    We can also have the loaders look after usage counts for deleting assets for when we want to share
-// /t    assets between assets, like texture & texture_atlas or fonts & shaders
 class Asset_Manager {
 public:
     Asset_Manager() = default;
@@ -49,23 +65,73 @@ public:
 
     void clear();
 
+    // Load a compiled .idx asset index, or compile one from an xml manifest & every manifest it references.
     void load_asset_file(const std::string& asset_file);
-
-    std::shared_ptr<graphics::Texture_2D> load_texture_2d(const std::string& asset_name);
-    std::shared_ptr<graphics::Texture_2D> get_texture_2d(const std::string& asset_name);
-    void unload_texture_2d(const std::string& asset_name);
-
-    std::shared_ptr<graphics::Texture_Atlas> load_texture_atlas(const std::string& asset_name);
-    std::shared_ptr<graphics::Texture_Atlas> get_texture_atlas(const std::string& asset_name);
-    void unload_texture_atlas(const std::string& asset_name);
-
-    std::shared_ptr<graphics::Shader> load_shader(const std::string& asset_name);
-    std::shared_ptr<graphics::Shader> get_shader(const std::string& asset_name);
-    void unload_shader(const std::string& asset_name);
-
-    std::shared_ptr<graphics::Sprite_Font> load_font(const std::string& asset_name);
-    std::shared_ptr<graphics::Sprite_Font> get_font(const std::string& asset_name);
-    void unload_font(const std::string& asset_name);
+    // Map a packed asset archive, assets in the archive are loaded from it in preference to the manifests.
+    bool load_asset_archive(const std::string& archive_file);
+
+    // Assets are loaded by id, e.g. load_texture_2d("textures/unicorn"_asset), loading an asset which is already
+    // loaded returns the existing handle. Invalid handles are returned for unknown assets.
+    // Every load is a use of the asset until a matching unload, an asset is only freed once it has no users.
+    // Assets which depend on another, atlases on their texture, fonts on their shader & animations on their atlas,
+    // count as one of its users.
+    // Textures packed into a generated atlas are views of the atlas page & users of the atlas.
+    Texture_Handle load_texture_2d(Asset_Id asset_id);
+    void unload_texture_2d(Texture_Handle handle);
+
+    Texture_Atlas_Handle load_texture_atlas(Asset_Id asset_id);
+    void unload_texture_atlas(Texture_Atlas_Handle handle);
+
+    Shader_Handle load_shader(Asset_Id asset_id);
+    void unload_shader(Shader_Handle handle);
+
+    Font_Handle load_font(Asset_Id asset_id);
+    void unload_font(Font_Handle handle);
+
+    Animation_Handle load_animation(Asset_Id asset_id);
+    void unload_animation(Animation_Handle handle);
+
+    // Load a group of assets & everything they depend on, as with the load_* functions.
+    // Files are read & decoded in parallel on worker threads while the calling thread, which must own the GL context,
+    // creates the GL objects as they become ready. Afterwards the load_* functions return the preloaded handles.
+    // Preloaded assets have no users until they're loaded.
+    void preload(const std::vector<Asset_Reference>& group);
+
+    // Keep unused textures cached up to budget_bytes of texture memory, evicting the least recently used beyond it.
+    // Only textures nobody has loaded are evicted, so recency is when they were last loaded or unloaded, get() doesn't
+    // count as a use. 0, the default, frees textures as soon as their last user unloads them.
+    void set_texture_budget(u64 budget_bytes);
+
+    // GPU memory used by loaded assets of a type, atlas textures count as textures & glyph textures as fonts.
+    [[nodiscard]] u64 get_resident_bytes(Asset_Type type) const;
+
+    // Development only, watch the asset directory & reload loaded shaders, textures & atlases in place when their
+    // files change, so existing handles & shared_ptrs see the new version. Changed manifests rebuild the index.
+    // Assets in a loaded archive aren't reloaded, the archive takes precedence over the files.
+    bool enable_hot_reload(const std::string& directory);
+    // Reload anything which has changed since the last update, call once a frame on the context thread.
+    void update();
+
+    // Resolve a handle to its asset, nullptr once the asset has been unloaded. Cheap enough to call every frame.
+    template<typename T>
+    [[nodiscard]] T* get(Handle<T> handle) const
+    {
+        return get_pool<T>().get(handle);
+    }
+
+    // Share ownership of an asset, for objects which keep hold of it such as batches & atlases.
+    template<typename T>
+    [[nodiscard]] std::shared_ptr<T> share(Handle<T> handle) const
+    {
+        return get_pool<T>().share(handle);
+    }
+
+    // Get the handle of an asset if it's already loaded, else an invalid handle.
+    template<typename T>
+    [[nodiscard]] Handle<T> find(Asset_Id asset_id) const
+    {
+        return get_pool<T>().find(asset_id);
+    }
 
     Asset_Manager(const Asset_Manager&) = default;
     Asset_Manager(Asset_Manager&&) = delete;
@@ -73,17 +139,86 @@ public:
     Asset_Manager& operator=(Asset_Manager&&) = delete;
 
 private:
-    void parse_asset_document(const std::string& document_filepath, const std::string& root_name);
-
-    std::unordered_map<std::string, Font_Asset> m_font_filepaths;
-    std::unordered_map<std::string, Shader_Asset> m_shader_filepaths;
-    std::unordered_map<std::string, Texture_Asset> m_texture_filepaths;
-    std::unordered_map<std::string, Texture_Atlas_Asset> m_texture_atlas_filepaths;
-
-    std::unordered_map<std::string, std::shared_ptr<graphics::Shader>> m_loaded_shaders;
-    std::unordered_map<std::string, std::shared_ptr<graphics::Sprite_Font>> m_loaded_fonts;
-    std::unordered_map<std::string, std::shared_ptr<graphics::Texture_2D>> m_loaded_textures;
-    std::unordered_map<std::string, std::shared_ptr<graphics::Texture_Atlas>> m_loaded_texture_atlas;
+    template<typename T>
+    [[nodiscard]] const Handle_Pool<T>& get_pool() const
+    {
+        if constexpr (std::is_same_v<T, graphics::Texture_2D>) {
+            return m_textures;
+        }
+        else if constexpr (std::is_same_v<T, graphics::Texture_Atlas>) {
+            return m_texture_atlases;
+        }
+        else if constexpr (std::is_same_v<T, graphics::Shader>) {
+            return m_shaders;
+        }
+        else if constexpr (std::is_same_v<T, graphics::Animation>) {
+            return m_animations;
+        }
+        else {
+            static_assert(std::is_same_v<T, graphics::Sprite_Font>, "Asset_Manager doesn't manage this asset type");
+            return m_fonts;
+        }
+    }
+
+    // Everything involved in loading an asset short of creating GL objects.
+    struct Decoded_Asset;
+
+    // Read & decode an asset, only reads from the index & archive so it's safe to call from worker threads.
+    [[nodiscard]] std::unique_ptr<Decoded_Asset> decode(Asset_Reference asset) const;
+    // Decode a loose texture on its own, also used for the textures which didn't fit in their generated atlas.
+    static bool decode_texture_file(const Texture_Asset& texture, Decoded_Asset& decoded);
+
+    // Create the GL objects of a decoded asset & add it to its pool, the asset's dependencies are loaded if needed.
+    Texture_Handle create_texture_2d(const Decoded_Asset& decoded);
+    Texture_Atlas_Handle create_texture_atlas(const Decoded_Asset& decoded);
+    Shader_Handle create_shader(const Decoded_Asset& decoded);
+    Font_Handle create_font(const Decoded_Asset& decoded);
+    Animation_Handle create_animation(const Decoded_Asset& decoded);
+    void create(const Decoded_Asset& decoded);
+
+    // Free an asset which has no users left, releasing its use of the asset it depends on.
+    void destroy_texture_2d(Texture_Handle handle);
+    void destroy_texture_atlas(Texture_Atlas_Handle handle);
+    void destroy_font(Font_Handle handle);
+    void destroy_animation(Animation_Handle handle);
+
+    // Free unused textures, least recently used first, until the resident textures fit the budget.
+    void evict_textures();
+
+    void reload_file(const std::string& filepath);
+    void reload(Asset_Reference asset);
+    // Rebuild a generated atlas page & point the textures packed into it at their new regions.
+    void reload_generated_atlas(Asset_Id atlas_id);
+
+    [[nodiscard]] bool is_loaded(Asset_Reference asset) const;
+    [[nodiscard]] std::optional<Asset_Reference> get_dependency(Asset_Reference asset) const;
+
+    [[nodiscard]] const Asset_Archive::Entry* find_archive_entry(Asset_Type type, Asset_Id asset_id) const;
+    [[nodiscard]] Asset_Id get_atlas_texture_id(Asset_Id asset_id) const;
+    [[nodiscard]] Asset_Id get_animation_atlas_id(Asset_Id asset_id) const;
+    [[nodiscard]] std::vector<Texture_Asset> get_atlas_members(const std::string& atlas) const;
+
+    Asset_Index m_index;
+    std::string m_asset_file;
+    std::shared_ptr<Asset_Archive> m_archive;
+    // Created by the first preload, shared so copies of the manager don't spin up their own workers.
+    std::shared_ptr<yuki::Thread_Pool> m_thread_pool;
+    u64 m_texture_budget{ 0 };
+    std::shared_ptr<yuki::platform::File_Watcher> m_file_watcher;
+
+    Handle_Pool<graphics::Animation> m_animations;
+    Handle_Pool<graphics::Shader> m_shaders;
+    Handle_Pool<graphics::Sprite_Font> m_fonts;
+    Handle_Pool<graphics::Texture_2D> m_textures;
+    Handle_Pool<graphics::Texture_Atlas> m_texture_atlases;
+
+    struct Atlas_Member {
+        Asset_Id atlas;
+        // graphics::Sub_Texture_Id of the texture's name in the atlas.
+        u64 sub_texture_id;
+    };
+    // Loaded textures which are views of a generated atlas.
+    std::unordered_map<Asset_Id, Atlas_Member> m_atlas_members;
 };
 
 }
@@ -0,0 +1,60 @@
+/**
+ * File: asset_manifest.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:24:37
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:18:17
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <unordered_map>
+
+#include "assets/asset_types.hpp"
+
+namespace ascension::assets {
+
+// Parses the xml asset manifests into the descriptions of every known asset, keyed by their full asset name
+// e.g. textures/unicorn. Kept free of graphics code so the offline asset packer can share it.
+class Asset_Manifest {
+public:
+    Asset_Manifest() = default;
+
+    void clear();
+
+    // Parse a manifest & every Asset_List it references, returns false if the root manifest couldn't be loaded.
+    bool load(const std::string& manifest_file);
+
+    [[nodiscard]] const std::unordered_map<std::string, Animation_Asset>& animations() const;
+    [[nodiscard]] const std::unordered_map<std::string, Font_Asset>& fonts() const;
+    [[nodiscard]] const std::unordered_map<std::string, Shader_Asset>& shaders() const;
+    [[nodiscard]] const std::unordered_map<std::string, Texture_Asset>& textures() const;
+    [[nodiscard]] const std::unordered_map<std::string, Texture_Atlas_Asset>& texture_atlases() const;
+
+private:
+    bool parse_asset_document(const std::string& document_filepath, const std::string& root_name);
+
+    std::unordered_map<std::string, Animation_Asset> m_animations;
+    std::unordered_map<std::string, Font_Asset> m_fonts;
+    std::unordered_map<std::string, Shader_Asset> m_shaders;
+    std::unordered_map<std::string, Texture_Asset> m_textures;
+    std::unordered_map<std::string, Texture_Atlas_Asset> m_texture_atlases;
+};
+
+}
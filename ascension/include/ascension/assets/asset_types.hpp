@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-14 13:56:09
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-07-22 15:39:21
+ * Last Modified: 2026-10-18 15:18:17
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -24,9 +24,13 @@
 
 #pragma once
 
+#include "assets/asset_id.hpp"
+#include "assets/image_resize.hpp"
+
 namespace ascension::assets {
 
 enum class Asset_Type {
+    Animation,
     Asset_List,
     Font,
     Shader,
@@ -41,12 +45,22 @@ struct Asset {
 };
 
 struct Texture_Asset : public Asset {
+    // Applied once when the texture is decoded, or by the asset packer for packed textures.
     f32 scale{ 1.0 };
+    Resize_Filter scale_filter{ Resize_Filter::Lanczos3 };
     bool flip_on_load{ true };
+    // Sampled with a mip chain, built by the asset packer or generated when the texture is uploaded.
+    bool mipmaps{ false };
+    // The generated atlas this texture is packed into, loaded as a view of the atlas page rather than on its own.
+    std::string atlas;
+    // The page of a generated atlas, built from the textures packed into it rather than loaded from a file.
+    bool is_atlas_page{ false };
 };
 
 struct Texture_Atlas_Asset : public Asset {
     std::string sub_texture_id;
+    // Built from the textures which name it as their atlas, sub-textures are named after them.
+    bool is_generated{ false };
 };
 
 struct Shader_Asset : public Asset {
@@ -56,4 +70,15 @@ struct Shader_Asset : public Asset {
 
 struct Font_Asset : public Asset {};
 
+struct Animation_Asset : public Asset {
+    // Full name of the atlas the frames are sub-textures of, e.g. textures/fruits.
+    std::string texture_atlas;
+};
+
+// An asset id & its type, ids alone are ambiguous as an atlas & its texture share a name.
+struct Asset_Reference {
+    Asset_Type type;
+    Asset_Id id;
+};
+
 }
@@ -0,0 +1,58 @@
+/**
+ * File: atlas_builder.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:01:36
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:06:38
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+namespace ascension::assets {
+
+// Loose textures marked with an <atlas> in the manifests are packed into a generated atlas page, at load time or
+// offline by the asset packer, so sprites drawn from any of them share a texture & batch together.
+constexpr u32 ATLAS_MAX_PAGE_SIZE = 4096;
+// Texels around each image repeating its edges, so filtering at the edges doesn't pick up the neighbouring images.
+constexpr u32 ATLAS_PADDING = 2;
+
+struct Atlas_Layout {
+    u32 width{ 0 };
+    u32 height{ 0 };
+    // The x0, y0, x1, y1 region of each image in texels, zero sized for images which didn't fit in the page.
+    std::vector<v4u> regions;
+};
+
+// Shelf pack images tallest first into the smallest square power of two page they fit, up to max_size. Images which
+// don't fit in the largest page are left out, the page is cropped to the rows used.
+[[nodiscard]] Atlas_Layout
+pack_atlas(const std::vector<v2u>& sizes, u32 max_size = ATLAS_MAX_PAGE_SIZE, u32 padding = ATLAS_PADDING);
+
+// Copy a 3 or 4 channel image into its region of an RGBA page, extending its edges into the padding.
+void blit_atlas_image(
+    const u8* pixels,
+    u32 channels,
+    const v4u& region,
+    u8* page,
+    u32 page_width,
+    u32 page_height,
+    u32 padding = ATLAS_PADDING
+);
+
+}
@@ -0,0 +1,45 @@
+/**
+ * File: atlas_data.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:08:29
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:12:13
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <array>
+
+#include "graphics/texture_atlas.hpp"
+
+namespace ascension::assets {
+
+// Sub-texture lists of texture atlases. Written as text .dat files, a "name x0 y0 x1 y1" line per sub-texture, which
+// the asset packer converts to a binary list sorted by id so packed atlases load with a single copy.
+constexpr std::array<char, 4> ATLAS_DATA_MAGIC = { 'A', 'T', 'L', 'S' };
+constexpr u32 ATLAS_DATA_VERSION = 1;
+
+static_assert(sizeof(graphics::Sub_Texture_Region) == 24, "Sub_Texture_Region is written to disk as is");
+
+// Parse either format from a buffer, returns false if the data is malformed.
+[[nodiscard]] bool parse_atlas_data(const u8* data, u64 size, std::vector<graphics::Sub_Texture_Region>& sub_textures);
+
+[[nodiscard]] std::vector<u8> write_atlas_data(std::vector<graphics::Sub_Texture_Region> sub_textures);
+
+}
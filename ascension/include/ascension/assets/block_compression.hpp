@@ -0,0 +1,50 @@
+/**
+ * File: block_compression.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:46:25
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 14:48:03
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+namespace ascension::assets {
+
+// GPU block compression formats, textures are split into 4x4 texel blocks each stored in a fixed number of bytes.
+//   BC1 (DXT1): 8 bytes per block, opaque RGB, 6:1 against RGB8 & 8:1 against RGBA8.
+//   BC3 (DXT5): 16 bytes per block, RGB as BC1 plus a separately interpolated alpha, 4:1 against RGBA8.
+enum class Block_Compression : u32 {
+    None,
+    BC1,
+    BC3,
+};
+
+// Pick the format for a decoded image, BC1 unless it has alpha below 255. Only 3 & 4 channel images are compressed.
+[[nodiscard]] Block_Compression choose_block_compression(const u8* pixels, u32 width, u32 height, u32 channels);
+
+[[nodiscard]] u64 get_block_compressed_size(Block_Compression compression, u32 width, u32 height);
+
+// Compress a 3 or 4 channel image, partial blocks at the right & bottom edges repeat the edge texels.
+[[nodiscard]] std::vector<u8>
+compress_blocks(Block_Compression compression, const u8* pixels, u32 width, u32 height, u32 channels);
+
+// Decompress to RGBA8, for drivers without support for the format.
+[[nodiscard]] std::vector<u8> decompress_blocks(Block_Compression compression, const u8* blocks, u32 width, u32 height);
+
+}
@@ -0,0 +1,255 @@
+/**
+ * File: handle.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:34:40
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:25:12
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <utility>
+
+#include "assets/asset_id.hpp"
+
+namespace ascension::assets {
+
+template<typename T>
+class Handle_Pool;
+
+// A typed reference to an asset in a Handle_Pool, the slot index plus the generation of the slot when the handle was
+// made. Once the asset is removed its slot's generation changes, so stale handles resolve to nullptr instead of
+// whatever asset reuses the slot. The default handle is null, generation 0 is never used by a slot.
+template<typename T>
+class Handle {
+public:
+    Handle() = default;
+
+    [[nodiscard]] bool is_valid() const { return m_generation != 0; }
+    [[nodiscard]] u32 index() const { return m_index; }
+    [[nodiscard]] u32 generation() const { return m_generation; }
+
+    bool operator==(const Handle& other) const { return m_index == other.m_index && m_generation == other.m_generation; }
+    bool operator!=(const Handle& other) const { return !(*this == other); }
+
+private:
+    friend class Handle_Pool<T>;
+
+    Handle(u32 index, u32 generation)
+      : m_index(index)
+      , m_generation(generation)
+    {
+    }
+
+    u32 m_index{ 0 };
+    u32 m_generation{ 0 };
+};
+
+// Dense slots of assets addressed by Handle<T>, resolving a handle is a bounds check & generation compare.
+// Assets are still owned through shared_ptr so objects which hold on to them (atlases, batches) keep them alive,
+// but resolving hands out a raw pointer so there's no refcount traffic on the hot path.
+// Each slot also counts its users, the pool itself never removes an asset which is no longer used, the
+// Asset_Manager decides whether to free it straight away or keep it cached until it needs the memory.
+template<typename T>
+class Handle_Pool {
+public:
+    // Insert an asset with no users, byte_size is the memory it keeps resident.
+    Handle<T> insert(Asset_Id id, std::shared_ptr<T> value, u64 byte_size = 0)
+    {
+        u32 index = 0;
+        if (!m_free_slots.empty()) {
+            index = m_free_slots.back();
+            m_free_slots.pop_back();
+        }
+        else {
+            index = static_cast<u32>(m_slots.size());
+            m_slots.emplace_back();
+        }
+
+        auto& slot = m_slots[index];
+        slot.value = std::move(value);
+        slot.id = id;
+        slot.byte_size = byte_size;
+        slot.usage_count = 0;
+        slot.last_used = ++m_tick;
+        m_ids[id] = index;
+        m_resident_bytes += byte_size;
+
+        return { index, slot.generation };
+    }
+
+    void remove(Handle<T> handle)
+    {
+        if (get_slot(handle) == nullptr) {
+            return;
+        }
+
+        auto& slot = m_slots[handle.index()];
+        m_ids.erase(slot.id);
+        m_resident_bytes -= slot.byte_size;
+        slot.value.reset();
+        // Skip 0 on wrap around, it's the generation of null handles.
+        slot.generation = slot.generation == ~0U ? 1 : slot.generation + 1;
+        m_free_slots.push_back(handle.index());
+    }
+
+    void clear()
+    {
+        for (u32 index = 0; index < m_slots.size(); ++index) {
+            if (m_slots[index].value) {
+                remove({ index, m_slots[index].generation });
+            }
+        }
+    }
+
+    // Users are counted & recency updated on acquire & release only, resolving a handle with get() leaves the pool
+    // untouched so it stays cheap & const.
+    void acquire(Handle<T> handle)
+    {
+        if (auto* slot = get_slot(handle)) {
+            ++slot->usage_count;
+            slot->last_used = ++m_tick;
+        }
+    }
+
+    // Returns true when the last user released the asset.
+    bool release(Handle<T> handle)
+    {
+        auto* slot = get_slot(handle);
+        if (slot == nullptr || slot->usage_count == 0) {
+            return false;
+        }
+
+        slot->last_used = ++m_tick;
+        return --slot->usage_count == 0;
+    }
+
+    // Get the least recently used asset which could be freed: no users & not shared outside of the pool, removing
+    // an asset which is still shared wouldn't free anything. Returns an invalid handle if there's none.
+    [[nodiscard]] Handle<T> find_unused() const
+    {
+        const Slot* oldest = nullptr;
+        u32 oldest_index = 0;
+        for (u32 index = 0; index < m_slots.size(); ++index) {
+            const auto& slot = m_slots[index];
+            if (!slot.value || slot.usage_count != 0 || slot.value.use_count() != 1) {
+                continue;
+            }
+
+            if (oldest == nullptr || slot.last_used < oldest->last_used) {
+                oldest = &slot;
+                oldest_index = index;
+            }
+        }
+
+        return oldest != nullptr ? Handle<T>{ oldest_index, oldest->generation } : Handle<T>{};
+    }
+
+    // Update the memory an asset keeps resident, after it has been reloaded in place.
+    void set_byte_size(Handle<T> handle, u64 byte_size)
+    {
+        if (auto* slot = get_slot(handle)) {
+            m_resident_bytes = m_resident_bytes - slot->byte_size + byte_size;
+            slot->byte_size = byte_size;
+        }
+    }
+
+    template<typename Function>
+    void for_each(Function&& function) const
+    {
+        for (const auto& slot : m_slots) {
+            if (slot.value) {
+                function(*slot.value);
+            }
+        }
+    }
+
+    [[nodiscard]] T* get(Handle<T> handle) const
+    {
+        const auto* slot = get_slot(handle);
+        return slot != nullptr ? slot->value.get() : nullptr;
+    }
+
+    [[nodiscard]] std::shared_ptr<T> share(Handle<T> handle) const
+    {
+        const auto* slot = get_slot(handle);
+        return slot != nullptr ? slot->value : nullptr;
+    }
+
+    [[nodiscard]] Handle<T> find(Asset_Id id) const
+    {
+        const auto index = m_ids.find(id);
+        if (index == m_ids.end()) {
+            return {};
+        }
+
+        return { index->second, m_slots[index->second].generation };
+    }
+
+    [[nodiscard]] Asset_Id get_id(Handle<T> handle) const
+    {
+        const auto* slot = get_slot(handle);
+        return slot != nullptr ? slot->id : 0;
+    }
+
+    [[nodiscard]] u32 usage_count(Handle<T> handle) const
+    {
+        const auto* slot = get_slot(handle);
+        return slot != nullptr ? slot->usage_count : 0;
+    }
+
+    [[nodiscard]] size_t size() const { return m_ids.size(); }
+    [[nodiscard]] u64 resident_bytes() const { return m_resident_bytes; }
+
+private:
+    struct Slot {
+        std::shared_ptr<T> value;
+        Asset_Id id{ 0 };
+        u64 byte_size{ 0 };
+        u64 last_used{ 0 };
+        u32 usage_count{ 0 };
+        u32 generation{ 1 };
+    };
+
+    [[nodiscard]] const Slot* get_slot(Handle<T> handle) const
+    {
+        if (handle.index() >= m_slots.size()) {
+            return nullptr;
+        }
+
+        const auto& slot = m_slots[handle.index()];
+        return slot.generation == handle.generation() && slot.value ? &slot : nullptr;
+    }
+
+    [[nodiscard]] Slot* get_slot(Handle<T> handle)
+    {
+        return const_cast<Slot*>(std::as_const(*this).get_slot(handle)); // NOLINT
+    }
+
+    std::vector<Slot> m_slots;
+    std::vector<u32> m_free_slots;
+    // Only used to find an already loaded asset by id, never when resolving handles.
+    std::unordered_map<Asset_Id, u32> m_ids;
+    u64 m_resident_bytes{ 0 };
+    // Orders uses for least recently used eviction.
+    u64 m_tick{ 0 };
+};
+
+}
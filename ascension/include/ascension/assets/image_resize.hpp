@@ -0,0 +1,55 @@
+/**
+ * File: image_resize.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:55:16
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 14:57:12
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+namespace ascension::assets {
+
+// Kernels for resizing images, applied separately along each axis & widened when shrinking so every source texel
+// contributes to the result.
+//   Box: averages the texels covered, nearest neighbour when enlarging.
+//   Bilinear: triangle filter, soft but cheap.
+//   Lanczos3: windowed sinc over 3 lobes, the sharpest of the three with slight ringing on hard edges.
+enum class Resize_Filter : u32 {
+    Box,
+    Bilinear,
+    Lanczos3,
+};
+
+// The length of an edge after scaling, never less than 1 texel.
+[[nodiscard]] u32 get_scaled_length(u32 length, f32 scale);
+
+// Resize a 1 to 4 channel image. Colour is filtered premultiplied by alpha for 4 channel images so fully transparent
+// texels don't bleed into their neighbours.
+[[nodiscard]] std::vector<u8> resize_image(
+    const u8* pixels,
+    u32 width,
+    u32 height,
+    u32 channels,
+    u32 new_width,
+    u32 new_height,
+    Resize_Filter filter = Resize_Filter::Lanczos3
+);
+
+}
@@ -0,0 +1,102 @@
+/**
+ * File: sub_texture_data.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:56:46
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:57:31
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <array>
+#include <charconv>
+
+#include "graphics/texture_atlas.hpp"
+
+namespace ascension::assets {
+
+// The pieces shared by the data files which list sub-textures, atlas .dat & animation .anim files. The binary format
+// is a 4 byte magic, the version & record count, then the records. The text format is a line per record, the
+// sub-texture name followed by the record's values separated by spaces.
+using Sub_Texture_Data_Magic = std::array<char, 4>;
+
+constexpr size_t SUB_TEXTURE_DATA_HEADER_SIZE = sizeof(Sub_Texture_Data_Magic) + 2 * sizeof(u32);
+
+[[nodiscard]] bool is_binary_sub_texture_data(const u8* data, u64 size, const Sub_Texture_Data_Magic& magic);
+// The record count of binary data, false if the version doesn't match or the records run past the end of the data.
+[[nodiscard]] bool read_sub_texture_data_header(const u8* data, u64 size, u32 version, u64 record_size, u32& count);
+// Binary data sized for count records, the header written & the records left for the caller.
+[[nodiscard]] std::vector<u8>
+make_sub_texture_data(const Sub_Texture_Data_Magic& magic, u32 version, u32 count, u64 record_size);
+
+constexpr bool
+is_sub_texture_text_space(char character)
+{
+    return character == ' ' || character == '\t' || character == '\r';
+}
+
+// Read the next value of a line with from_chars, skipping the spaces before it.
+template<typename T>
+[[nodiscard]] bool
+read_sub_texture_text_value(const char*& it, const char* end, T& value)
+{
+    while (it != end && is_sub_texture_text_space(*it)) {
+        ++it;
+    }
+
+    const auto [next, error] = std::from_chars(it, end, value);
+    if (error != std::errc{}) {
+        return false;
+    }
+    it = next;
+    return true;
+}
+
+// A single pass over the text, names are hashed in place. parse_record(id, it, end) reads the values of the record
+// following its name, returning false if they're malformed.
+template<typename Parse_Record>
+[[nodiscard]] bool
+parse_sub_texture_text(const u8* data, u64 size, Parse_Record&& parse_record)
+{
+    const auto* it = reinterpret_cast<const char*>(data); // NOLINT
+    const char* const end = it + size;                    // NOLINT
+    while (it != end) {
+        while (it != end && (is_sub_texture_text_space(*it) || *it == '\n')) {
+            ++it;
+        }
+        if (it == end) {
+            break;
+        }
+
+        const char* name_end = it;
+        while (name_end != end && !is_sub_texture_text_space(*name_end) && *name_end != '\n') {
+            ++name_end;
+        }
+
+        const auto id = graphics::make_sub_texture_id({ it, static_cast<size_t>(name_end - it) });
+        it = name_end;
+        if (!parse_record(id, it, end)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
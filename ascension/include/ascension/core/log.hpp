@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-18 19:02:06
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-04-26 15:16:16
+ * Last Modified: 2026-10-18 14:03:41
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -28,48 +28,106 @@
 
 namespace ascension::core::log {
 
+using Channel = yuki::debug::Log_Channel;
+using Channel_Config = yuki::debug::Log_Channel_Config;
+
 static constexpr const char* SOURCE_NAME = { "ascension" };
 
+inline Channel
+register_channel(const std::string& name, const Channel_Config& config = {})
+{
+    return yuki::debug::Logger::register_channel(name, config);
+}
+
+inline Channel
+get_channel()
+{
+    static const Channel s_channel = register_channel(SOURCE_NAME);
+    return s_channel;
+}
+
 template<typename... Args>
 static void
 debug(const std::string& format, Args&&... args)
 {
-    yuki::debug::Logger::debug(SOURCE_NAME, format, std::forward<Args>(args)...);
+    yuki::debug::Logger::debug(get_channel(), format, std::forward<Args>(args)...);
 }
 
 template<typename... Args>
 static void
 info(const std::string& format, Args&&... args)
 {
-    yuki::debug::Logger::info(SOURCE_NAME, format, std::forward<Args>(args)...);
+    yuki::debug::Logger::info(get_channel(), format, std::forward<Args>(args)...);
 }
 
 template<typename... Args>
 static void
 notice(const std::string& format, Args&&... args)
 {
-    yuki::debug::Logger::notice(SOURCE_NAME, format, std::forward<Args>(args)...);
+    yuki::debug::Logger::notice(get_channel(), format, std::forward<Args>(args)...);
 }
 
 template<typename... Args>
 static void
 warn(const std::string& format, Args&&... args)
 {
-    yuki::debug::Logger::warn(SOURCE_NAME, format, std::forward<Args>(args)...);
+    yuki::debug::Logger::warn(get_channel(), format, std::forward<Args>(args)...);
 }
 
 template<typename... Args>
 static void
 error(const std::string& format, Args&&... args)
 {
-    yuki::debug::Logger::error(SOURCE_NAME, format, std::forward<Args>(args)...);
+    yuki::debug::Logger::error(get_channel(), format, std::forward<Args>(args)...);
 }
 
 template<typename... Args>
 static void
 critical(const std::string& format, Args&&... args)
 {
-    yuki::debug::Logger::critical(SOURCE_NAME, format, std::forward<Args>(args)...);
+    yuki::debug::Logger::critical(get_channel(), format, std::forward<Args>(args)...);
+}
+
+template<typename... Args>
+static void
+debug(Channel channel, const std::string& format, Args&&... args)
+{
+    yuki::debug::Logger::debug(channel, format, std::forward<Args>(args)...);
+}
+
+template<typename... Args>
+static void
+info(Channel channel, const std::string& format, Args&&... args)
+{
+    yuki::debug::Logger::info(channel, format, std::forward<Args>(args)...);
+}
+
+template<typename... Args>
+static void
+notice(Channel channel, const std::string& format, Args&&... args)
+{
+    yuki::debug::Logger::notice(channel, format, std::forward<Args>(args)...);
+}
+
+template<typename... Args>
+static void
+warn(Channel channel, const std::string& format, Args&&... args)
+{
+    yuki::debug::Logger::warn(channel, format, std::forward<Args>(args)...);
+}
+
+template<typename... Args>
+static void
+error(Channel channel, const std::string& format, Args&&... args)
+{
+    yuki::debug::Logger::error(channel, format, std::forward<Args>(args)...);
+}
+
+template<typename... Args>
+static void
+critical(Channel channel, const std::string& format, Args&&... args)
+{
+    yuki::debug::Logger::critical(channel, format, std::forward<Args>(args)...);
 }
 
 }
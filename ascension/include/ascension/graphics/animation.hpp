@@ -0,0 +1,66 @@
+/**
+ * File: animation.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:13:49
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:18:17
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include "graphics/texture_atlas.hpp"
+
+namespace ascension::graphics {
+
+struct Animation_Frame {
+    Sub_Texture_Id sub_texture_id{ 0 };
+    // Seconds the frame is shown for.
+    f32 duration{ 0.0f };
+};
+
+// A sprite-sheet animation, a sequence of sub-textures of one atlas each shown for their own duration.
+class Animation {
+public:
+    Animation() = default;
+
+    // Frames are resolved to their sub-textures here, recreate the animation if the atlas changes.
+    void create(const std::shared_ptr<Texture_Atlas>& atlas, std::vector<Animation_Frame> frames);
+
+    // Frame indices wrap around, so indices from before a reload which removed frames stay valid.
+    [[nodiscard]] const Sub_Texture_Rect& get_frame(u32 index) const;
+    [[nodiscard]] f32 get_frame_duration(u32 index) const;
+    [[nodiscard]] u32 frame_count() const;
+    // The length of one play through of every frame in seconds.
+    [[nodiscard]] f32 duration() const;
+
+    [[nodiscard]] const std::vector<Animation_Frame>& frames() const;
+    [[nodiscard]] const std::shared_ptr<Texture_Atlas>& get_atlas() const;
+    [[nodiscard]] const std::shared_ptr<Texture_2D>& get_texture() const;
+
+private:
+    std::shared_ptr<Texture_Atlas> m_atlas;
+    std::vector<Animation_Frame> m_frames;
+
+    // Kept apart from m_frames so advancing an animation only reads the durations.
+    std::vector<f32> m_durations;
+    std::vector<Sub_Texture_Rect> m_rects;
+    f32 m_duration{ 0.0f };
+};
+
+}
@@ -0,0 +1,92 @@
+/**
+ * File: animation_system.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:14:34
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:18:17
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+namespace ascension::graphics {
+
+class Animation;
+class Sprite_Batch;
+
+// A playing animation in an Animation_System, the slot index plus the generation of the slot when it started playing.
+// Stale instances, ones which have been stopped, are ignored rather than affecting whichever instance reuses the slot.
+struct Animation_Instance {
+    u32 index{ 0 };
+    u32 generation{ 0 };
+
+    [[nodiscard]] bool is_valid() const { return generation != 0; }
+};
+
+// Advances & draws every playing instance of any number of animations. Instances are kept in flat arrays, one per
+// field, rather than as objects so an update is a single loop over the times & frames with no per-instance calls.
+class Animation_System {
+public:
+    Animation_System() = default;
+
+    // Instances loop unless told otherwise, a finished instance stays on its last frame until it's stopped.
+    Animation_Instance
+    play(const std::shared_ptr<Animation>& animation, const v2f& position, bool loop = true, f32 speed = 1.0f);
+    void stop(Animation_Instance instance);
+    void clear();
+
+    void set_position(Animation_Instance instance, const v2f& position);
+    void set_speed(Animation_Instance instance, f32 speed);
+    [[nodiscard]] bool is_finished(Animation_Instance instance) const;
+
+    void update(f64 delta_time);
+    // Emit the current frame of every instance into the sprite batch, instances of animations from the same atlas
+    // share batches.
+    void draw(Sprite_Batch& sprite_batch) const;
+
+    [[nodiscard]] u32 size() const;
+
+private:
+    // The dense index of a live instance, or nullptr if it's been stopped.
+    [[nodiscard]] const u32* find(Animation_Instance instance) const;
+
+    static constexpr u8 FLAG_LOOP = 1U << 0U;
+    static constexpr u8 FLAG_FINISHED = 1U << 1U;
+
+    // Every animation played so far, instances refer to them by index.
+    std::vector<std::shared_ptr<Animation>> m_animations;
+
+    // Per instance, dense & in step. Stopping an instance moves the last one into its place.
+    std::vector<u32> m_animation_indices;
+    std::vector<u32> m_frames;
+    // Seconds into the current frame.
+    std::vector<f32> m_times;
+    std::vector<f32> m_speeds;
+    std::vector<v2f> m_positions;
+    std::vector<u8> m_flags;
+    std::vector<u32> m_slot_indices;
+
+    struct Slot {
+        u32 dense_index;
+        u32 generation;
+    };
+    std::vector<Slot> m_slots;
+    std::vector<u32> m_free_slots;
+};
+
+}
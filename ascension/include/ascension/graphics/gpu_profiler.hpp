@@ -0,0 +1,107 @@
+/**
+ * File: gpu_profiler.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:09:32
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 14:10:29
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <limits>
+
+namespace ascension::graphics {
+
+// Measures GPU time of render scopes with GL_TIMESTAMP queries, results are read back a few frames later
+// (so the CPU never waits on the GPU) and emitted on the GPU track of the active Instrumentor session.
+class Gpu_Profiler {
+public:
+    static constexpr u32 INVALID_SCOPE = std::numeric_limits<u32>::max();
+    static constexpr u32 DEFAULT_FRAME_LATENCY = 3;
+    static constexpr u32 DEFAULT_MAX_SCOPES = 128;
+
+    static bool initialize(u32 frame_latency = DEFAULT_FRAME_LATENCY, u32 max_scopes_per_frame = DEFAULT_MAX_SCOPES);
+    static void shutdown();
+
+    // Reads back the oldest in-flight frame's queries and starts recording into its slot.
+    static void begin_frame();
+
+    static u32 begin_scope(const char* name);
+    static void end_scope(u32 scope);
+
+    [[nodiscard]] static bool is_initialized();
+    [[nodiscard]] static u64 dropped_scope_count();
+
+private:
+    struct Scope {
+        const char* name{ nullptr };
+        u32 begin_query{ 0 };
+        u32 end_query{ 0 };
+    };
+
+    struct Frame {
+        std::vector<Scope> scopes;
+        u32 scope_count{ 0 };
+    };
+
+    static void collect_frame(Frame& frame);
+    static void calibrate();
+
+    static bool s_initialized;
+    static std::vector<u32> s_queries;
+    static std::vector<Frame> s_frames;
+    static u32 s_frame_index;
+    static u32 s_frames_since_calibration;
+    static i64 s_clock_offset_ns;
+    static u64 s_dropped_scopes;
+};
+
+class Gpu_Profiler_Scope {
+public:
+    explicit Gpu_Profiler_Scope(const char* name)
+      : m_scope(Gpu_Profiler::begin_scope(name))
+    {
+    }
+
+    ~Gpu_Profiler_Scope()
+    {
+        Gpu_Profiler::end_scope(m_scope);
+    }
+
+    Gpu_Profiler_Scope(const Gpu_Profiler_Scope&) = delete;
+    Gpu_Profiler_Scope(Gpu_Profiler_Scope&&) = delete;
+    Gpu_Profiler_Scope& operator=(const Gpu_Profiler_Scope&) = delete;
+    Gpu_Profiler_Scope& operator=(Gpu_Profiler_Scope&&) = delete;
+
+private:
+    u32 m_scope;
+};
+
+}
+
+#ifdef YUKI_DEBUG
+// NOLINTNEXTLINE
+#define PROFILE_GPU_SCOPE_LINE_INTERNAL(name, line) ascension::graphics::Gpu_Profiler_Scope gpu_timer##line(name)
+#define PROFILE_GPU_SCOPE_LINE(name, line) PROFILE_GPU_SCOPE_LINE_INTERNAL(name, line) // NOLINT
+#define PROFILE_GPU_SCOPE(name) PROFILE_GPU_SCOPE_LINE(name, __LINE__)                 // NOLINT
+#else
+#define PROFILE_GPU_SCOPE_LINE_INTERNAL(name, line)
+#define PROFILE_GPU_SCOPE_LINE(name, line)
+#define PROFILE_GPU_SCOPE(name)
+#endif
@@ -0,0 +1,109 @@
+/**
+ * File: gpu_tilemap.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:21:36
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:53:39
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <unordered_map>
+
+#include "graphics/texture_atlas.hpp"
+
+namespace ascension::graphics {
+
+class Shader;
+class Vertex_Array_Object;
+class Vertex_Buffer_Object;
+
+// A tilemap stored on the GPU as a texture of tile indices & drawn as one full-screen quad. The fragment shader finds
+// the tile under each pixel & samples its atlas region, so the CPU cost of drawing doesn't depend on the map's size
+// & editing a tile uploads a single texel. Tiles are atlas sub-texture ids as in Tilemap, the texture holds indices
+// into the ids the map has used so it stays 16 bits a tile.
+class Gpu_Tilemap {
+public:
+    static constexpr Sub_Texture_Id EMPTY_TILE = 0;
+
+    Gpu_Tilemap();
+    ~Gpu_Tilemap();
+
+    // Every tile starts empty. The shader is drawn with as the tilemap shader, assets/shaders/tilemap/.
+    void create(
+        u32 width,
+        u32 height,
+        const v2u& tile_size,
+        const std::shared_ptr<Texture_Atlas>& atlas,
+        const std::shared_ptr<Shader>& shader
+    );
+
+    void set_tile(u32 x, u32 y, Sub_Texture_Id tile);
+    // Set a width x height block of row major tiles in one upload, the bottom left corner at x, y.
+    void set_tiles(u32 x, u32 y, u32 width, u32 height, const Sub_Texture_Id* tiles);
+    [[nodiscard]] Sub_Texture_Id get_tile(u32 x, u32 y) const;
+
+    // World position of the bottom left corner of tile 0, 0.
+    void set_position(const v2f& position);
+
+    // Draw the map over everything the camera sees, projection_view being the camera's sprite batch projection.
+    // The atlas regions are uploaded again first if the map has used new ids or the atlas has been reloaded.
+    void draw(const m4& projection_view);
+
+    [[nodiscard]] u32 width() const;
+    [[nodiscard]] u32 height() const;
+
+    Gpu_Tilemap(const Gpu_Tilemap&) = delete;
+    Gpu_Tilemap(Gpu_Tilemap&&) = delete;
+    Gpu_Tilemap& operator=(const Gpu_Tilemap&) = delete;
+    Gpu_Tilemap& operator=(Gpu_Tilemap&&) = delete;
+
+private:
+    // The index of a tile id in the tile texture, added the first time the id is used.
+    [[nodiscard]] u16 get_tile_index(Sub_Texture_Id tile);
+    void update_tile_rects();
+
+    u32 m_width;
+    u32 m_height;
+    v2u m_tile_size;
+    v2f m_position;
+
+    std::shared_ptr<Texture_Atlas> m_atlas;
+    std::shared_ptr<Shader> m_shader;
+
+    // Row major tile indices, row 0 is the bottom of the map. Kept so tiles can be read back without touching the GPU.
+    std::vector<u16> m_tiles;
+    std::vector<Sub_Texture_Id> m_tile_ids;
+    std::unordered_map<Sub_Texture_Id, u16> m_tile_indices;
+    // Scratch space for converting the ids passed to set_tiles.
+    std::vector<u16> m_upload_tiles;
+
+    // One texel per tile.
+    std::unique_ptr<Texture_2D> m_tile_texture;
+    // One texel per tile id holding its texture coordinates, in rows of TILE_RECTS_PER_ROW.
+    std::unique_ptr<Texture_2D> m_tile_rect_texture;
+    u32 m_tile_rect_count;
+    // The atlas version the rects were built from.
+    u32 m_atlas_version;
+
+    std::unique_ptr<Vertex_Array_Object> m_vao;
+    std::shared_ptr<Vertex_Buffer_Object> m_vbo;
+};
+
+}
@@ -0,0 +1,122 @@
+/**
+ * File: particle_emitter.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:25:23
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:30:22
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <random>
+
+namespace yuki {
+class Thread_Pool;
+}
+
+namespace ascension::graphics {
+
+class Batch;
+class Shader;
+class Texture_2D;
+
+struct Particle_Emitter_Config {
+    // Particles spawned per second, 0 only spawns through emit.
+    f32 emission_rate{ 0.0f };
+    // Seconds, picked uniformly per particle.
+    f32 min_lifetime{ 1.0f };
+    f32 max_lifetime{ 1.0f };
+    // Pixels per second, each component picked uniformly per particle.
+    v2f min_velocity{ 0.0f };
+    v2f max_velocity{ 0.0f };
+    // Applied to every particle, such as gravity.
+    v2f acceleration{ 0.0f };
+    // Size in pixels & colour are interpolated from start to end over each particle's life.
+    f32 start_size{ 8.0f };
+    f32 end_size{ 8.0f };
+    v4f start_color{ 1.0f };
+    v4f end_color{ 1.0f };
+};
+
+// A pool of particles spawned from one point & drawn with one texture. Particles are kept in flat arrays, one per
+// field, & updated with SIMD kernels over the whole pool, dead particles are removed by moving the last one into
+// their place. Drawing writes each particle's quad straight into the emitter's batch. Both can be split into jobs
+// on a thread pool.
+class Particle_Emitter {
+public:
+    Particle_Emitter();
+    ~Particle_Emitter();
+
+    // The shader is drawn with as a sprite batch shader which also reads a colour from location 2, such as
+    // assets/shaders/particle/, its projection is left to the caller. The texture may be a view of an atlas region.
+    void create(
+        u32 max_particles,
+        const Particle_Emitter_Config& config,
+        const std::shared_ptr<Texture_2D>& texture,
+        const std::shared_ptr<Shader>& shader
+    );
+
+    void set_config(const Particle_Emitter_Config& config);
+    // Where new particles spawn, particles already alive aren't moved.
+    void set_position(const v2f& position);
+
+    // Spawn count particles now, as many as fit in the pool.
+    void emit(u32 count);
+    void clear();
+
+    // Move & age every particle, remove the dead ones then spawn this update's share of the emission rate.
+    void update(f64 delta_time, yuki::Thread_Pool* thread_pool = nullptr);
+    void draw(yuki::Thread_Pool* thread_pool = nullptr);
+
+    [[nodiscard]] u32 size() const;
+    [[nodiscard]] u32 capacity() const;
+
+    Particle_Emitter(const Particle_Emitter&) = delete;
+    Particle_Emitter(Particle_Emitter&&) = delete;
+    Particle_Emitter& operator=(const Particle_Emitter&) = delete;
+    Particle_Emitter& operator=(Particle_Emitter&&) = delete;
+
+private:
+    void integrate(u32 begin, u32 end, f32 delta_time);
+    void write_quads(u32 begin, u32 end, f32* positions, f32* texture_coords, u32* colors) const;
+    void remove_dead();
+
+    Particle_Emitter_Config m_config;
+    v2f m_position;
+
+    std::shared_ptr<Texture_2D> m_texture;
+    std::shared_ptr<Batch> m_batch;
+
+    // Per particle, dense & in step, the first m_count of each are alive. Sized to the capacity up front so the
+    // kernels never reallocate.
+    u32 m_count;
+    std::vector<f32> m_position_x;
+    std::vector<f32> m_position_y;
+    std::vector<f32> m_velocity_x;
+    std::vector<f32> m_velocity_y;
+    // Seconds alive & 1 / lifetime, their product is how far through its life a particle is.
+    std::vector<f32> m_ages;
+    std::vector<f32> m_inverse_lifetimes;
+
+    // Fractional particles owed by the emission rate, carried between updates.
+    f32 m_emission_remainder;
+    std::minstd_rand m_random;
+};
+
+}
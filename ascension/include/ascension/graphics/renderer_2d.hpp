@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-29 16:55:06
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-07-17 21:06:07
+ * Last Modified: 2026-10-18 15:49:34
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -26,6 +26,10 @@
 
 namespace ascension::graphics {
 
+class Sampler;
+class Texture_2D;
+enum class Sampler_Filter : u32;
+
 enum class Blend_Function : u32 {
     SRC_COLOR,
     DST_COLOR,
@@ -33,19 +37,59 @@ enum class Blend_Function : u32 {
     DST_ALPHA,
 };
 
+// Per-frame counters of the work submitted to the GPU, used to budget content.
+struct Render_Stats {
+    u32 draw_calls{ 0 };
+    u32 quads{ 0 };
+    u64 bytes_uploaded{ 0 };
+    u32 texture_binds{ 0 };
+    u32 shader_binds{ 0 };
+    u32 vertex_array_binds{ 0 };
+    u32 batches_created{ 0 };
+    u32 batches_flushed{ 0 };
+    // Sprites thrown away because their batch, or every batch of a Sprite_Batch, was full.
+    u32 sprites_dropped{ 0 };
+};
+
 class Renderer_2D {
 public:
     static bool initialize();
+    static void shutdown();
+
+    // Completes the previous frame's render stats and starts counting the next frame.
+    static void begin_frame();
 
     static void set_clear_color(v4f color);
     static void clear();
 
     static void enable_blending(Blend_Function blend_func = Blend_Function::SRC_ALPHA);
 
+    static void record_draw_call();
+    static void record_quads(u32 count);
+    static void record_upload(u64 bytes);
+    static void record_texture_bind();
+    static void record_shader_bind();
+    static void record_vertex_array_bind();
+    static void record_batch_created();
+    static void record_batch_flushed();
+    static void record_sprites_dropped(u32 count);
+
+    // Shared clamped samplers, LINEAR is bound to texture unit 0 unless a batch asks for another.
+    [[nodiscard]] static const std::shared_ptr<Sampler>& get_sampler(Sampler_Filter filter);
+    // TRILINEAR for textures with a mip chain, so their levels are used, LINEAR for the rest.
+    [[nodiscard]] static const std::shared_ptr<Sampler>& get_default_sampler(const Texture_2D& texture);
+
     [[nodiscard]] static bool is_initialized();
+    // Stats of the last completed frame.
+    [[nodiscard]] static const Render_Stats& get_frame_stats();
 
 private:
     static bool s_initialized;
+
+    static std::vector<std::shared_ptr<Sampler>> s_samplers;
+
+    static Render_Stats s_current_stats;
+    static Render_Stats s_frame_stats;
 };
 
 }
@@ -0,0 +1,67 @@
+/**
+ * File: sampler.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:50:03
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 14:53:53
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+namespace ascension::graphics {
+
+enum class Sampler_Filter : u32 {
+    NEAREST,
+    LINEAR,
+    // Linear between texels & mip levels, only differs from LINEAR for textures with a mip chain.
+    TRILINEAR,
+};
+
+enum class Sampler_Wrap : u32 {
+    CLAMP_TO_EDGE,
+    REPEAT,
+};
+
+// Filtering & wrapping state shared between textures, bound to a texture unit in place of per texture parameters.
+class Sampler {
+public:
+    Sampler();
+    ~Sampler();
+
+    bool create(Sampler_Filter filter, Sampler_Wrap wrap = Sampler_Wrap::CLAMP_TO_EDGE);
+    void bind(u32 unit = 0) const;
+    static void unbind(u32 unit = 0);
+
+    [[nodiscard]] u32 id() const;
+    [[nodiscard]] Sampler_Filter filter() const;
+    [[nodiscard]] Sampler_Wrap wrap() const;
+
+    Sampler(const Sampler&) = delete;
+    Sampler(Sampler&&) = delete;
+    Sampler& operator=(const Sampler&) = delete;
+    Sampler& operator=(Sampler&&) = delete;
+
+private:
+    u32 m_id;
+
+    Sampler_Filter m_filter;
+    Sampler_Wrap m_wrap;
+};
+
+}
@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-05-08 20:36:09
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-05-08 20:51:53
+ * Last Modified: 2026-10-18 15:30:22
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -41,6 +41,8 @@ enum class Shader_Data_Type : u32 {
     Int3,
     Int4,
     Bool,
+    // Packed bytes such as RGBA colours, normalized to 0-1 floats in the shader.
+    UByte,
     COUNT
 };
 
@@ -72,6 +74,8 @@ size_of_shader_data_type(Shader_Data_Type type, i32 count = 1)
             return 4 * 4 * count;
         case Shader_Data_Type::Bool:
             return 1 * count;
+        case Shader_Data_Type::UByte:
+            return 1 * count;
         default:
             return 0;
     }
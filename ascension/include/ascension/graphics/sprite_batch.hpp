@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-15 14:54:37
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-08-10 11:50:44
+ * Last Modified: 2026-10-18 15:49:34
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -32,8 +32,10 @@ namespace ascension::graphics {
 class Vertex_Buffer_Object;
 class Index_Buffer_Object;
 
+class Sampler;
 class Shader;
 class Sprite_Font;
+struct Sub_Texture_Rect;
 
 struct Batch_Config {
     Batch_Config()
@@ -47,11 +49,13 @@ struct Batch_Config {
         u32 _size,
         const std::shared_ptr<Texture_2D>& _texture,
         const std::shared_ptr<Shader>& _shader,
-        bool _is_static = false
+        bool _is_static = false,
+        const std::shared_ptr<Sampler>& _sampler = nullptr
     )
       : max_size(_size)
       , texture(_texture)
       , shader(_shader)
+      , sampler(_sampler)
       , is_static(_is_static)
     {
     }
@@ -59,9 +63,24 @@ struct Batch_Config {
     u32 max_size{};
     std::shared_ptr<Texture_2D> texture;
     std::shared_ptr<Shader> shader;
+    // Renderer_2D's default sampler for the texture when null.
+    std::shared_ptr<Sampler> sampler;
     // TODO: Consider removing this and just having things which need static drawing keep their own filled out Batch
     // /t objects which are added to the sprite batch every frame - would require "removing" empty batches to avoid max_size
     bool is_static{};
+    // Adds a per vertex RGBA colour in location 2, the shader has to read it. Sprites added without one are white.
+    bool has_colors{};
+};
+
+// Quads appended to a batch by Batch::allocate_quads, written in place rather than copied in a sprite at a time.
+// Vertices are wound bottom left, top left, top right then bottom right as Batch::add does.
+struct Batch_Quads {
+    // 2 floats per vertex, 8 per quad.
+    f32* positions{ nullptr };
+    f32* texture_coords{ nullptr };
+    // RGBA bytes packed with red in the low byte, 4 per quad. Null unless the batch has colours.
+    u32* colors{ nullptr };
+    u32 count{ 0 };
 };
 
 class Batch {
@@ -72,11 +91,16 @@ public:
     void create(const Batch_Config& config);
 
     void set_texture(const std::shared_ptr<Texture_2D>& texture);
+    void set_sampler(const std::shared_ptr<Sampler>& sampler);
     void set_is_static(bool is_static);
 
     void add(const v2f& position, const v2u& size, const v4f& tex_coords);
     void add(const Texture_2D& sub_texture, const v2f& position);
+    void add(const Sub_Texture_Rect& sub_texture, const v2f& position);
     void add(const std::shared_ptr<Texture_2D>& texture, const v2f& position);
+    // Append up to count quads for the caller to fill, fewer when the batch is nearly full. The pointers stay valid
+    // until the next add, allocate_quads or clear.
+    [[nodiscard]] Batch_Quads allocate_quads(u32 count);
 
     void flush();
     void clear();
@@ -93,10 +117,12 @@ private:
     std::unique_ptr<Vertex_Array_Object> m_vao;
     std::shared_ptr<Vertex_Buffer_Object> m_vbo;
     std::shared_ptr<Vertex_Buffer_Object> m_ubo;
+    std::shared_ptr<Vertex_Buffer_Object> m_cbo;
     std::shared_ptr<Index_Buffer_Object> m_ibo;
 
     std::vector<f32> m_vertex_positions;
     std::vector<f32> m_texture_coords;
+    std::vector<u32> m_colors;
 };
 
 class Sprite_Batch {
@@ -109,6 +135,9 @@ public:
     void add_batch(const std::shared_ptr<Batch>& batch);
     void create_batch(const Batch_Config& config);
 
+    // Sampler used by every batch, including ones already created.
+    void set_sampler(const std::shared_ptr<Sampler>& sampler);
+
     void flush();
 
     void draw_texture(const std::shared_ptr<Texture_2D>& texture, const v2f& position, bool is_static = false);
@@ -118,6 +147,12 @@ public:
         const v2f& position,
         bool is_static = false
     );
+    void draw_texture(
+        const std::shared_ptr<Texture_2D>& texture,
+        const Sub_Texture_Rect& sub_texture,
+        const v2f& position,
+        bool is_static = false
+    );
 
     void draw_string(
         const std::shared_ptr<Sprite_Font>& font,
@@ -133,6 +168,7 @@ private:
 
     u32 m_batch_size;
     std::shared_ptr<Shader> m_default_shader;
+    std::shared_ptr<Sampler> m_sampler;
 
     void draw_texture_internal(
         const std::shared_ptr<Texture_2D>& texture,
@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-07-17 20:38:36
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-08-10 11:46:59
+ * Last Modified: 2026-10-18 14:42:02
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -64,11 +64,22 @@ public:
     static bool initialize();
 
     void create(std::string filepath, const std::shared_ptr<Shader>& font_shader);
+    // Create the font from a font file already in memory, such as a packed asset archive.
+    // data must stay valid for the lifetime of the font, data_owner is held to keep it alive.
+    void create(
+        std::string name,
+        const u8* data,
+        u64 data_size,
+        std::shared_ptr<const void> data_owner,
+        const std::shared_ptr<Shader>& font_shader
+    );
 
     [[nodiscard]] static bool is_initialized();
 
     [[nodiscard]] const Glyph& get_glyph(u32 character, u32 font_size);
     [[nodiscard]] const v2 measure_string(const std::string& value, u32 font_size);
+    // Memory used by the glyph textures of every size rendered so far.
+    [[nodiscard]] u64 texture_bytes() const;
 
     Sprite_Font(const Sprite_Font&) = default;
     Sprite_Font(Sprite_Font&&) = delete;
@@ -81,6 +92,10 @@ private:
     std::string m_filepath;
     std::shared_ptr<Shader> m_shader;
 
+    const u8* m_font_data{ nullptr };
+    u64 m_font_data_size{ 0 };
+    std::shared_ptr<const void> m_font_data_owner;
+
     Glyph m_empty_glyph;
     Font_Cache m_font_cache;
 
@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-11 19:35:38
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-08-06 16:40:10
+ * Last Modified: 2026-10-18 15:23:29
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -31,23 +31,54 @@ public:
     enum class Format : u32 {
         RGB = 0,
         RGBA = 1,
-        RED = 2
+        RED = 2,
+        // Block compressed, data holds 4x4 texel blocks produced by the asset packer.
+        BC1 = 3,
+        BC3 = 4,
+        // Data textures read with texelFetch rather than sampled as images, R16UI has to use a NEAREST sampler.
+        R16UI = 5,
+        RGBA32F = 6
     };
 
+    // Passed as mip_levels to have the driver build the whole mip chain from the base level.
+    static constexpr u32 GENERATE_MIP_CHAIN = 0;
+
     Texture_2D();
     ~Texture_2D();
 
     // TODO: Add and check create result.
-    void create(u32 width, u32 height, u8* data, Format format = Texture_2D::Format::RGBA);
-    void create(u32 width, u32 height, v4f texture_coords, u8* data, Format format = Texture_2D::Format::RGBA);
-    void bind() const;
+    // With more than one mip level, data holds each level one after another starting from the base level.
+    void create(
+        u32 width,
+        u32 height,
+        const u8* data,
+        Format format = Texture_2D::Format::RGBA,
+        u32 mip_levels = 1
+    );
+    // A region of another texture, such as an atlas sub-texture. Views share the texture's GL object & keep it alive,
+    // so drawing views of the same texture batches together. Calling create on a view detaches it.
+    void create_view(const std::shared_ptr<Texture_2D>& texture, u32 width, u32 height, v4f texture_coords);
+    // Replace a region of the base level, data is tightly packed in the texture's format. Not for compressed formats.
+    void update(u32 x, u32 y, u32 width, u32 height, const u8* data);
+    void bind(u32 unit = 0) const;
     static void unbind();
 
+    // Block compressed formats depend on the driver, unsupported formats have to be decompressed before creating.
+    [[nodiscard]] static bool is_format_supported(Format format);
+    // Levels in a full mip chain down to 1x1.
+    [[nodiscard]] static u32 get_mip_chain_length(u32 width, u32 height);
+    // Bytes used by the first mip_levels levels, which is also where the next level starts in create's data.
+    [[nodiscard]] static u64 get_byte_size(Format format, u32 width, u32 height, u32 mip_levels = 1);
+
     [[nodiscard]] u32 id() const;
+    [[nodiscard]] bool is_view() const;
 
     [[nodiscard]] u32 width() const;
     [[nodiscard]] u32 height() const;
     [[nodiscard]] v2u size() const;
+    [[nodiscard]] u32 mip_levels() const;
+    // Memory used by the texture's pixels on the GPU, views don't own any.
+    [[nodiscard]] u64 byte_size() const;
 
     [[nodiscard]] v4f texture_coords() const;
 
@@ -57,6 +88,7 @@ public:
     friend bool operator<(const Texture_2D& tex_1, const Texture_2D& tex_2);
     friend bool operator>(const Texture_2D& tex_1, const Texture_2D& tex_2);
 
+    // NOTE: Copying a texture which owns its GL object leaves both deleting it, only views are safe to copy.
     Texture_2D(const Texture_2D&) = default;
     Texture_2D(Texture_2D&&) = delete;
     Texture_2D& operator=(const Texture_2D&) = default;
@@ -64,11 +96,14 @@ public:
 
 private:
     u32 m_id;
+    // The texture a view is a region of.
+    std::shared_ptr<Texture_2D> m_parent;
 
     u32 m_width;
     u32 m_height;
 
     Format m_format;
+    u32 m_mip_levels;
 
     v4f m_texture_coords;
 };
@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-07-05 18:49:32
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-07-18 20:54:24
+ * Last Modified: 2026-10-18 15:56:17
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -25,28 +25,64 @@
 #ifndef ASCENSION_GRAPHICS_TEXTURE_ATLAS_HPP
 #define ASCENSION_GRAPHICS_TEXTURE_ATLAS_HPP
 
-#include <unordered_map>
+#include <string_view>
+
+#include "yuki/hash.hpp"
 
 #include "graphics/texture_2d.hpp"
 
 namespace ascension::graphics {
 
+// Hash of a sub-texture's name, the same at compile time & runtime so hot lookups can skip hashing the name.
+using Sub_Texture_Id = u64;
+
+constexpr Sub_Texture_Id
+make_sub_texture_id(std::string_view name)
+{
+    return yuki::hash_fnv1a_64(name);
+}
+
+// The x0, y0, x1, y1 texels of a sub-texture in the atlas texture.
+struct Sub_Texture_Region {
+    Sub_Texture_Id id{ 0 };
+    v4u region{ 0 };
+};
+
+// Everything a batch needs to draw a sub-texture of the atlas texture.
+struct Sub_Texture_Rect {
+    v4f texture_coords{ 0.0f };
+    v2u size{ 0 };
+};
+
 class Texture_Atlas {
 public:
     Texture_Atlas() = default;
 
-    void create(const std::shared_ptr<Texture_2D>& texture, const std::unordered_map<std::string, v4u>& sub_textures);
+    void create(const std::shared_ptr<Texture_2D>& texture, std::vector<Sub_Texture_Region> sub_textures);
+
+    // Null if the atlas has no sub-texture with the id. Sub-textures are only addressed by id, their order follows
+    // the id hashes so it changes whenever one is added or renamed.
+    [[nodiscard]] const Sub_Texture_Rect* find_sub_texture(Sub_Texture_Id id) const;
+    [[nodiscard]] u32 size() const;
 
-    const Texture_2D& get_sub_texture(const std::string& name) const;
-    const Texture_2D& get_sub_texture(u32 coords_id) const;
+    // Sub-textures are views of the atlas texture, drawing them batches with anything else drawn from the atlas.
+    [[nodiscard]] Texture_2D get_sub_texture(const std::string& name) const;
+    [[nodiscard]] bool has_sub_texture(const std::string& name) const;
 
     const std::shared_ptr<Texture_2D>& get_texture() const;
+    // Counts the calls to create(), so anything built from the regions can tell when the atlas has been reloaded.
+    [[nodiscard]] u32 version() const;
 
 private:
+    [[nodiscard]] Texture_2D make_view(const Sub_Texture_Rect& rect) const;
+
     std::shared_ptr<Texture_2D> m_texture;
 
-    std::unordered_map<std::string, u32> m_coord_ids;
-    std::vector<Texture_2D> m_sub_textures;
+    // Sorted so a lookup is a binary search over the ids alone, m_rects is in the same order.
+    std::vector<Sub_Texture_Id> m_ids;
+    std::vector<Sub_Texture_Rect> m_rects;
+
+    u32 m_version{ 0 };
 };
 
 }
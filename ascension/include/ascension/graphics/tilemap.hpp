@@ -0,0 +1,117 @@
+/**
+ * File: tilemap.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:19:19
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:53:39
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include "graphics/texture_atlas.hpp"
+
+namespace ascension::graphics {
+
+class Index_Buffer_Object;
+class Sampler;
+class Shader;
+class Vertex_Array_Object;
+class Vertex_Buffer_Object;
+
+// A grid of tiles drawn from the sub-textures of one atlas. The map is split into square chunks, each chunk's quads
+// are built once into its own vertex buffer & only rebuilt when one of its tiles changes. Drawing the map is then a
+// draw call per chunk in view rather than a sprite per tile.
+class Tilemap {
+public:
+    // Tiles per side of a chunk.
+    static constexpr u32 CHUNK_SIZE = 32;
+    // Tiles are atlas sub-texture ids, so they keep pointing at the same image as sub-textures are added or renamed.
+    // Empty tiles & tiles missing from the atlas aren't drawn.
+    static constexpr Sub_Texture_Id EMPTY_TILE = 0;
+
+    Tilemap();
+    ~Tilemap();
+
+    // Every tile starts empty. The shader is drawn with as a sprite batch shader, positions in location 0 &
+    // texture coordinates in location 1, its projection is left to the caller.
+    void create(
+        u32 width,
+        u32 height,
+        const v2u& tile_size,
+        const std::shared_ptr<Texture_Atlas>& atlas,
+        const std::shared_ptr<Shader>& shader
+    );
+
+    void set_tile(u32 x, u32 y, Sub_Texture_Id tile);
+    [[nodiscard]] Sub_Texture_Id get_tile(u32 x, u32 y) const;
+
+    // World position of the bottom left corner of tile 0, 0.
+    void set_position(const v2f& position);
+    // Renderer_2D's default sampler for the atlas texture when null.
+    void set_sampler(const std::shared_ptr<Sampler>& sampler);
+    // Rebuild every chunk on its next draw, for when the atlas regions have changed.
+    void invalidate();
+
+    // Draw the chunks overlapping view, the x0, y0, x1, y1 world rect the camera sees. Every chunk is rebuilt first
+    // if the atlas has been reloaded.
+    void draw(const v4f& view);
+
+    [[nodiscard]] u32 width() const;
+    [[nodiscard]] u32 height() const;
+
+    Tilemap(const Tilemap&) = delete;
+    Tilemap(Tilemap&&) = delete;
+    Tilemap& operator=(const Tilemap&) = delete;
+    Tilemap& operator=(Tilemap&&) = delete;
+
+private:
+    struct Chunk {
+        // Created on the first build, chunks which have only ever been empty have no GL objects.
+        std::unique_ptr<Vertex_Array_Object> vao;
+        std::shared_ptr<Vertex_Buffer_Object> vbo;
+        u32 quad_count{ 0 };
+        bool is_dirty{ true };
+    };
+
+    void build_chunk(u32 chunk_x, u32 chunk_y);
+
+    u32 m_width;
+    u32 m_height;
+    v2u m_tile_size;
+    v2f m_position;
+
+    std::shared_ptr<Texture_Atlas> m_atlas;
+    // The atlas version the chunks were built from.
+    u32 m_atlas_version;
+    std::shared_ptr<Shader> m_shader;
+    std::shared_ptr<Sampler> m_sampler;
+
+    // Row major, row 0 is the bottom of the map.
+    std::vector<Sub_Texture_Id> m_tiles;
+
+    u32 m_chunks_x;
+    u32 m_chunks_y;
+    std::vector<Chunk> m_chunks;
+    // The quads of every chunk are indexed the same way, so the chunks share one index buffer.
+    std::shared_ptr<Index_Buffer_Object> m_ibo;
+    // Scratch space for building chunks, interleaved position & texture coordinates.
+    std::vector<f32> m_vertices;
+};
+
+}
@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-13 20:17:48
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-08-10 12:25:26
+ * Last Modified: 2026-10-18 15:56:17
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -24,27 +24,72 @@
 
 #include "ascension.hpp"
 
+#include <array>
+#include <filesystem>
+
+#include <fmt/format.h>
 #include <glm/ext/matrix_clip_space.hpp>
 
+#include "graphics/animation.hpp"
+#include "graphics/gpu_profiler.hpp"
+#include "graphics/renderer_2d.hpp"
 #include "graphics/shader.hpp"
 #include "graphics/sprite_font.hpp"
 #include "graphics/texture_atlas.hpp"
 
+#include "yuki/debug/flight_recorder.hpp"
 #include "yuki/debug/instrumentor.hpp"
 
 namespace ascension {
 
-const i32 WINDOW_WIDTH = 1600, WINDOW_HEIGHT = 900, OBJECT_COUNT = 1000;
+const i32 WINDOW_WIDTH = 1600, WINDOW_HEIGHT = 900, OBJECT_COUNT = 1000, ANIMATED_OBJECT_COUNT = 200;
+const u32 TILEMAP_SIZE = 512, TILEMAP_TILE_SIZE = 16, GPU_TILEMAP_SIZE = 1024, GPU_TILEMAP_TILE_SIZE = 32;
+const u32 PARTICLE_COUNT = 100000;
+const u16 RENDER_STATS_FONT_SIZE = 16;
+const f32 RENDER_STATS_LINE_HEIGHT = 18.0f;
+// Built by ascension_asset_packer from assets/assets.xml, used in place of the loose asset files when present.
+const char* const ASSET_ARCHIVE_FILE = "assets/assets.pak";
+// Compiled from the xml manifests by the build, the manifests are only parsed at startup when it's missing.
+const char* const ASSET_INDEX_FILE = "assets/assets.idx";
+// Unused textures are kept cached up to this, sized to fit the shared VRAM of integrated GPUs.
+const u64 TEXTURE_BUDGET_BYTES = 256ULL * 1024 * 1024;
+// The sub-textures of textures/fruits, picked from at random to fill the scene.
+const std::array<graphics::Sub_Texture_Id, 9> FRUITS{
+    graphics::make_sub_texture_id("watermelon"), graphics::make_sub_texture_id("pineapple"),
+    graphics::make_sub_texture_id("orange"),     graphics::make_sub_texture_id("grape"),
+    graphics::make_sub_texture_id("pear"),       graphics::make_sub_texture_id("banana"),
+    graphics::make_sub_texture_id("strawberry"), graphics::make_sub_texture_id("raspberry"),
+    graphics::make_sub_texture_id("cherry"),
+};
 
 void
 Ascension::on_initialize()
 {
-    m_asset_manager.load_asset_file("assets/assets.xml");
-    m_asset_manager.load_texture_2d("textures/unicorn");
-    auto fruit_atlas = m_asset_manager.load_texture_atlas("textures/fruits");
-    auto sprite_shader = m_asset_manager.load_shader("shaders/spritebatch");
-    auto font_shader = m_asset_manager.load_shader("shaders/spritefont");
-    auto sprite_font = m_asset_manager.load_font("fonts/arial");
+    if (!std::filesystem::exists(ASSET_ARCHIVE_FILE) || !m_asset_manager.load_asset_archive(ASSET_ARCHIVE_FILE)) {
+        m_asset_manager.load_asset_file(std::filesystem::exists(ASSET_INDEX_FILE) ? ASSET_INDEX_FILE : "assets/assets.xml");
+    }
+
+    using namespace assets::literals;
+
+    m_asset_manager.set_texture_budget(TEXTURE_BUDGET_BYTES);
+#ifdef YUKI_DEBUG
+    m_asset_manager.enable_hot_reload("assets");
+#endif
+    m_asset_manager.preload({
+        { assets::Asset_Type::Texture, "textures/unicorn"_asset },
+        { assets::Asset_Type::Texture_Atlas, "textures/fruits"_asset },
+        { assets::Asset_Type::Shader, "shaders/spritebatch"_asset },
+        { assets::Asset_Type::Font, "fonts/arial"_asset },
+        { assets::Asset_Type::Animation, "animations/fruit_cycle"_asset },
+    });
+    m_asset_manager.load_texture_2d("textures/unicorn"_asset);
+    const auto fruit_atlas_handle = m_asset_manager.load_texture_atlas("textures/fruits"_asset);
+    auto* const fruit_atlas = m_asset_manager.get(fruit_atlas_handle);
+    auto sprite_shader = m_asset_manager.share(m_asset_manager.load_shader("shaders/spritebatch"_asset));
+    auto font_shader = m_asset_manager.share(m_asset_manager.load_shader("shaders/spritefont"_asset));
+    auto particle_shader = m_asset_manager.share(m_asset_manager.load_shader("shaders/particle"_asset));
+    auto sprite_font = m_asset_manager.share(m_asset_manager.load_font("fonts/arial"_asset));
+    m_debug_font = sprite_font;
 
     // viewport setup
     {
@@ -52,8 +97,13 @@ Ascension::on_initialize()
         auto projection = glm::ortho(0.0f, 1600.0f, 0.0f, 900.0f, -1.0f, 1.0f);
         sprite_shader->bind();
         sprite_shader->set_mat4f("m_projection_view", projection * mat_identity);
+        m_projection_view = projection * mat_identity;
         font_shader->bind();
         font_shader->set_mat4f("m_projection_view", projection * mat_identity);
+        if (particle_shader != nullptr) {
+            particle_shader->bind();
+            particle_shader->set_mat4f("m_projection_view", projection * mat_identity);
+        }
     }
 
     m_sprite_batch.create(16, 2048, sprite_shader);
@@ -63,17 +113,90 @@ Ascension::on_initialize()
     fruits->create({ OBJECT_COUNT, fruit_atlas->get_texture(), sprite_shader, true });
 
     for (u32 i = 0; i < OBJECT_COUNT; ++i) {
-        u32 id = static_cast<u32>(rand() % 9);
-        const auto fruit_texture = fruit_atlas->get_sub_texture(id);
+        const auto* fruit_rect = fruit_atlas->find_sub_texture(FRUITS.at(static_cast<size_t>(rand()) % FRUITS.size()));
+        if (fruit_rect == nullptr) {
+            continue;
+        }
 
-        const v2f position = { static_cast<i16>((static_cast<u32>(rand()) % (WINDOW_WIDTH - fruit_texture.width()))),
-                               static_cast<i16>((static_cast<u32>(rand()) % (WINDOW_HEIGHT - fruit_texture.height()))) };
+        const v2f position = { static_cast<i16>((static_cast<u32>(rand()) % (WINDOW_WIDTH - fruit_rect->size.x))),
+                               static_cast<i16>((static_cast<u32>(rand()) % (WINDOW_HEIGHT - fruit_rect->size.y))) };
 
-        fruits->add(fruit_texture, position);
+        fruits->add(*fruit_rect, position);
     }
 
     m_sprite_batch.add_batch(fruits);
 
+    // A sparse background of fruit tiles, most of the map is off screen & never built.
+    m_tilemap.create(
+        TILEMAP_SIZE,
+        TILEMAP_SIZE,
+        { TILEMAP_TILE_SIZE, TILEMAP_TILE_SIZE },
+        m_asset_manager.share(fruit_atlas_handle),
+        sprite_shader
+    );
+    for (u32 y = 0; y < TILEMAP_SIZE; ++y) {
+        for (u32 x = 0; x < TILEMAP_SIZE; ++x) {
+            if (rand() % 16 == 0) {
+                m_tilemap.set_tile(x, y, FRUITS.at(static_cast<size_t>(rand()) % FRUITS.size()));
+            }
+        }
+    }
+
+    // A ground layer behind everything, filled in one upload. Drawing it costs the same however large the map is.
+    if (auto tilemap_shader = m_asset_manager.share(m_asset_manager.load_shader("shaders/tilemap"_asset))) {
+        m_gpu_tilemap.create(
+            GPU_TILEMAP_SIZE,
+            GPU_TILEMAP_SIZE,
+            { GPU_TILEMAP_TILE_SIZE, GPU_TILEMAP_TILE_SIZE },
+            m_asset_manager.share(fruit_atlas_handle),
+            tilemap_shader
+        );
+
+        std::vector<graphics::Sub_Texture_Id> tiles(
+            static_cast<size_t>(GPU_TILEMAP_SIZE) * GPU_TILEMAP_SIZE, graphics::Gpu_Tilemap::EMPTY_TILE
+        );
+        for (auto& tile : tiles) {
+            if (rand() % 4 == 0) {
+                tile = FRUITS.at(static_cast<size_t>(rand()) % FRUITS.size());
+            }
+        }
+        m_gpu_tilemap.set_tiles(0, 0, GPU_TILEMAP_SIZE, GPU_TILEMAP_SIZE, tiles.data());
+    }
+
+    // A fountain of fruit, enough emitted to keep the pool close to full.
+    const auto* particle_rect = fruit_atlas->find_sub_texture(graphics::make_sub_texture_id("cherry"));
+    if (particle_shader != nullptr && particle_rect != nullptr) {
+        auto particle_texture = std::make_shared<graphics::Texture_2D>();
+        particle_texture->create_view(
+            fruit_atlas->get_texture(), particle_rect->size.x, particle_rect->size.y, particle_rect->texture_coords
+        );
+
+        graphics::Particle_Emitter_Config config;
+        config.emission_rate = 50000.0f;
+        config.min_lifetime = 1.0f;
+        config.max_lifetime = 3.0f;
+        config.min_velocity = { -150.0f, 200.0f };
+        config.max_velocity = { 150.0f, 450.0f };
+        config.acceleration = { 0.0f, -300.0f };
+        config.start_size = 4.0f;
+        config.end_size = 12.0f;
+        config.start_color = { 1.0f, 1.0f, 1.0f, 1.0f };
+        config.end_color = { 1.0f, 0.5f, 0.2f, 0.0f };
+
+        m_thread_pool = std::make_unique<yuki::Thread_Pool>();
+        m_particle_emitter.create(PARTICLE_COUNT, config, particle_texture, particle_shader);
+        m_particle_emitter.set_position({ static_cast<f32>(WINDOW_WIDTH) * 0.5f, 100.0f });
+    }
+
+    if (auto fruit_cycle = m_asset_manager.share(m_asset_manager.load_animation("animations/fruit_cycle"_asset))) {
+        for (u32 i = 0; i < ANIMATED_OBJECT_COUNT; ++i) {
+            const v2f position = { static_cast<f32>(static_cast<u32>(rand()) % (WINDOW_WIDTH - 32)),
+                                   static_cast<f32>(static_cast<u32>(rand()) % (WINDOW_HEIGHT - 32)) };
+            const f32 speed = 0.5f + static_cast<f32>(rand() % 100) / 100.0f;
+            m_animation_system.play(fruit_cycle, position, true, speed);
+        }
+    }
+
     m_sprite_batch.draw_string(sprite_font, 48, { 0, 850 }, "Ascension");
     m_sprite_batch.draw_string(
         sprite_font, 32, { 0, 820 }, "A 2D roguelike game about ascending through the 9 planes of mortality."
@@ -83,20 +206,74 @@ Ascension::on_initialize()
 void
 Ascension::on_update(f64 delta_time)
 {
-    (void)delta_time;
-
     if (m_input_manager.is_key_down(input::Key::ESCAPE)) {
         quit();
     }
+
+    m_asset_manager.update();
+    m_animation_system.update(delta_time);
+    m_particle_emitter.update(delta_time, m_thread_pool.get());
+
+    // Toggle the render stats overlay once per F3 press.
+    const bool render_stats_key_down = m_input_manager.is_key_down(input::Key::F3);
+    if (render_stats_key_down && !m_render_stats_key_down) {
+        m_show_render_stats = !m_show_render_stats;
+    }
+    m_render_stats_key_down = render_stats_key_down;
+
+    // Dump the last few seconds of frame timings once per F12 press.
+    const bool flight_dump_key_down = m_input_manager.is_key_down(input::Key::F12);
+    if (flight_dump_key_down && !m_flight_dump_key_down) {
+        yuki::debug::Flight_Recorder::get().request_dump();
+    }
+    m_flight_dump_key_down = flight_dump_key_down;
 }
 
 void
 Ascension::on_render(f32 interpolation)
 {
     PROFILE_FUNCTION();
+    PROFILE_GPU_SCOPE("Ascension::on_render");
     (void)interpolation;
 
+    if (m_show_render_stats) {
+        draw_render_stats();
+    }
+
+    m_gpu_tilemap.draw(m_projection_view);
+    m_tilemap.draw({ 0.0f, 0.0f, static_cast<f32>(WINDOW_WIDTH), static_cast<f32>(WINDOW_HEIGHT) });
+    m_animation_system.draw(m_sprite_batch);
     m_sprite_batch.flush();
+    m_particle_emitter.draw(m_thread_pool.get());
     m_font_batch.flush();
 }
+
+void
+Ascension::draw_render_stats()
+{
+    const auto& stats = graphics::Renderer_2D::get_frame_stats();
+
+    const auto to_mib = [](u64 bytes) { return static_cast<f64>(bytes) / (1024.0 * 1024.0); };
+
+    const std::array<std::string, 8> lines = {
+        fmt::format("draw calls: {}  quads: {}", stats.draw_calls, stats.quads),
+        fmt::format("uploaded: {:.1f} KiB", static_cast<f64>(stats.bytes_uploaded) / 1024.0),
+        fmt::format("texture binds: {}", stats.texture_binds),
+        fmt::format("shader binds: {}", stats.shader_binds),
+        fmt::format("vertex array binds: {}", stats.vertex_array_binds),
+        fmt::format("batches created: {}  flushed: {}", stats.batches_created, stats.batches_flushed),
+        fmt::format("sprites dropped: {}", stats.sprites_dropped),
+        fmt::format(
+            "textures: {:.1f} MiB  glyphs: {:.1f} MiB",
+            to_mib(m_asset_manager.get_resident_bytes(assets::Asset_Type::Texture)),
+            to_mib(m_asset_manager.get_resident_bytes(assets::Asset_Type::Font))
+        ),
+    };
+
+    v2f position = { 0.0f, static_cast<f32>(WINDOW_HEIGHT) - 100.0f };
+    for (const auto& line : lines) {
+        m_sprite_batch.draw_string(m_debug_font, RENDER_STATS_FONT_SIZE, position, line, false);
+        position.y -= RENDER_STATS_LINE_HEIGHT;
+    }
+}
 }
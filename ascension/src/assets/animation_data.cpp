@@ -0,0 +1,88 @@
+/**
+ * File: animation_data.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:14:11
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:57:31
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/animation_data.hpp"
+
+#include <cstring>
+
+#include "assets/sub_texture_data.hpp"
+
+namespace {
+
+// Sub-texture id & duration, written field by field so the struct's padding never reaches the file.
+constexpr size_t ANIMATION_FRAME_SIZE = sizeof(u64) + sizeof(f32);
+
+}
+
+namespace ascension::assets {
+
+bool
+parse_animation_data(const u8* data, u64 size, std::vector<graphics::Animation_Frame>& frames)
+{
+    frames.clear();
+    if (is_binary_sub_texture_data(data, size, ANIMATION_DATA_MAGIC)) {
+        u32 count = 0;
+        if (!read_sub_texture_data_header(data, size, ANIMATION_DATA_VERSION, ANIMATION_FRAME_SIZE, count)) {
+            return false;
+        }
+
+        frames.resize(count);
+        const u8* frame_data = data + SUB_TEXTURE_DATA_HEADER_SIZE; // NOLINT
+        for (auto& frame : frames) {
+            std::memcpy(&frame.sub_texture_id, frame_data, sizeof(frame.sub_texture_id));
+            std::memcpy(&frame.duration, frame_data + sizeof(frame.sub_texture_id), sizeof(frame.duration)); // NOLINT
+            frame_data += ANIMATION_FRAME_SIZE; // NOLINT
+        }
+        return true;
+    }
+
+    return parse_sub_texture_text(data, size, [&frames](graphics::Sub_Texture_Id id, const char*& it, const char* end) {
+        graphics::Animation_Frame frame;
+        frame.sub_texture_id = id;
+        if (!read_sub_texture_text_value(it, end, frame.duration)) {
+            return false;
+        }
+
+        frames.push_back(frame);
+        return true;
+    });
+}
+
+std::vector<u8>
+write_animation_data(const std::vector<graphics::Animation_Frame>& frames)
+{
+    auto data = make_sub_texture_data(
+        ANIMATION_DATA_MAGIC, ANIMATION_DATA_VERSION, static_cast<u32>(frames.size()), ANIMATION_FRAME_SIZE
+    );
+
+    u8* frame_data = data.data() + SUB_TEXTURE_DATA_HEADER_SIZE; // NOLINT
+    for (const auto& frame : frames) {
+        std::memcpy(frame_data, &frame.sub_texture_id, sizeof(frame.sub_texture_id));
+        std::memcpy(frame_data + sizeof(frame.sub_texture_id), &frame.duration, sizeof(frame.duration)); // NOLINT
+        frame_data += ANIMATION_FRAME_SIZE; // NOLINT
+    }
+    return data;
+}
+
+}
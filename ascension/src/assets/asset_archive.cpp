@@ -0,0 +1,289 @@
+/**
+ * File: asset_archive.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:25:01
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:39:11
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/asset_archive.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "assets/block_compression.hpp"
+#include "core/log.hpp"
+
+namespace {
+
+// magic, version, entry count & index offset, padded so the asset data starts aligned.
+constexpr u64 HEADER_SIZE = 32;
+
+template<typename T>
+void
+write_value(std::vector<u8>& output, T value)
+{
+    const auto offset = output.size();
+    output.resize(offset + sizeof(T));
+    std::memcpy(output.data() + offset, &value, sizeof(T));
+}
+
+void
+write_string(std::vector<u8>& output, const std::string& value)
+{
+    write_value(output, static_cast<u32>(value.size()));
+    output.insert(output.end(), value.begin(), value.end());
+}
+
+// Enough levels for a full mip chain of any u32 sized texture.
+constexpr u32 MAX_MIP_LEVELS = 32;
+
+// Bytes of pixels or blocks in a packed texture's levels, what decoding & uploading it reads out of the archive.
+u64
+get_texture_data_size(const ascension::assets::Asset_Archive::Entry& entry)
+{
+    u64 size = 0;
+    for (u32 level = 0; level < entry.mip_levels; ++level) {
+        const u32 level_width = std::max(entry.width >> level, 1U);
+        const u32 level_height = std::max(entry.height >> level, 1U);
+        if (entry.compression == ascension::assets::Block_Compression::None) {
+            // Uploaded as RGB when there are 3 channels & as RGBA otherwise.
+            size += u64{ level_width } * level_height * (entry.channels == 3 ? 3 : 4);
+        }
+        else {
+            size += ascension::assets::get_block_compressed_size(entry.compression, level_width, level_height);
+        }
+    }
+    return size;
+}
+
+// Bounds checked reads out of the mapped archive, any read past the end marks the whole archive as malformed.
+class Archive_Reader {
+public:
+    Archive_Reader(const u8* data, u64 size, u64 offset)
+      : m_data(data)
+      , m_size(size)
+      , m_offset(offset)
+    {
+    }
+
+    template<typename T>
+    T read()
+    {
+        T value{};
+        if (sizeof(T) > get_remaining()) {
+            m_failed = true;
+            return value;
+        }
+
+        std::memcpy(&value, m_data + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return value;
+    }
+
+    std::string read_string()
+    {
+        const auto length = read<u32>();
+        if (m_failed || length > get_remaining()) {
+            m_failed = true;
+            return {};
+        }
+
+        std::string value(reinterpret_cast<const char*>(m_data + m_offset), length); // NOLINT
+        m_offset += length;
+        return value;
+    }
+
+    [[nodiscard]] bool failed() const { return m_failed; }
+
+private:
+    // Offsets come from the file, compared against what's left so a huge one can't wrap past the end.
+    [[nodiscard]] u64 get_remaining() const { return m_offset < m_size ? m_size - m_offset : 0; }
+
+    const u8* m_data;
+    u64 m_size;
+    u64 m_offset;
+    bool m_failed{ false };
+};
+
+}
+
+namespace ascension::assets {
+
+// Asset_Archive
+bool
+Asset_Archive::open(const std::string& filepath)
+{
+    close();
+
+    if (!m_file.open(filepath, yuki::platform::Mapped_File::Access::READ)) {
+        core::log::error("Failed to open asset archive {}", filepath);
+        return false;
+    }
+
+    if (m_file.size() < HEADER_SIZE || std::memcmp(m_file.data(), MAGIC.data(), MAGIC.size()) != 0) {
+        core::log::error("{} is not an asset archive", filepath);
+        close();
+        return false;
+    }
+
+    Archive_Reader header(m_file.data(), m_file.size(), MAGIC.size());
+    const auto version = header.read<u32>();
+    const auto entry_count = header.read<u32>();
+    const auto index_offset = header.read<u64>();
+    if (version != VERSION) {
+        core::log::error("Asset archive {} is version {}, expected {}. Re-run the asset packer", filepath, version, VERSION);
+        close();
+        return false;
+    }
+
+    Archive_Reader index(m_file.data(), m_file.size(), index_offset);
+    for (u32 i = 0; i < entry_count; ++i) {
+        Entry entry;
+        entry.name = index.read_string();
+        entry.dependency = index.read_string();
+        entry.type = static_cast<Asset_Type>(index.read<u32>());
+        entry.offset = index.read<u64>();
+        entry.size = index.read<u64>();
+        entry.width = index.read<u32>();
+        entry.height = index.read<u32>();
+        entry.channels = index.read<u32>();
+        entry.compression = static_cast<Block_Compression>(index.read<u32>());
+        entry.mip_levels = index.read<u32>();
+        entry.vertex_size = index.read<u32>();
+
+        const auto type_index = magic_enum::enum_index(entry.type);
+        if (index.failed() || !type_index.has_value() || !magic_enum::enum_contains(entry.compression) ||
+            entry.mip_levels == 0 || entry.mip_levels > MAX_MIP_LEVELS || entry.offset > m_file.size() ||
+            entry.size > m_file.size() - entry.offset) {
+            core::log::error("Asset archive {} has a malformed index", filepath);
+            close();
+            return false;
+        }
+
+        // Decoding trusts these sizes, a truncated entry would be read past its end.
+        const bool is_truncated_shader = entry.type == Asset_Type::Shader && entry.vertex_size > entry.size;
+        const bool is_truncated_texture = entry.type == Asset_Type::Texture && entry.size < get_texture_data_size(entry);
+        if (is_truncated_shader || is_truncated_texture) {
+            core::log::error("Asset archive {} entry {} is smaller than its contents", filepath, entry.name);
+            close();
+            return false;
+        }
+
+        m_entries.at(*type_index).insert({ make_asset_id(entry.name), entry });
+    }
+
+    return true;
+}
+
+void
+Asset_Archive::close()
+{
+    m_file.close();
+    for (auto& entries : m_entries) {
+        entries.clear();
+    }
+}
+
+const Asset_Archive::Entry*
+Asset_Archive::find(Asset_Type type, Asset_Id id) const
+{
+    const auto& entries = this->entries(type);
+    const auto entry = entries.find(id);
+    if (entry == entries.end()) {
+        return nullptr;
+    }
+
+    return &entry->second;
+}
+
+const u8*
+Asset_Archive::data(const Entry& entry) const
+{
+    return m_file.data() + entry.offset;
+}
+
+const Asset_Archive::Entry_Map&
+Asset_Archive::entries(Asset_Type type) const
+{
+    return m_entries.at(magic_enum::enum_index(type).value_or(0));
+}
+
+bool
+Asset_Archive::is_open() const
+{
+    return m_file.is_open();
+}
+
+// Asset_Archive_Writer
+void
+Asset_Archive_Writer::add(Asset_Archive::Entry entry, const u8* data, u64 size)
+{
+    const auto padding = (Asset_Archive::DATA_ALIGNMENT - (m_data.size() % Asset_Archive::DATA_ALIGNMENT)) %
+                         Asset_Archive::DATA_ALIGNMENT;
+    m_data.resize(m_data.size() + padding);
+
+    entry.offset = HEADER_SIZE + m_data.size();
+    entry.size = size;
+    m_data.insert(m_data.end(), data, data + size);
+
+    m_entries.push_back(std::move(entry));
+}
+
+bool
+Asset_Archive_Writer::write(const std::string& filepath) const
+{
+    std::ofstream file(filepath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!file.is_open()) {
+        core::log::error("Failed to open asset archive {} for writing", filepath);
+        return false;
+    }
+
+    std::vector<u8> header(Asset_Archive::MAGIC.begin(), Asset_Archive::MAGIC.end());
+    write_value(header, Asset_Archive::VERSION);
+    write_value(header, static_cast<u32>(m_entries.size()));
+    write_value<u64>(header, HEADER_SIZE + m_data.size());
+    header.resize(HEADER_SIZE);
+
+    std::vector<u8> index;
+    for (const auto& entry : m_entries) {
+        write_string(index, entry.name);
+        write_string(index, entry.dependency);
+        write_value(index, static_cast<u32>(entry.type));
+        write_value(index, entry.offset);
+        write_value(index, entry.size);
+        write_value(index, entry.width);
+        write_value(index, entry.height);
+        write_value(index, entry.channels);
+        write_value(index, static_cast<u32>(entry.compression));
+        write_value(index, entry.mip_levels);
+        write_value(index, entry.vertex_size);
+    }
+
+    // NOLINTBEGIN - the archive is raw bytes
+    file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    file.write(reinterpret_cast<const char*>(m_data.data()), static_cast<std::streamsize>(m_data.size()));
+    file.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size()));
+    // NOLINTEND
+
+    return file.good();
+}
+
+}
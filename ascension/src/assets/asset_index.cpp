@@ -0,0 +1,514 @@
+/**
+ * File: asset_index.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:31:08
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:46:32
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/asset_index.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "assets/asset_manifest.hpp"
+#include "core/log.hpp"
+
+namespace {
+
+// magic, version, record count, bucket count & string table size.
+constexpr size_t HEADER_SIZE = 4 + 4 * sizeof(u32);
+// Roughly two keys per bucket keeps the displacement search short while the table stays small.
+constexpr size_t KEYS_PER_BUCKET = 2;
+constexpr u32 MAX_DISPLACEMENT = 1U << 20U;
+constexpr u32 UNUSED_SLOT = ~0U;
+constexpr u64 GOLDEN_RATIO_64 = 0x9e3779b97f4a7c15ULL;
+
+u64
+get_bucket(u64 key, size_t bucket_count)
+{
+    return yuki::hash_mix_64(key) % bucket_count;
+}
+
+u64
+get_slot(u64 key, u32 displacement, size_t slot_count)
+{
+    return yuki::hash_mix_64(key ^ ((static_cast<u64>(displacement) + 1) * GOLDEN_RATIO_64)) % slot_count;
+}
+
+template<typename T>
+void
+write_values(std::ofstream& file, const T* values, size_t count)
+{
+    file.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(sizeof(T) * count)); // NOLINT
+}
+
+template<typename T>
+bool
+read_values(const std::vector<u8>& data, size_t& offset, T* values, size_t count)
+{
+    const size_t size = sizeof(T) * count;
+    if (offset + size > data.size()) {
+        return false;
+    }
+
+    std::memcpy(values, data.data() + offset, size);
+    offset += size;
+    return true;
+}
+
+}
+
+namespace ascension::assets {
+
+void
+Asset_Index::clear()
+{
+    m_records.clear();
+    m_displacements.clear();
+    m_slots.clear();
+    m_strings.clear();
+}
+
+bool
+Asset_Index::build(const Asset_Manifest& manifest)
+{
+    clear();
+    // Offset 0 is the empty string, for the fields an asset type doesn't use.
+    m_strings.push_back('\0');
+
+    std::vector<std::string> generated_atlases;
+    for (const auto& [name, asset] : manifest.textures()) {
+        Record record{};
+        record.key = make_key(Asset_Type::Texture, make_asset_id(name));
+        record.flags = (asset.flip_on_load ? FLAG_FLIP_ON_LOAD : 0) | (asset.mipmaps ? FLAG_MIPMAPS : 0);
+        record.scale = asset.scale;
+        record.scale_filter = static_cast<u32>(asset.scale_filter);
+        record.atlas = add_string(asset.atlas);
+        add_record(asset, record);
+
+        if (!asset.atlas.empty()) {
+            generated_atlases.push_back(asset.atlas);
+        }
+    }
+
+    // Generated atlases & their page textures have no file or manifest entry of their own, they share the name of
+    // the atlas just as an authored atlas & its texture do.
+    std::sort(generated_atlases.begin(), generated_atlases.end());
+    generated_atlases.erase(std::unique(generated_atlases.begin(), generated_atlases.end()), generated_atlases.end());
+    for (const auto& atlas : generated_atlases) {
+        Record page{};
+        page.key = make_key(Asset_Type::Texture, make_asset_id(atlas));
+        page.flags = FLAG_GENERATED_ATLAS;
+        page.scale = 1.0f;
+        add_record({ atlas, "", Asset_Type::Texture }, page);
+
+        Record atlas_record{};
+        atlas_record.key = make_key(Asset_Type::Texture_Atlas, make_asset_id(atlas));
+        atlas_record.flags = FLAG_GENERATED_ATLAS;
+        atlas_record.sub_texture_id = add_string(atlas);
+        add_record({ atlas, "", Asset_Type::Texture_Atlas }, atlas_record);
+    }
+
+    for (const auto& [name, asset] : manifest.texture_atlases()) {
+        Record record{};
+        record.key = make_key(Asset_Type::Texture_Atlas, make_asset_id(name));
+        record.sub_texture_id = add_string(asset.sub_texture_id);
+        add_record(asset, record);
+    }
+
+    for (const auto& [name, asset] : manifest.shaders()) {
+        Record record{};
+        record.key = make_key(Asset_Type::Shader, make_asset_id(name));
+        record.vertex_src_file = add_string(asset.vertex_src_file);
+        record.fragment_src_file = add_string(asset.fragment_src_file);
+        add_record(asset, record);
+    }
+
+    for (const auto& [name, asset] : manifest.fonts()) {
+        Record record{};
+        record.key = make_key(Asset_Type::Font, make_asset_id(name));
+        add_record(asset, record);
+    }
+
+    for (const auto& [name, asset] : manifest.animations()) {
+        Record record{};
+        record.key = make_key(Asset_Type::Animation, make_asset_id(name));
+        record.sub_texture_id = add_string(asset.texture_atlas);
+        add_record(asset, record);
+    }
+
+    std::sort(m_records.begin(), m_records.end(), [](const Record& a, const Record& b) {
+        return a.type != b.type ? a.type < b.type : a.key < b.key;
+    });
+
+    const auto duplicate = std::adjacent_find(m_records.begin(), m_records.end(), [](const Record& a, const Record& b) {
+        return a.key == b.key;
+    });
+    if (duplicate != m_records.end()) {
+        core::log::error(
+            "Asset {} ({}) has the same id as another asset, rename one of them",
+            get_string(duplicate->name),
+            get_string(duplicate->filepath)
+        );
+        clear();
+        return false;
+    }
+
+    return build_hash();
+}
+
+bool
+Asset_Index::load(const std::string& filepath)
+{
+    clear();
+
+    std::ifstream file(filepath, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+    if (!file.is_open()) {
+        core::log::error("Failed to open asset index {}", filepath);
+        return false;
+    }
+
+    // The whole index is read at once, then split into its tables.
+    std::vector<u8> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())); // NOLINT
+
+    if (data.size() < HEADER_SIZE || std::memcmp(data.data(), MAGIC.data(), MAGIC.size()) != 0) {
+        core::log::error("{} is not an asset index", filepath);
+        return false;
+    }
+
+    size_t offset = MAGIC.size();
+    std::array<u32, 4> header{};
+    read_values(data, offset, header.data(), header.size());
+    const auto [version, record_count, bucket_count, string_size] = header;
+    if (version != VERSION) {
+        core::log::error("Asset index {} is version {}, expected {}. Re-run the asset packer", filepath, version, VERSION);
+        return false;
+    }
+
+    // Checked before sizing the tables, so a corrupt count fails here rather than allocating gigabytes.
+    const u64 table_size = (u64{ bucket_count } + record_count) * sizeof(u32) + u64{ record_count } * sizeof(Record) +
+                           string_size;
+    if (table_size > data.size() - offset) {
+        core::log::error("Asset index {} is truncated", filepath);
+        return false;
+    }
+
+    m_displacements.resize(bucket_count);
+    m_slots.resize(record_count);
+    m_records.resize(record_count);
+    m_strings.resize(string_size);
+    if (!read_values(data, offset, m_displacements.data(), m_displacements.size()) ||
+        !read_values(data, offset, m_slots.data(), m_slots.size()) ||
+        !read_values(data, offset, m_records.data(), m_records.size()) ||
+        !read_values(data, offset, m_strings.data(), m_strings.size()) || m_strings.empty() || m_strings.back() != '\0') {
+        core::log::error("Asset index {} is truncated", filepath);
+        clear();
+        return false;
+    }
+
+    // find() trusts the hash tables, every lookup needs a bucket & every slot has to name a record.
+    const bool has_buckets = record_count == 0 || bucket_count > 0;
+    const bool has_valid_slots =
+        std::all_of(m_slots.begin(), m_slots.end(), [record_count = record_count](u32 slot) { return slot < record_count; });
+    if (!has_buckets || !has_valid_slots) {
+        core::log::error("Asset index {} has a malformed hash table", filepath);
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool
+Asset_Index::write(const std::string& filepath) const
+{
+    std::ofstream file(filepath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!file.is_open()) {
+        core::log::error("Failed to open asset index {} for writing", filepath);
+        return false;
+    }
+
+    const std::array<u32, 4> header = { VERSION,
+                                        static_cast<u32>(m_records.size()),
+                                        static_cast<u32>(m_displacements.size()),
+                                        static_cast<u32>(m_strings.size()) };
+
+    write_values(file, MAGIC.data(), MAGIC.size());
+    write_values(file, header.data(), header.size());
+    write_values(file, m_displacements.data(), m_displacements.size());
+    write_values(file, m_slots.data(), m_slots.size());
+    write_values(file, m_records.data(), m_records.size());
+    write_values(file, m_strings.data(), m_strings.size());
+
+    return file.good();
+}
+
+std::optional<Animation_Asset>
+Asset_Index::find_animation(Asset_Id id) const
+{
+    const auto* record = find(Asset_Type::Animation, id);
+    if (record == nullptr) {
+        return std::nullopt;
+    }
+
+    Animation_Asset asset;
+    static_cast<Asset&>(asset) = get_asset(*record);
+    asset.texture_atlas = get_string(record->sub_texture_id);
+    return asset;
+}
+
+std::optional<Font_Asset>
+Asset_Index::find_font(Asset_Id id) const
+{
+    const auto* record = find(Asset_Type::Font, id);
+    if (record == nullptr) {
+        return std::nullopt;
+    }
+
+    Font_Asset asset;
+    static_cast<Asset&>(asset) = get_asset(*record);
+    return asset;
+}
+
+std::optional<Shader_Asset>
+Asset_Index::find_shader(Asset_Id id) const
+{
+    const auto* record = find(Asset_Type::Shader, id);
+    if (record == nullptr) {
+        return std::nullopt;
+    }
+
+    Shader_Asset asset;
+    static_cast<Asset&>(asset) = get_asset(*record);
+    asset.vertex_src_file = get_string(record->vertex_src_file);
+    asset.fragment_src_file = get_string(record->fragment_src_file);
+    return asset;
+}
+
+std::optional<Texture_Asset>
+Asset_Index::find_texture(Asset_Id id) const
+{
+    const auto* record = find(Asset_Type::Texture, id);
+    if (record == nullptr) {
+        return std::nullopt;
+    }
+
+    Texture_Asset asset;
+    static_cast<Asset&>(asset) = get_asset(*record);
+    asset.scale = record->scale;
+    asset.scale_filter = static_cast<Resize_Filter>(record->scale_filter);
+    asset.flip_on_load = (record->flags & FLAG_FLIP_ON_LOAD) != 0;
+    asset.mipmaps = (record->flags & FLAG_MIPMAPS) != 0;
+    asset.atlas = get_string(record->atlas);
+    asset.is_atlas_page = (record->flags & FLAG_GENERATED_ATLAS) != 0;
+    return asset;
+}
+
+std::optional<Texture_Atlas_Asset>
+Asset_Index::find_texture_atlas(Asset_Id id) const
+{
+    const auto* record = find(Asset_Type::Texture_Atlas, id);
+    if (record == nullptr) {
+        return std::nullopt;
+    }
+
+    Texture_Atlas_Asset asset;
+    static_cast<Asset&>(asset) = get_asset(*record);
+    asset.sub_texture_id = get_string(record->sub_texture_id);
+    asset.is_generated = (record->flags & FLAG_GENERATED_ATLAS) != 0;
+    return asset;
+}
+
+std::vector<Asset_Reference>
+Asset_Index::find_by_file(const std::string& filepath) const
+{
+    const auto is_same_file = [target = std::filesystem::path(filepath).lexically_normal()](const std::string& path) {
+        return std::filesystem::path(path).lexically_normal() == target;
+    };
+
+    std::vector<Asset_Reference> assets;
+    for (const auto& record : m_records) {
+        const std::string record_filepath = get_string(record.filepath);
+        const bool matches = static_cast<Asset_Type>(record.type) == Asset_Type::Shader
+                               ? is_same_file(record_filepath + get_string(record.vertex_src_file)) ||
+                                   is_same_file(record_filepath + get_string(record.fragment_src_file))
+                               : is_same_file(record_filepath);
+        if (matches) {
+            assets.push_back({ static_cast<Asset_Type>(record.type), get_id(record) });
+        }
+    }
+    return assets;
+}
+
+std::vector<Asset_Id>
+Asset_Index::find_atlas_members(const std::string& atlas) const
+{
+    std::vector<Asset_Id> members;
+    for (const auto& record : m_records) {
+        if (static_cast<Asset_Type>(record.type) == Asset_Type::Texture && atlas == get_string(record.atlas)) {
+            members.push_back(get_id(record));
+        }
+    }
+
+    std::sort(members.begin(), members.end());
+    return members;
+}
+
+size_t
+Asset_Index::count(Asset_Type type) const
+{
+    const auto type_value = static_cast<u32>(type);
+    return static_cast<size_t>(std::count_if(m_records.begin(), m_records.end(), [type_value](const Record& record) {
+        return record.type == type_value;
+    }));
+}
+
+size_t
+Asset_Index::size() const
+{
+    return m_records.size();
+}
+
+u64
+Asset_Index::make_key(Asset_Type type, Asset_Id id)
+{
+    return id ^ yuki::hash_mix_64(static_cast<u64>(type) + 1);
+}
+
+Asset_Id
+Asset_Index::get_id(const Record& record)
+{
+    // make_key is an xor, so applying it again recovers the id.
+    return make_key(static_cast<Asset_Type>(record.type), record.key);
+}
+
+const Asset_Index::Record*
+Asset_Index::find(Asset_Type type, Asset_Id id) const
+{
+    if (m_records.empty()) {
+        return nullptr;
+    }
+
+    const u64 key = make_key(type, id);
+    const u32 displacement = m_displacements[get_bucket(key, m_displacements.size())];
+    const u32 record_index = m_slots[get_slot(key, displacement, m_slots.size())];
+
+    // Ids which aren't in the index still land on a slot, the key check rejects them.
+    const auto& record = m_records[record_index];
+    return record.key == key ? &record : nullptr;
+}
+
+const char*
+Asset_Index::get_string(u32 offset) const
+{
+    return offset < m_strings.size() ? &m_strings[offset] : "";
+}
+
+Asset
+Asset_Index::get_asset(const Record& record) const
+{
+    return { get_string(record.name), get_string(record.filepath), static_cast<Asset_Type>(record.type) };
+}
+
+u32
+Asset_Index::add_string(const std::string& value)
+{
+    const auto offset = static_cast<u32>(m_strings.size());
+    m_strings.insert(m_strings.end(), value.begin(), value.end());
+    m_strings.push_back('\0');
+    return offset;
+}
+
+void
+Asset_Index::add_record(const Asset& asset, Record record)
+{
+    record.type = static_cast<u32>(asset.type);
+    record.name = add_string(asset.name);
+    record.filepath = add_string(asset.filepath);
+    m_records.push_back(record);
+}
+
+bool
+Asset_Index::build_hash()
+{
+    const size_t record_count = m_records.size();
+    const size_t bucket_count = record_count / KEYS_PER_BUCKET + 1;
+
+    std::vector<std::vector<u32>> buckets(bucket_count);
+    for (u32 i = 0; i < record_count; ++i) {
+        buckets[get_bucket(m_records[i].key, bucket_count)].push_back(i);
+    }
+
+    // Place the largest buckets first, while most slots are still free.
+    std::vector<u32> bucket_order(bucket_count);
+    for (u32 i = 0; i < bucket_count; ++i) {
+        bucket_order[i] = i;
+    }
+    std::stable_sort(bucket_order.begin(), bucket_order.end(), [&buckets](u32 a, u32 b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    m_displacements.assign(bucket_count, 0);
+    m_slots.assign(record_count, UNUSED_SLOT);
+
+    std::vector<u64> bucket_slots;
+    for (const u32 bucket_index : bucket_order) {
+        const auto& bucket = buckets[bucket_index];
+        if (bucket.empty()) {
+            break;
+        }
+
+        // Find a displacement which moves every key of the bucket into a distinct free slot.
+        bool placed = false;
+        for (u32 displacement = 0; displacement < MAX_DISPLACEMENT && !placed; ++displacement) {
+            bucket_slots.clear();
+            for (const u32 record_index : bucket) {
+                const u64 slot = get_slot(m_records[record_index].key, displacement, record_count);
+                if (m_slots[slot] != UNUSED_SLOT ||
+                    std::find(bucket_slots.begin(), bucket_slots.end(), slot) != bucket_slots.end()) {
+                    break;
+                }
+                bucket_slots.push_back(slot);
+            }
+
+            if (bucket_slots.size() == bucket.size()) {
+                for (size_t i = 0; i < bucket.size(); ++i) {
+                    m_slots[bucket_slots[i]] = bucket[i];
+                }
+                m_displacements[bucket_index] = displacement;
+                placed = true;
+            }
+        }
+
+        if (!placed) {
+            core::log::error("Failed to build the asset index perfect hash for {} assets", record_count);
+            clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
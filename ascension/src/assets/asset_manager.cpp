@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-13 15:04:17
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-07-22 16:27:47
+ * Last Modified: 2026-10-18 16:25:12
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -24,14 +24,31 @@
 
 #include "assets/asset_manager.hpp"
 
-#define STBI_NO_THREAD_LOCALS
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 
 #include <magic_enum/magic_enum.hpp>
-#include <pugixml.hpp>
 
+#include <algorithm>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <sstream>
+
+#include "yuki/debug/instrumentor.hpp"
+#include "yuki/platform/file_watcher.hpp"
+#include "yuki/platform/mapped_file.hpp"
+#include "yuki/thread_pool.hpp"
+
+#include "assets/animation_data.hpp"
+#include "assets/asset_manifest.hpp"
+#include "assets/atlas_builder.hpp"
+#include "assets/atlas_data.hpp"
+#include "assets/block_compression.hpp"
+#include "assets/image_resize.hpp"
 #include "core/log.hpp"
+#include "graphics/animation.hpp"
 #include "graphics/shader.hpp"
 #include "graphics/sprite_font.hpp"
 #include "graphics/texture_2d.hpp"
@@ -39,27 +56,146 @@
 
 namespace {
 
-ascension::assets::Texture_Asset
-parse_texture_asset(const pugi::xml_node& node, const std::string& name, const std::string& filepath)
+using namespace ascension::assets::literals;
+
+constexpr const char* ASSET_INDEX_EXTENSION = ".idx";
+// TODO: Specify the shader in the font xml file
+constexpr ascension::assets::Asset_Id FONT_SHADER_ID = "shaders/spritefont"_asset;
+
+// stbi_set_flip_vertically_on_load is global state, flipping after decoding keeps decodes on worker threads
+// independent of each other.
+void
+flip_rows(u8* pixels, u32 width, u32 height, u32 channels)
+{
+    const size_t row_size = size_t{ width } * channels;
+    for (size_t top = 0; top < height / 2; ++top) {
+        const size_t bottom = height - 1 - top;
+        std::swap_ranges(pixels + top * row_size, pixels + (top + 1) * row_size, pixels + bottom * row_size); // NOLINT
+    }
+}
+
+struct Texture_Pixels {
+    const u8* data{ nullptr };
+    std::shared_ptr<const void> data_owner;
+    u32 width{ 0 };
+    u32 height{ 0 };
+    u32 channels{ 0 };
+};
+
+// Decode a loose texture file, flipped & scaled as the manifest asks.
+std::optional<Texture_Pixels>
+load_texture_pixels(const ascension::assets::Texture_Asset& texture)
+{
+    i32 width = 0;
+    i32 height = 0;
+    i32 file_channels = 0;
+    // Textures are RGB or RGBA, grey & grey-alpha images are expanded to RGBA while decoding.
+    stbi_info(texture.filepath.c_str(), &width, &height, &file_channels);
+    const i32 channels = file_channels == 3 ? 3 : 4;
+    auto* const pixels = stbi_load(texture.filepath.c_str(), &width, &height, &file_channels, channels);
+    if (pixels == nullptr) {
+        return std::nullopt;
+    }
+
+    Texture_Pixels result;
+    result.data = pixels;
+    result.data_owner = std::shared_ptr<u8>(pixels, stbi_image_free);
+    result.width = static_cast<u32>(width);
+    result.height = static_cast<u32>(height);
+    result.channels = static_cast<u32>(channels);
+    if (texture.flip_on_load) {
+        flip_rows(pixels, result.width, result.height, result.channels);
+    }
+
+    if (texture.scale > 0.0f && texture.scale != 1.0f) {
+        const u32 scaled_width = ascension::assets::get_scaled_length(result.width, texture.scale);
+        const u32 scaled_height = ascension::assets::get_scaled_length(result.height, texture.scale);
+        auto scaled_pixels = std::make_shared<std::vector<u8>>(ascension::assets::resize_image(
+            pixels, result.width, result.height, result.channels, scaled_width, scaled_height, texture.scale_filter
+        ));
+
+        result.data = scaled_pixels->data();
+        result.data_owner = std::move(scaled_pixels);
+        result.width = scaled_width;
+        result.height = scaled_height;
+    }
+
+    return result;
+}
+
+// Pack the textures of a generated atlas, only their sizes are needed so only the file headers are read.
+ascension::assets::Atlas_Layout
+get_atlas_layout(const std::vector<ascension::assets::Texture_Asset>& members)
 {
-    ascension::assets::Texture_Asset asset;
-    if (!node.child("scale").empty()) {
-        asset.scale = std::strtof(node.child("scale").child_value(), nullptr);
+    std::vector<v2u> sizes;
+    sizes.reserve(members.size());
+    for (const auto& member : members) {
+        i32 width = 0;
+        i32 height = 0;
+        i32 channels = 0;
+        if (stbi_info(member.filepath.c_str(), &width, &height, &channels) == 0) {
+            ascension::core::log::error("Failed to read texture {} for atlas {}", member.filepath, member.atlas);
+        }
+
+        const f32 scale = member.scale > 0.0f ? member.scale : 1.0f;
+        sizes.push_back({ ascension::assets::get_scaled_length(static_cast<u32>(width), scale),
+                          ascension::assets::get_scaled_length(static_cast<u32>(height), scale) });
     }
-    if (!node.child("flip").empty()) {
-        asset.flip_on_load = (std::stoi(node.child("flip").child_value()) != 0);
+
+    return ascension::assets::pack_atlas(sizes);
+}
+
+ascension::graphics::Texture_2D::Format
+get_texture_format(ascension::assets::Block_Compression compression, u32 channels)
+{
+    using Format = ascension::graphics::Texture_2D::Format;
+    switch (compression) {
+    case ascension::assets::Block_Compression::BC1:
+        return Format::BC1;
+    case ascension::assets::Block_Compression::BC3:
+        return Format::BC3;
+    case ascension::assets::Block_Compression::None:
+        break;
     }
-    asset.name = name;
-    asset.filepath = filepath;
-    asset.type = ascension::assets::Asset_Type::Texture;
+    return channels == 3 ? Format::RGB : Format::RGBA;
+}
 
-    return asset;
+std::string
+read_text_file(const std::string& filepath)
+{
+    std::ifstream file_stream(filepath);
+    std::stringstream string_stream;
+    string_stream << file_stream.rdbuf();
+    return string_stream.str();
 }
 
 }
 
 namespace ascension::assets {
 
+struct Asset_Manager::Decoded_Asset {
+    Asset_Reference asset;
+
+    // Texture pixels & font files, pointing into the archive or into memory held by data_owner.
+    const u8* data{ nullptr };
+    u64 data_size{ 0 };
+    std::shared_ptr<const void> data_owner;
+    std::string name;
+    u32 width{ 0 };
+    u32 height{ 0 };
+    graphics::Texture_2D::Format format{ graphics::Texture_2D::Format::RGBA };
+    u32 mip_levels{ 1 };
+    // The generated atlas a texture is packed into, name is its sub-texture.
+    Asset_Id atlas{ 0 };
+
+    std::string vertex_source;
+    std::string fragment_source;
+
+    std::vector<graphics::Sub_Texture_Region> sub_textures;
+
+    std::vector<graphics::Animation_Frame> frames;
+};
+
 Asset_Manager::~Asset_Manager()
 {
     clear();
@@ -68,368 +204,1001 @@ Asset_Manager::~Asset_Manager()
 void
 Asset_Manager::clear()
 {
-    m_texture_filepaths.clear();
-    m_texture_atlas_filepaths.clear();
-    m_shader_filepaths.clear();
+    m_index.clear();
+
+    m_atlas_members.clear();
+    m_animations.clear();
+    m_textures.clear();
+    m_texture_atlases.clear();
+    m_shaders.clear();
+    m_fonts.clear();
 
-    m_loaded_textures.clear();
-    m_loaded_texture_atlas.clear();
-    m_loaded_shaders.clear();
+    // Loaded fonts may still be reading from the archive, so it has to go last.
+    m_archive.reset();
 }
 
 void
-// NOLINTNEXTLINE - this needs to be recursive.
-Asset_Manager::parse_asset_document(const std::string& document_filepath, const std::string& root_name)
+Asset_Manager::load_asset_file(const std::string& asset_file)
 {
-    pugi::xml_document document;
-    pugi::xml_parse_result result = document.load_file(document_filepath.c_str());
+    PROFILE_FUNCTION();
 
-    if (!result) {
-        core::log::error("Failed to load asset file {}. Error {}", document_filepath, result.description());
-        return;
+    m_asset_file = asset_file;
+    if (std::filesystem::path(asset_file).extension() == ASSET_INDEX_EXTENSION) {
+        m_index.load(asset_file);
+    }
+    else {
+        // Development path, the packer compiles the same index offline so release builds skip the xml entirely.
+        Asset_Manifest manifest;
+        manifest.load(asset_file);
+        m_index.build(manifest);
     }
 
-    for (const auto& node : document.child("assets").children("asset")) {
-        const std::string name = node.attribute("name").value();
-        const std::string type_str = node.attribute("type").value();
-        const std::string filepath = node.attribute("filepath").value();
+    core::log::info("Loaded {} textures", m_index.count(Asset_Type::Texture));
+    core::log::info("Loaded {} texture atlas", m_index.count(Asset_Type::Texture_Atlas));
+    core::log::info("Loaded {} shaders", m_index.count(Asset_Type::Shader));
+    core::log::info("Loaded {} fonts", m_index.count(Asset_Type::Font));
+    core::log::info("Loaded {} animations", m_index.count(Asset_Type::Animation));
+}
 
-        const auto type = magic_enum::enum_cast<Asset_Type>(type_str);
-        if (!type.has_value()) {
-            core::log::error("Unknown asset type {}", type_str);
-            return;
-        }
+bool
+Asset_Manager::load_asset_archive(const std::string& archive_file)
+{
+    PROFILE_FUNCTION();
 
-        std::string asset_base_path;
-        if (!root_name.empty()) {
-            asset_base_path = root_name + "/";
-        }
-        else if (type != assets::Asset_Type::Asset_List) {
-            asset_base_path = type_str + "/";
-        }
+    auto archive = std::make_shared<Asset_Archive>();
+    if (!archive->open(archive_file)) {
+        return false;
+    }
+    m_archive = archive;
+
+    core::log::info("Loaded {} packed textures", m_archive->entries(Asset_Type::Texture).size());
+    core::log::info("Loaded {} packed texture atlas", m_archive->entries(Asset_Type::Texture_Atlas).size());
+    core::log::info("Loaded {} packed shaders", m_archive->entries(Asset_Type::Shader).size());
+    core::log::info("Loaded {} packed fonts", m_archive->entries(Asset_Type::Font).size());
+    core::log::info("Loaded {} packed animations", m_archive->entries(Asset_Type::Animation).size());
+    return true;
+}
 
-        if (type == Asset_Type::Asset_List) {
-            parse_asset_document(filepath, asset_base_path + name);
-        }
-        else {
-            switch (*type) {
-                case Asset_Type::Texture: {
-                    Texture_Asset asset = parse_texture_asset(node, name, filepath);
-                    // TODO: Should probably check we're not overwriting these...
-                    m_texture_filepaths[(asset_base_path + name)] = asset;
-                } break;
-                case Asset_Type::Texture_Atlas: {
-                    Texture_Atlas_Asset asset;
-
-                    if (node.child("asset").empty()) {
-                        core::log::error("Trying to load texture atlas {} ({}) without respective texture", name, filepath);
-                        continue;
-                    }
-
-                    const auto texture_node = node.child("asset");
-
-                    const std::string child_type_value = texture_node.attribute("type").value();
-                    const auto child_type = magic_enum::enum_cast<Asset_Type>(child_type_value);
-                    if (!child_type.has_value()) {
-                        core::log::error(
-                            "Unknown asset type {} loading texture atlas {} ({})", child_type_value, name, filepath
-                        );
-                        continue;
-                    }
-
-                    if (*child_type != Asset_Type::Texture) {
-                        core::log::error(
-                            "Unexpected child asset type {} loading texture atlas {} ({})", child_type_value, name, filepath
-                        );
-                        continue;
-                    }
-
-                    const std::string texture_name = texture_node.attribute("name").value();
-                    const std::string texture_filepath = texture_node.attribute("filepath").value();
-                    Texture_Asset texture_asset = parse_texture_asset(texture_node, texture_name, texture_filepath);
-
-                    std::string sub_texture_id = asset_base_path + texture_name;
-                    m_texture_filepaths[sub_texture_id] = texture_asset;
-
-                    asset.name = name;
-                    asset.filepath = filepath;
-                    asset.type = Asset_Type::Texture_Atlas;
-                    asset.sub_texture_id = sub_texture_id;
-                    m_texture_atlas_filepaths[(asset_base_path + name)] = asset;
-                } break;
-                case Asset_Type::Shader: {
-                    Shader_Asset asset;
-                    if (node.child("vertex").empty() || node.child("fragment").empty()) {
-                        core::log::error("Trying to load shader {} ({}) without fragment or vertex source.", name, filepath);
-                        continue;
-                    }
-                    asset.vertex_src_file = node.child("vertex").child_value();
-                    asset.fragment_src_file = node.child("fragment").child_value();
-                    asset.name = name;
-                    asset.filepath = filepath;
-                    asset.type = Asset_Type::Shader;
-                    m_shader_filepaths[(asset_base_path + name)] = asset;
-                } break;
-                case Asset_Type::Font: {
-                    Font_Asset asset;
-                    asset.name = name;
-                    asset.filepath = filepath;
-                    asset.type = Asset_Type::Font;
-                    m_font_filepaths[(asset_base_path + name)] = asset;
-                } break;
-                default:
-                    break;
-            };
+Texture_Handle
+Asset_Manager::load_texture_2d(Asset_Id asset_id)
+{
+    PROFILE_FUNCTION();
+
+    auto handle = m_textures.find(asset_id);
+    if (!handle.is_valid()) {
+        const auto decoded = decode({ Asset_Type::Texture, asset_id });
+        if (!decoded) {
+            return {};
         }
+
+        handle = create_texture_2d(*decoded);
     }
+
+    m_textures.acquire(handle);
+    evict_textures();
+    return handle;
 }
 
 void
-Asset_Manager::load_asset_file(const std::string& asset_file)
+Asset_Manager::unload_texture_2d(Texture_Handle handle)
 {
-    parse_asset_document(asset_file, "");
+    if (!m_textures.release(handle)) {
+        return;
+    }
 
-    core::log::info("Loaded {} textures", m_texture_filepaths.size());
-    core::log::info("Loaded {} texture atlas", m_texture_atlas_filepaths.size());
-    core::log::info("Loaded {} shaders", m_shader_filepaths.size());
-    core::log::info("Loaded {} fonts", m_font_filepaths.size());
+    if (m_texture_budget == 0) {
+        destroy_texture_2d(handle);
+        PROFILE_COUNTER("texture bytes", m_textures.resident_bytes());
+    }
+    else {
+        evict_textures();
+    }
 }
 
-std::shared_ptr<graphics::Texture_2D>
-Asset_Manager::load_texture_2d(const std::string& asset_name)
+Texture_Atlas_Handle
+Asset_Manager::load_texture_atlas(Asset_Id asset_id)
 {
-    auto texture = get_texture_2d(asset_name);
-    if (texture) {
-        return texture;
-    }
+    PROFILE_FUNCTION();
 
-    if (m_texture_filepaths.count(asset_name) == 0u) {
-        core::log::warn("Attempting to load unrecognized texture {}", asset_name);
-        return nullptr;
+    auto handle = m_texture_atlases.find(asset_id);
+    if (!handle.is_valid()) {
+        const auto decoded = decode({ Asset_Type::Texture_Atlas, asset_id });
+        if (!decoded) {
+            return {};
+        }
+
+        handle = create_texture_atlas(*decoded);
     }
 
-    Texture_Asset asset = m_texture_filepaths[asset_name];
+    m_texture_atlases.acquire(handle);
+    return handle;
+}
 
-    if (asset.flip_on_load) {
-        stbi_set_flip_vertically_on_load(1);
+void
+Asset_Manager::unload_texture_atlas(Texture_Atlas_Handle handle)
+{
+    if (m_texture_atlases.release(handle)) {
+        destroy_texture_atlas(handle);
     }
+}
 
-    i32 width = 0;
-    i32 height = 0;
-    i32 channels = 0;
-    auto* const data = stbi_load(asset.filepath.c_str(), &width, &height, &channels, 0);
+Shader_Handle
+Asset_Manager::load_shader(Asset_Id asset_id)
+{
+    PROFILE_FUNCTION();
 
-    auto new_texture = std::make_shared<graphics::Texture_2D>();
-    new_texture->create(static_cast<u32>(width), static_cast<u32>(height), data);
+    auto handle = m_shaders.find(asset_id);
+    if (!handle.is_valid()) {
+        const auto decoded = decode({ Asset_Type::Shader, asset_id });
+        if (!decoded) {
+            return {};
+        }
 
-    stbi_image_free(data);
+        handle = create_shader(*decoded);
+    }
+
+    m_shaders.acquire(handle);
+    return handle;
+}
 
-    if (asset.scale != 1.0f) {
-        // TODO: Implement texture scaling.
+void
+Asset_Manager::unload_shader(Shader_Handle handle)
+{
+    if (m_shaders.release(handle)) {
+        m_shaders.remove(handle);
     }
+}
 
-    if (asset.flip_on_load) {
-        stbi_set_flip_vertically_on_load(0);
+Font_Handle
+Asset_Manager::load_font(Asset_Id asset_id)
+{
+    PROFILE_FUNCTION();
+
+    auto handle = m_fonts.find(asset_id);
+    if (!handle.is_valid()) {
+        const auto decoded = decode({ Asset_Type::Font, asset_id });
+        if (!decoded) {
+            return {};
+        }
+
+        handle = create_font(*decoded);
     }
 
-    m_loaded_textures.insert({ asset_name, new_texture });
-    return new_texture;
+    m_fonts.acquire(handle);
+    return handle;
 }
 
-std::shared_ptr<graphics::Texture_2D>
-Asset_Manager::get_texture_2d(const std::string& asset_name)
+void
+Asset_Manager::unload_font(Font_Handle handle)
 {
-    if (m_loaded_textures.count(asset_name) == 0) {
-        return nullptr;
+    if (m_fonts.release(handle)) {
+        destroy_font(handle);
+    }
+}
+
+Animation_Handle
+Asset_Manager::load_animation(Asset_Id asset_id)
+{
+    PROFILE_FUNCTION();
+
+    auto handle = m_animations.find(asset_id);
+    if (!handle.is_valid()) {
+        const auto decoded = decode({ Asset_Type::Animation, asset_id });
+        if (!decoded) {
+            return {};
+        }
+
+        handle = create_animation(*decoded);
     }
 
-    return m_loaded_textures[asset_name];
+    m_animations.acquire(handle);
+    return handle;
 }
 
 void
-Asset_Manager::unload_texture_2d(const std::string& asset_name)
+Asset_Manager::unload_animation(Animation_Handle handle)
 {
-    const auto texture = get_texture_2d(asset_name);
-    if (!texture) {
+    if (m_animations.release(handle)) {
+        destroy_animation(handle);
+    }
+}
+
+void
+Asset_Manager::preload(const std::vector<Asset_Reference>& group)
+{
+    PROFILE_FUNCTION();
+
+    struct Node {
+        Asset_Reference asset;
+        std::future<std::unique_ptr<Decoded_Asset>> decoded;
+        // The nodes which can't be created until this one has been.
+        std::vector<size_t> dependents;
+        u32 pending_dependencies{ 0 };
+    };
+
+    // Gather the group & its dependencies into a graph, leaving out anything already loaded.
+    std::vector<Node> nodes;
+    std::map<std::pair<Asset_Type, Asset_Id>, size_t> node_indices;
+    std::vector<size_t> unvisited;
+
+    const auto add_node = [&](Asset_Reference asset) -> std::optional<size_t> {
+        if (is_loaded(asset)) {
+            return std::nullopt;
+        }
+
+        const auto [node_index, inserted] = node_indices.try_emplace({ asset.type, asset.id }, nodes.size());
+        if (inserted) {
+            nodes.push_back({ asset, {}, {}, 0 });
+            unvisited.push_back(node_index->second);
+        }
+        return node_index->second;
+    };
+
+    for (const auto& asset : group) {
+        add_node(asset);
+    }
+
+    while (!unvisited.empty()) {
+        const auto index = unvisited.back();
+        unvisited.pop_back();
+
+        const auto dependency = get_dependency(nodes[index].asset);
+        if (!dependency) {
+            continue;
+        }
+
+        if (const auto dependency_index = add_node(*dependency)) {
+            nodes[*dependency_index].dependents.push_back(index);
+            ++nodes[index].pending_dependencies;
+        }
+    }
+
+    if (nodes.empty()) {
         return;
     }
 
-    m_loaded_textures.erase(asset_name);
+    if (!m_thread_pool) {
+        m_thread_pool = std::make_shared<yuki::Thread_Pool>();
+    }
+
+    // Decoding doesn't depend on anything else being loaded, so everything is queued at once.
+    for (auto& node : nodes) {
+        node.decoded = m_thread_pool->submit([this, asset = node.asset]() {
+            PROFILE_SCOPE("Asset_Manager::preload() decode");
+
+            auto decoded = decode(asset);
+            PROFILE_FLOW_BEGIN("asset upload", asset.id);
+            return decoded;
+        });
+    }
+
+    // Create the GL objects in dependency order, preferring assets which have finished decoding so the uploads
+    // overlap the decodes still running.
+    std::deque<size_t> ready;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].pending_dependencies == 0) {
+            ready.push_back(i);
+        }
+    }
+
+    while (!ready.empty()) {
+        auto next = std::find_if(ready.begin(), ready.end(), [&nodes](size_t index) {
+            return nodes[index].decoded.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        });
+        if (next == ready.end()) {
+            next = ready.begin();
+        }
+
+        auto& node = nodes[*next];
+        ready.erase(next);
+
+        const auto decoded = node.decoded.get();
+        PROFILE_FLOW_END("asset upload", node.asset.id);
+        if (decoded) {
+            create(*decoded);
+        }
+
+        for (const auto dependent : node.dependents) {
+            if (--nodes[dependent].pending_dependencies == 0) {
+                ready.push_back(dependent);
+            }
+        }
+    }
+
+    core::log::info("Preloaded {} assets on {} threads", nodes.size(), m_thread_pool->thread_count());
 }
 
-std::shared_ptr<graphics::Texture_Atlas>
-Asset_Manager::load_texture_atlas(const std::string& asset_name)
+std::unique_ptr<Asset_Manager::Decoded_Asset>
+Asset_Manager::decode(Asset_Reference asset) const
 {
-    auto texture_atlas = get_texture_atlas(asset_name);
-    if (texture_atlas) {
-        return texture_atlas;
+    PROFILE_FUNCTION();
+
+    auto decoded = std::make_unique<Decoded_Asset>();
+    decoded->asset = asset;
+
+    const auto* entry = find_archive_entry(asset.type, asset.id);
+    switch (asset.type) {
+    case Asset_Type::Texture: {
+        if (entry != nullptr) {
+            // Packed textures are already decoded or block compressed & flipped, they're uploaded straight out of the
+            // archive.
+            decoded->data = m_archive->data(*entry);
+            decoded->data_owner = m_archive;
+            decoded->width = entry->width;
+            decoded->height = entry->height;
+            decoded->format = get_texture_format(entry->compression, entry->channels);
+            decoded->mip_levels = entry->mip_levels;
+
+            if (!graphics::Texture_2D::is_format_supported(decoded->format)) {
+                // The driver can't sample the blocks, fall back to RGBA8 decompressed here rather than on the
+                // context thread.
+                auto pixels = std::make_shared<std::vector<u8>>();
+                const auto* blocks = decoded->data;
+                for (u32 level = 0; level < entry->mip_levels; ++level) {
+                    const u32 level_width = std::max(entry->width >> level, 1U);
+                    const u32 level_height = std::max(entry->height >> level, 1U);
+                    const auto level_pixels = decompress_blocks(entry->compression, blocks, level_width, level_height);
+                    pixels->insert(pixels->end(), level_pixels.begin(), level_pixels.end());
+                    blocks += get_block_compressed_size(entry->compression, level_width, level_height); // NOLINT
+                }
+                decoded->data = pixels->data();
+                decoded->data_owner = std::move(pixels);
+                decoded->format = graphics::Texture_2D::Format::RGBA;
+            }
+            break;
+        }
+
+        const auto texture = m_index.find_texture(asset.id);
+        if (!texture) {
+            core::log::warn("Attempting to load unrecognized texture {:016x}", asset.id);
+            return nullptr;
+        }
+
+        if (!texture->atlas.empty()) {
+            // Created as a view of the atlas page, the pixels are decoded along with the rest of the page.
+            decoded->name = texture->name;
+            decoded->atlas = make_asset_id(texture->atlas);
+            break;
+        }
+
+        if (texture->is_atlas_page) {
+            const auto members = get_atlas_members(texture->name);
+            const auto layout = get_atlas_layout(members);
+            auto page = std::make_shared<std::vector<u8>>(size_t{ layout.width } * layout.height * 4, 0);
+            for (size_t i = 0; i < members.size(); ++i) {
+                const auto& region = layout.regions[i];
+                if (region.z == region.x) {
+                    continue;
+                }
+
+                const auto pixels = load_texture_pixels(members[i]);
+                if (!pixels || pixels->width != region.z - region.x || pixels->height != region.w - region.y) {
+                    core::log::error("Asset_Manager::decode() failed to pack texture {} into atlas", members[i].filepath);
+                    continue;
+                }
+                blit_atlas_image(pixels->data, pixels->channels, region, page->data(), layout.width, layout.height);
+            }
+
+            decoded->width = layout.width;
+            decoded->height = layout.height;
+            decoded->format = graphics::Texture_2D::Format::RGBA;
+            decoded->data = page->data();
+            decoded->data_owner = std::move(page);
+            break;
+        }
+
+        if (!decode_texture_file(*texture, *decoded)) {
+            return nullptr;
+        }
+        break;
     }
+    case Asset_Type::Texture_Atlas: {
+        if (entry != nullptr) {
+            if (!parse_atlas_data(m_archive->data(*entry), entry->size, decoded->sub_textures)) {
+                core::log::error("Asset_Manager::decode() failed to parse texture atlas {}", entry->name);
+                return nullptr;
+            }
+            break;
+        }
 
-    if (m_texture_atlas_filepaths.count(asset_name) == 0u) {
-        core::log::warn("Attempting to load unrecognized texture atlas {}", asset_name);
-        return nullptr;
+        const auto texture_atlas = m_index.find_texture_atlas(asset.id);
+        if (!texture_atlas) {
+            core::log::warn("Attempting to load unrecognized texture atlas {:016x}", asset.id);
+            return nullptr;
+        }
+
+        if (texture_atlas->is_generated) {
+            // Packed the same way as the page texture, textures which didn't fit are left to load on their own.
+            const auto members = get_atlas_members(texture_atlas->sub_texture_id);
+            const auto layout = get_atlas_layout(members);
+            for (size_t i = 0; i < members.size(); ++i) {
+                if (layout.regions[i].z != layout.regions[i].x) {
+                    decoded->sub_textures.push_back({ graphics::make_sub_texture_id(members[i].name), layout.regions[i] });
+                }
+            }
+            break;
+        }
+
+        yuki::platform::Mapped_File file;
+        if (!file.open(texture_atlas->filepath, yuki::platform::Mapped_File::Access::READ)) {
+            core::log::error("Asset_Manager::decode() failed to open file {}", texture_atlas->filepath);
+            return nullptr;
+        }
+
+        if (!parse_atlas_data(file.data(), file.size(), decoded->sub_textures)) {
+            core::log::error("Asset_Manager::decode() failed to parse texture atlas {}", texture_atlas->filepath);
+            return nullptr;
+        }
+        break;
     }
+    case Asset_Type::Shader: {
+        if (entry != nullptr) {
+            const auto* const data = reinterpret_cast<const char*>(m_archive->data(*entry)); // NOLINT
+            decoded->vertex_source.assign(data, entry->vertex_size);
+            decoded->fragment_source.assign(data + entry->vertex_size, entry->size - entry->vertex_size); // NOLINT
+            break;
+        }
 
-    Texture_Atlas_Asset asset = m_texture_atlas_filepaths[asset_name];
+        const auto shader = m_index.find_shader(asset.id);
+        if (!shader) {
+            core::log::warn("Attempting to load unrecognized shader {:016x}", asset.id);
+            return nullptr;
+        }
 
-    const auto texture = load_texture_2d(asset.sub_texture_id);
-    if (!texture) {
-        core::log::error("Asset_Manager::load_texture_atlas() failed to load internal texture {}", asset.sub_texture_id);
-        return nullptr;
+        decoded->vertex_source = read_text_file(shader->filepath + shader->vertex_src_file);
+        decoded->fragment_source = read_text_file(shader->filepath + shader->fragment_src_file);
+        break;
     }
+    case Asset_Type::Font: {
+        if (entry != nullptr) {
+            // FreeType reads the face straight out of the mapped archive, the font keeps the archive alive.
+            decoded->name = entry->name;
+            decoded->data = m_archive->data(*entry);
+            decoded->data_size = entry->size;
+            decoded->data_owner = m_archive;
+            break;
+        }
+
+        const auto font = m_index.find_font(asset.id);
+        if (!font) {
+            core::log::warn("Attempting to load unrecognized font {:016x}", asset.id);
+            return nullptr;
+        }
+
+        // Read the whole file here rather than letting FreeType open it on the first glyph, on the context thread.
+        std::ifstream file(font->filepath, std::ifstream::binary);
+        if (!file.is_open()) {
+            core::log::error("Asset_Manager::decode() failed to open file {}", font->filepath);
+            return nullptr;
+        }
+
+        auto font_file = std::make_shared<std::vector<u8>>(
+            std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()
+        );
+        decoded->name = font->filepath;
+        decoded->data = font_file->data();
+        decoded->data_size = font_file->size();
+        decoded->data_owner = std::move(font_file);
+        break;
+    }
+    case Asset_Type::Animation: {
+        if (entry != nullptr) {
+            if (!parse_animation_data(m_archive->data(*entry), entry->size, decoded->frames)) {
+                core::log::error("Asset_Manager::decode() failed to parse animation {}", entry->name);
+                return nullptr;
+            }
+            break;
+        }
 
-    std::ifstream file(asset.filepath, std::ifstream::in);
-    if (!file.is_open()) {
-        core::log::error("Asset_Manager::load_texture_atlas() failed to open file {}", asset.filepath);
+        const auto animation = m_index.find_animation(asset.id);
+        if (!animation) {
+            core::log::warn("Attempting to load unrecognized animation {:016x}", asset.id);
+            return nullptr;
+        }
+
+        yuki::platform::Mapped_File file;
+        if (!file.open(animation->filepath, yuki::platform::Mapped_File::Access::READ)) {
+            core::log::error("Asset_Manager::decode() failed to open file {}", animation->filepath);
+            return nullptr;
+        }
+
+        if (!parse_animation_data(file.data(), file.size(), decoded->frames)) {
+            core::log::error("Asset_Manager::decode() failed to parse animation {}", animation->filepath);
+            return nullptr;
+        }
+        break;
+    }
+    case Asset_Type::Asset_List:
         return nullptr;
     }
 
-    std::unordered_map<std::string, v4u> sub_textures;
+    return decoded;
+}
+
+bool
+Asset_Manager::decode_texture_file(const Texture_Asset& texture, Decoded_Asset& decoded)
+{
+    const auto pixels = load_texture_pixels(texture);
+    if (!pixels) {
+        core::log::error("Asset_Manager::decode() failed to decode texture {}", texture.filepath);
+        return false;
+    }
+
+    decoded.data = pixels->data;
+    decoded.data_owner = pixels->data_owner;
+    decoded.width = pixels->width;
+    decoded.height = pixels->height;
+    decoded.format = get_texture_format(Block_Compression::None, pixels->channels);
+    decoded.mip_levels = texture.mipmaps ? graphics::Texture_2D::GENERATE_MIP_CHAIN : 1;
+    return true;
+}
+
+Texture_Handle
+Asset_Manager::create_texture_2d(const Decoded_Asset& decoded)
+{
+    PROFILE_FUNCTION();
+
+    auto new_texture = std::make_shared<graphics::Texture_2D>();
+    if (decoded.atlas != 0) {
+        // The texture is a user of its atlas until it's destroyed.
+        const auto atlas_handle = load_texture_atlas(decoded.atlas);
+        const auto* atlas = get(atlas_handle);
+        const auto* rect = atlas != nullptr ? atlas->find_sub_texture(graphics::make_sub_texture_id(decoded.name)) : nullptr;
+        if (rect != nullptr) {
+            new_texture->create_view(atlas->get_texture(), rect->size.x, rect->size.y, rect->texture_coords);
+            m_atlas_members[decoded.asset.id] = { decoded.atlas, graphics::make_sub_texture_id(decoded.name) };
+        }
+        else {
+            core::log::warn("Texture {} didn't fit in its atlas, loading it on its own", decoded.name);
+            unload_texture_atlas(atlas_handle);
+
+            const auto texture = m_index.find_texture(decoded.asset.id);
+            Decoded_Asset standalone;
+            if (!texture || !decode_texture_file(*texture, standalone)) {
+                core::log::error("Failed to load texture {} on its own", decoded.name);
+                return {};
+            }
+            new_texture->create(standalone.width, standalone.height, standalone.data, standalone.format, standalone.mip_levels);
+        }
+    }
+    else {
+        new_texture->create(decoded.width, decoded.height, decoded.data, decoded.format, decoded.mip_levels);
+    }
+
+    const auto new_handle = m_textures.insert(decoded.asset.id, new_texture, new_texture->byte_size());
 
-    std::string sub_texture_details;
-    while (file.peek() != EOF) {
-        std::getline(file, sub_texture_details);
+    PROFILE_INSTANT("texture loaded");
+    PROFILE_COUNTER("loaded textures", m_textures.size());
+    PROFILE_COUNTER("texture bytes", m_textures.resident_bytes());
+    return new_handle;
+}
 
-        v4u image_dims{ 0 };
-        std::string texture_name;
-        std::stringstream sub_texture_details_stream(sub_texture_details);
-        sub_texture_details_stream >> texture_name;
-        sub_texture_details_stream >> image_dims.x >> image_dims.y >> image_dims.z >> image_dims.w;
+Texture_Atlas_Handle
+Asset_Manager::create_texture_atlas(const Decoded_Asset& decoded)
+{
+    PROFILE_FUNCTION();
 
-        sub_textures.emplace(texture_name, image_dims);
+    // The atlas is a user of its texture until it's destroyed.
+    const auto sub_texture_id = get_atlas_texture_id(decoded.asset.id);
+    const auto texture = share(load_texture_2d(sub_texture_id));
+    if (!texture) {
+        core::log::error("Asset_Manager::load_texture_atlas() failed to load internal texture {:016x}", sub_texture_id);
+        return {};
     }
 
     auto new_texture_atlas = std::make_shared<graphics::Texture_Atlas>();
-    new_texture_atlas->create(texture, sub_textures);
+    new_texture_atlas->create(texture, decoded.sub_textures);
 
-    m_loaded_texture_atlas.insert({ asset_name, new_texture_atlas });
-    return new_texture_atlas;
+    const auto new_handle = m_texture_atlases.insert(decoded.asset.id, new_texture_atlas);
+
+    PROFILE_INSTANT("texture atlas loaded");
+    return new_handle;
 }
 
-std::shared_ptr<graphics::Texture_Atlas>
-Asset_Manager::get_texture_atlas(const std::string& asset_name)
+Shader_Handle
+Asset_Manager::create_shader(const Decoded_Asset& decoded)
 {
-    if (m_loaded_texture_atlas.count(asset_name) == 0) {
-        return nullptr;
+    PROFILE_FUNCTION();
+
+    auto new_shader = std::make_shared<graphics::Shader>();
+    new_shader->create(decoded.vertex_source, decoded.fragment_source);
+
+    const auto new_handle = m_shaders.insert(decoded.asset.id, new_shader);
+
+    PROFILE_INSTANT("shader loaded");
+    return new_handle;
+}
+
+Font_Handle
+Asset_Manager::create_font(const Decoded_Asset& decoded)
+{
+    PROFILE_FUNCTION();
+
+    const auto font_shader = share(load_shader(FONT_SHADER_ID));
+
+    auto new_font = std::make_shared<graphics::Sprite_Font>();
+    new_font->create(decoded.name, decoded.data, decoded.data_size, decoded.data_owner, font_shader);
+
+    const auto new_handle = m_fonts.insert(decoded.asset.id, new_font);
+
+    PROFILE_INSTANT("font loaded");
+    return new_handle;
+}
+
+Animation_Handle
+Asset_Manager::create_animation(const Decoded_Asset& decoded)
+{
+    PROFILE_FUNCTION();
+
+    // The animation is a user of its atlas until it's destroyed.
+    const auto atlas_id = get_animation_atlas_id(decoded.asset.id);
+    const auto atlas = share(load_texture_atlas(atlas_id));
+    if (!atlas) {
+        core::log::error("Asset_Manager::load_animation() failed to load texture atlas {:016x}", atlas_id);
+        return {};
     }
 
-    return m_loaded_texture_atlas[asset_name];
+    auto new_animation = std::make_shared<graphics::Animation>();
+    new_animation->create(atlas, decoded.frames);
+
+    const auto new_handle = m_animations.insert(decoded.asset.id, new_animation);
+
+    PROFILE_INSTANT("animation loaded");
+    return new_handle;
 }
 
 void
-Asset_Manager::unload_texture_atlas(const std::string& asset_name)
+Asset_Manager::create(const Decoded_Asset& decoded)
 {
-    const auto texture_atlas = get_texture_atlas(asset_name);
-    if (!texture_atlas) {
-        return;
+    switch (decoded.asset.type) {
+    case Asset_Type::Texture:
+        create_texture_2d(decoded);
+        break;
+    case Asset_Type::Texture_Atlas:
+        create_texture_atlas(decoded);
+        break;
+    case Asset_Type::Shader:
+        create_shader(decoded);
+        break;
+    case Asset_Type::Font:
+        create_font(decoded);
+        break;
+    case Asset_Type::Animation:
+        create_animation(decoded);
+        break;
+    case Asset_Type::Asset_List:
+        break;
     }
+}
 
-    const auto texture_name = m_texture_atlas_filepaths.at(asset_name).sub_texture_id;
-    unload_texture_2d(texture_name);
-
-    m_loaded_texture_atlas.erase(asset_name);
+void
+Asset_Manager::set_texture_budget(u64 budget_bytes)
+{
+    m_texture_budget = budget_bytes;
+    evict_textures();
 }
 
-std::shared_ptr<graphics::Shader>
-Asset_Manager::load_shader(const std::string& asset_name)
+u64
+Asset_Manager::get_resident_bytes(Asset_Type type) const
 {
-    auto shader = get_shader(asset_name);
-    if (shader) {
-        return shader;
+    switch (type) {
+    case Asset_Type::Texture:
+        return m_textures.resident_bytes();
+    case Asset_Type::Font: {
+        // Glyph textures grow as new sizes are rendered, so they're summed up rather than tracked by the pool.
+        u64 bytes = 0;
+        m_fonts.for_each([&bytes](const graphics::Sprite_Font& font) { bytes += font.texture_bytes(); });
+        return bytes;
+    }
+    case Asset_Type::Animation:
+    case Asset_Type::Asset_List:
+    case Asset_Type::Shader:
+    case Asset_Type::Texture_Atlas:
+        break;
     }
+    return 0;
+}
 
-    if (m_shader_filepaths.count(asset_name) == 0u) {
-        core::log::warn("Attempting to load unrecognized shader {}", asset_name);
-        return nullptr;
+void
+Asset_Manager::destroy_texture_2d(Texture_Handle handle)
+{
+    const auto asset_id = m_textures.get_id(handle);
+    m_textures.remove(handle);
+
+    const auto member = m_atlas_members.find(asset_id);
+    if (member != m_atlas_members.end()) {
+        const auto atlas_id = member->second.atlas;
+        m_atlas_members.erase(member);
+        unload_texture_atlas(m_texture_atlases.find(atlas_id));
     }
+}
 
-    Shader_Asset asset = m_shader_filepaths[asset_name];
+void
+Asset_Manager::destroy_texture_atlas(Texture_Atlas_Handle handle)
+{
+    const auto texture_id = get_atlas_texture_id(m_texture_atlases.get_id(handle));
+    m_texture_atlases.remove(handle);
+    unload_texture_2d(m_textures.find(texture_id));
+}
 
-    const auto vertex_filepath = asset.filepath + asset.vertex_src_file;
-    const auto fragment_filepath = asset.filepath + asset.fragment_src_file;
+void
+Asset_Manager::destroy_font(Font_Handle handle)
+{
+    m_fonts.remove(handle);
+    unload_shader(m_shaders.find(FONT_SHADER_ID));
+}
 
-    std::ifstream vertex_file_stream(vertex_filepath);
-    std::ifstream fragment_file_stream(fragment_filepath);
+void
+Asset_Manager::destroy_animation(Animation_Handle handle)
+{
+    const auto atlas_id = get_animation_atlas_id(m_animations.get_id(handle));
+    m_animations.remove(handle);
+    unload_texture_atlas(m_texture_atlases.find(atlas_id));
+}
 
-    std::stringstream vertex_string_stream;
-    std::stringstream fragment_string_stream;
+void
+Asset_Manager::evict_textures()
+{
+    if (m_texture_budget == 0) {
+        return;
+    }
 
-    vertex_string_stream << vertex_file_stream.rdbuf();
-    fragment_string_stream << fragment_file_stream.rdbuf();
+    while (m_textures.resident_bytes() > m_texture_budget) {
+        const auto handle = m_textures.find_unused();
+        if (!handle.is_valid()) {
+            core::log::warn(
+                "Texture memory {} bytes is over the budget of {} bytes with every texture in use",
+                m_textures.resident_bytes(),
+                m_texture_budget
+            );
+            break;
+        }
 
-    vertex_file_stream.close();
-    fragment_file_stream.close();
+        destroy_texture_2d(handle);
+        PROFILE_INSTANT("texture evicted");
+    }
 
-    auto new_shader = std::make_shared<graphics::Shader>();
-    new_shader->create(vertex_string_stream.str(), fragment_string_stream.str());
+    PROFILE_COUNTER("texture bytes", m_textures.resident_bytes());
+}
 
-    m_loaded_shaders.insert({ asset_name, new_shader });
-    return new_shader;
+bool
+Asset_Manager::enable_hot_reload(const std::string& directory)
+{
+    auto file_watcher = std::make_shared<yuki::platform::File_Watcher>();
+    if (!file_watcher->watch(directory)) {
+        return false;
+    }
+    m_file_watcher = file_watcher;
+
+    if (m_archive) {
+        core::log::warn("Hot reloading {} with an asset archive loaded, packed assets won't be reloaded", directory);
+    }
+
+    core::log::info("Hot reloading assets in {}", directory);
+    return true;
 }
 
-std::shared_ptr<graphics::Shader>
-Asset_Manager::get_shader(const std::string& asset_name)
+void
+Asset_Manager::update()
 {
-    if (m_loaded_shaders.count(asset_name) == 0) {
-        return nullptr;
+    if (!m_file_watcher) {
+        return;
     }
 
-    return m_loaded_shaders[asset_name];
+    for (const auto& filepath : m_file_watcher->poll()) {
+        reload_file(filepath);
+    }
 }
 
 void
-Asset_Manager::unload_shader(const std::string& asset_name)
+Asset_Manager::reload_file(const std::string& filepath)
 {
-    const auto shader = get_shader(asset_name);
-    if (!shader) {
+    PROFILE_FUNCTION();
+
+    const auto path = std::filesystem::path(filepath).lexically_normal();
+    const bool is_asset_file = path == std::filesystem::path(m_asset_file).lexically_normal();
+    const bool is_manifest =
+        path.extension() == ".xml" && std::filesystem::path(m_asset_file).extension() != ASSET_INDEX_EXTENSION;
+    if (is_asset_file || is_manifest) {
+        // Loaded assets keep their ids, so only the descriptions need rebuilding, they're used by the next load.
+        core::log::info("Reloading asset index after {} changed", filepath);
+        load_asset_file(m_asset_file);
         return;
     }
 
-    m_loaded_shaders.erase(asset_name);
+    for (const auto& asset : m_index.find_by_file(filepath)) {
+        if (is_loaded(asset) && find_archive_entry(asset.type, asset.id) == nullptr) {
+            reload(asset);
+        }
+    }
 }
 
-std::shared_ptr<graphics::Sprite_Font>
-Asset_Manager::load_font(const std::string& asset_name)
+void
+Asset_Manager::reload(Asset_Reference asset)
 {
-    auto font = get_font(asset_name);
-    if (font) {
-        return font;
+    PROFILE_FUNCTION();
+
+    if (asset.type == Asset_Type::Texture) {
+        if (const auto member = m_atlas_members.find(asset.id); member != m_atlas_members.end()) {
+            reload_generated_atlas(member->second.atlas);
+            return;
+        }
     }
 
-    if (m_font_filepaths.count(asset_name) == 0u) {
-        core::log::warn("Attempting to load unrecognized font {}", asset_name);
-        return nullptr;
+    const auto decoded = decode(asset);
+    if (!decoded) {
+        return;
     }
 
-    Font_Asset asset = m_font_filepaths[asset_name];
+    // The assets are created again in place rather than replaced, so every holder of a handle or shared_ptr
+    // picks up the new version.
+    switch (asset.type) {
+    case Asset_Type::Texture: {
+        // A texture which didn't fit in its generated atlas was created on its own, so it's reloaded on its own too.
+        if (decoded->atlas != 0) {
+            const auto texture_asset = m_index.find_texture(asset.id);
+            if (!texture_asset || !decode_texture_file(*texture_asset, *decoded)) {
+                return;
+            }
+        }
 
-    auto new_font = std::make_shared<graphics::Sprite_Font>();
-    // TODO: Specify the shader in the font xml file
-    new_font->create(asset.filepath, get_shader("shaders/spritefont"));
+        const auto handle = m_textures.find(asset.id);
+        auto* texture = m_textures.get(handle);
+        texture->create(decoded->width, decoded->height, decoded->data, decoded->format, decoded->mip_levels);
+        m_textures.set_byte_size(handle, texture->byte_size());
+        // The new version may be larger, e.g. with mip levels added.
+        evict_textures();
+        break;
+    }
+    case Asset_Type::Texture_Atlas: {
+        const auto texture = m_textures.share(m_textures.find(get_atlas_texture_id(asset.id)));
+        auto* atlas = m_texture_atlases.get(m_texture_atlases.find(asset.id));
+        atlas->create(texture, decoded->sub_textures);
+
+        // Animations resolve their frames when created, so they're resolved again against the new regions.
+        m_animations.for_each([atlas](graphics::Animation& animation) {
+            if (animation.get_atlas().get() == atlas) {
+                animation.create(animation.get_atlas(), animation.frames());
+            }
+        });
+        break;
+    }
+    case Asset_Type::Shader:
+        m_shaders.get(m_shaders.find(asset.id))->create(decoded->vertex_source, decoded->fragment_source);
+        break;
+    case Asset_Type::Font:
+        // Fonts cache a face & glyph texture per size, they're picked up on the next run.
+        core::log::info("Font {:016x} changed, fonts aren't hot reloaded", asset.id);
+        return;
+    case Asset_Type::Animation: {
+        auto* animation = m_animations.get(m_animations.find(asset.id));
+        animation->create(animation->get_atlas(), decoded->frames);
+        break;
+    }
+    case Asset_Type::Asset_List:
+        return;
+    }
 
-    m_loaded_fonts.insert({ asset_name, new_font });
-    return new_font;
+    core::log::info("Reloaded {} {:016x}", magic_enum::enum_name(asset.type), asset.id);
 }
 
-std::shared_ptr<graphics::Sprite_Font>
-Asset_Manager::get_font(const std::string& asset_name)
+void
+Asset_Manager::reload_generated_atlas(Asset_Id atlas_id)
+{
+    reload({ Asset_Type::Texture, get_atlas_texture_id(atlas_id) });
+    reload({ Asset_Type::Texture_Atlas, atlas_id });
+
+    // Members are copies of the atlas sub-textures, the new regions are copied over them in place.
+    const auto* atlas = m_texture_atlases.get(m_texture_atlases.find(atlas_id));
+    for (const auto& [member_id, member] : m_atlas_members) {
+        const auto* rect = member.atlas == atlas_id ? atlas->find_sub_texture(member.sub_texture_id) : nullptr;
+        if (rect != nullptr) {
+            m_textures.get(m_textures.find(member_id))
+                ->create_view(atlas->get_texture(), rect->size.x, rect->size.y, rect->texture_coords);
+        }
+    }
+}
+
+bool
+Asset_Manager::is_loaded(Asset_Reference asset) const
+{
+    switch (asset.type) {
+    case Asset_Type::Texture:
+        return m_textures.find(asset.id).is_valid();
+    case Asset_Type::Texture_Atlas:
+        return m_texture_atlases.find(asset.id).is_valid();
+    case Asset_Type::Shader:
+        return m_shaders.find(asset.id).is_valid();
+    case Asset_Type::Font:
+        return m_fonts.find(asset.id).is_valid();
+    case Asset_Type::Animation:
+        return m_animations.find(asset.id).is_valid();
+    case Asset_Type::Asset_List:
+        break;
+    }
+    return false;
+}
+
+std::optional<Asset_Reference>
+Asset_Manager::get_dependency(Asset_Reference asset) const
 {
-    if (m_loaded_fonts.count(asset_name) == 0) {
+    switch (asset.type) {
+    case Asset_Type::Texture_Atlas:
+        return Asset_Reference{ Asset_Type::Texture, get_atlas_texture_id(asset.id) };
+    case Asset_Type::Font:
+        return Asset_Reference{ Asset_Type::Shader, FONT_SHADER_ID };
+    case Asset_Type::Animation:
+        return Asset_Reference{ Asset_Type::Texture_Atlas, get_animation_atlas_id(asset.id) };
+    case Asset_Type::Texture: {
+        if (find_archive_entry(Asset_Type::Texture, asset.id) != nullptr) {
+            break;
+        }
+        const auto texture = m_index.find_texture(asset.id);
+        if (texture && !texture->atlas.empty()) {
+            return Asset_Reference{ Asset_Type::Texture_Atlas, make_asset_id(texture->atlas) };
+        }
+        break;
+    }
+    case Asset_Type::Asset_List:
+    case Asset_Type::Shader:
+        break;
+    }
+    return std::nullopt;
+}
+
+const Asset_Archive::Entry*
+Asset_Manager::find_archive_entry(Asset_Type type, Asset_Id asset_id) const
+{
+    if (!m_archive) {
         return nullptr;
     }
 
-    return m_loaded_fonts[asset_name];
+    return m_archive->find(type, asset_id);
 }
 
-void
-Asset_Manager::unload_font(const std::string& asset_name)
+Asset_Id
+Asset_Manager::get_atlas_texture_id(Asset_Id asset_id) const
 {
-    const auto font = get_font(asset_name);
-    if (!font) {
-        return;
+    if (const auto* entry = find_archive_entry(Asset_Type::Texture_Atlas, asset_id)) {
+        return make_asset_id(entry->dependency);
+    }
+
+    const auto asset = m_index.find_texture_atlas(asset_id);
+    if (!asset) {
+        return 0;
     }
 
-    m_loaded_fonts.erase(asset_name);
+    return make_asset_id(asset->sub_texture_id);
+}
+
+Asset_Id
+Asset_Manager::get_animation_atlas_id(Asset_Id asset_id) const
+{
+    if (const auto* entry = find_archive_entry(Asset_Type::Animation, asset_id)) {
+        return make_asset_id(entry->dependency);
+    }
+
+    const auto asset = m_index.find_animation(asset_id);
+    if (!asset) {
+        return 0;
+    }
+
+    return make_asset_id(asset->texture_atlas);
+}
+
+std::vector<Texture_Asset>
+Asset_Manager::get_atlas_members(const std::string& atlas) const
+{
+    std::vector<Texture_Asset> members;
+    for (const auto member_id : m_index.find_atlas_members(atlas)) {
+        if (const auto texture = m_index.find_texture(member_id)) {
+            members.push_back(*texture);
+        }
+        else {
+            core::log::warn("Atlas {} member {} is missing from the asset index", atlas, member_id);
+        }
+    }
+    return members;
 }
 
 }
@@ -0,0 +1,242 @@
+/**
+ * File: asset_manifest.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:24:37
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:18:17
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/asset_manifest.hpp"
+
+#include <magic_enum/magic_enum.hpp>
+#include <pugixml.hpp>
+
+#include "core/log.hpp"
+
+namespace {
+
+ascension::assets::Texture_Asset
+parse_texture_asset(const pugi::xml_node& node, const std::string& name, const std::string& filepath)
+{
+    ascension::assets::Texture_Asset asset;
+    if (!node.child("scale").empty()) {
+        asset.scale = std::strtof(node.child("scale").child_value(), nullptr);
+    }
+    if (!node.child("scale_filter").empty()) {
+        const std::string filter_str = node.child("scale_filter").child_value();
+        const auto filter = magic_enum::enum_cast<ascension::assets::Resize_Filter>(filter_str);
+        if (filter.has_value()) {
+            asset.scale_filter = *filter;
+        }
+        else {
+            ascension::core::log::error("Unknown scale filter {} for texture {}", filter_str, name);
+        }
+    }
+    if (!node.child("flip").empty()) {
+        asset.flip_on_load = (std::stoi(node.child("flip").child_value()) != 0);
+    }
+    if (!node.child("mipmaps").empty()) {
+        asset.mipmaps = (std::stoi(node.child("mipmaps").child_value()) != 0);
+    }
+    if (!node.child("atlas").empty()) {
+        asset.atlas = node.child("atlas").child_value();
+    }
+    asset.name = name;
+    asset.filepath = filepath;
+    asset.type = ascension::assets::Asset_Type::Texture;
+
+    return asset;
+}
+
+}
+
+namespace ascension::assets {
+
+void
+Asset_Manifest::clear()
+{
+    m_animations.clear();
+    m_fonts.clear();
+    m_shaders.clear();
+    m_textures.clear();
+    m_texture_atlases.clear();
+}
+
+bool
+Asset_Manifest::load(const std::string& manifest_file)
+{
+    return parse_asset_document(manifest_file, "");
+}
+
+const std::unordered_map<std::string, Animation_Asset>&
+Asset_Manifest::animations() const
+{
+    return m_animations;
+}
+
+const std::unordered_map<std::string, Font_Asset>&
+Asset_Manifest::fonts() const
+{
+    return m_fonts;
+}
+
+const std::unordered_map<std::string, Shader_Asset>&
+Asset_Manifest::shaders() const
+{
+    return m_shaders;
+}
+
+const std::unordered_map<std::string, Texture_Asset>&
+Asset_Manifest::textures() const
+{
+    return m_textures;
+}
+
+const std::unordered_map<std::string, Texture_Atlas_Asset>&
+Asset_Manifest::texture_atlases() const
+{
+    return m_texture_atlases;
+}
+
+bool
+// NOLINTNEXTLINE - this needs to be recursive.
+Asset_Manifest::parse_asset_document(const std::string& document_filepath, const std::string& root_name)
+{
+    pugi::xml_document document;
+    pugi::xml_parse_result result = document.load_file(document_filepath.c_str());
+
+    if (!result) {
+        core::log::error("Failed to load asset file {}. Error {}", document_filepath, result.description());
+        return false;
+    }
+
+    for (const auto& node : document.child("assets").children("asset")) {
+        const std::string name = node.attribute("name").value();
+        const std::string type_str = node.attribute("type").value();
+        const std::string filepath = node.attribute("filepath").value();
+
+        const auto type = magic_enum::enum_cast<Asset_Type>(type_str);
+        if (!type.has_value()) {
+            core::log::error("Unknown asset type {}", type_str);
+            return false;
+        }
+
+        std::string asset_base_path;
+        if (!root_name.empty()) {
+            asset_base_path = root_name + "/";
+        }
+        else if (type != assets::Asset_Type::Asset_List) {
+            asset_base_path = type_str + "/";
+        }
+
+        if (type == Asset_Type::Asset_List) {
+            parse_asset_document(filepath, asset_base_path + name);
+        }
+        else {
+            switch (*type) {
+                case Asset_Type::Texture: {
+                    Texture_Asset asset = parse_texture_asset(node, name, filepath);
+                    // Atlases are named relative to the list, like the textures packed into them.
+                    if (!asset.atlas.empty()) {
+                        asset.atlas = asset_base_path + asset.atlas;
+                    }
+                    // TODO: Should probably check we're not overwriting these...
+                    m_textures[(asset_base_path + name)] = asset;
+                } break;
+                case Asset_Type::Texture_Atlas: {
+                    Texture_Atlas_Asset asset;
+
+                    if (node.child("asset").empty()) {
+                        core::log::error("Trying to load texture atlas {} ({}) without respective texture", name, filepath);
+                        continue;
+                    }
+
+                    const auto texture_node = node.child("asset");
+
+                    const std::string child_type_value = texture_node.attribute("type").value();
+                    const auto child_type = magic_enum::enum_cast<Asset_Type>(child_type_value);
+                    if (!child_type.has_value()) {
+                        core::log::error(
+                            "Unknown asset type {} loading texture atlas {} ({})", child_type_value, name, filepath
+                        );
+                        continue;
+                    }
+
+                    if (*child_type != Asset_Type::Texture) {
+                        core::log::error(
+                            "Unexpected child asset type {} loading texture atlas {} ({})", child_type_value, name, filepath
+                        );
+                        continue;
+                    }
+
+                    const std::string texture_name = texture_node.attribute("name").value();
+                    const std::string texture_filepath = texture_node.attribute("filepath").value();
+                    Texture_Asset texture_asset = parse_texture_asset(texture_node, texture_name, texture_filepath);
+
+                    std::string sub_texture_id = asset_base_path + texture_name;
+                    m_textures[sub_texture_id] = texture_asset;
+
+                    asset.name = name;
+                    asset.filepath = filepath;
+                    asset.type = Asset_Type::Texture_Atlas;
+                    asset.sub_texture_id = sub_texture_id;
+                    m_texture_atlases[(asset_base_path + name)] = asset;
+                } break;
+                case Asset_Type::Shader: {
+                    Shader_Asset asset;
+                    if (node.child("vertex").empty() || node.child("fragment").empty()) {
+                        core::log::error("Trying to load shader {} ({}) without fragment or vertex source.", name, filepath);
+                        continue;
+                    }
+                    asset.vertex_src_file = node.child("vertex").child_value();
+                    asset.fragment_src_file = node.child("fragment").child_value();
+                    asset.name = name;
+                    asset.filepath = filepath;
+                    asset.type = Asset_Type::Shader;
+                    m_shaders[(asset_base_path + name)] = asset;
+                } break;
+                case Asset_Type::Font: {
+                    Font_Asset asset;
+                    asset.name = name;
+                    asset.filepath = filepath;
+                    asset.type = Asset_Type::Font;
+                    m_fonts[(asset_base_path + name)] = asset;
+                } break;
+                case Asset_Type::Animation: {
+                    Animation_Asset asset;
+                    if (node.child("texture_atlas").empty()) {
+                        core::log::error("Trying to load animation {} ({}) without a texture atlas.", name, filepath);
+                        continue;
+                    }
+                    asset.texture_atlas = node.child("texture_atlas").child_value();
+                    asset.name = name;
+                    asset.filepath = filepath;
+                    asset.type = Asset_Type::Animation;
+                    m_animations[(asset_base_path + name)] = asset;
+                } break;
+                default:
+                    break;
+            };
+        }
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,170 @@
+/**
+ * File: atlas_builder.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:01:36
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:06:38
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/atlas_builder.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr u32 RGBA_CHANNELS = 4;
+constexpr u8 OPAQUE_ALPHA = 255;
+
+u32
+next_power_of_two(u32 value)
+{
+    u32 power = 1;
+    while (power < value) {
+        power <<= 1U;
+    }
+    return power;
+}
+
+// Place the images in order into a page of page_size, returning the rows used or 0 if one didn't fit. Images which
+// can never fit are skipped when skip_misfits is set, for the final, largest page.
+u32
+place_on_shelves(
+    const std::vector<v2u>& sizes,
+    const std::vector<size_t>& order,
+    u32 page_size,
+    u32 padding,
+    bool skip_misfits,
+    std::vector<v4u>& regions
+)
+{
+    u32 x = 0;
+    u32 y = 0;
+    u32 shelf_height = 0;
+    for (const auto index : order) {
+        const u32 cell_width = sizes[index].x + padding * 2;
+        const u32 cell_height = sizes[index].y + padding * 2;
+
+        if (x + cell_width > page_size) {
+            x = 0;
+            y += shelf_height;
+            shelf_height = 0;
+        }
+
+        if (x + cell_width > page_size || y + cell_height > page_size) {
+            if (!skip_misfits) {
+                return 0;
+            }
+            regions[index] = v4u{ 0 };
+            continue;
+        }
+
+        regions[index] = { x + padding, y + padding, x + padding + sizes[index].x, y + padding + sizes[index].y };
+        x += cell_width;
+        shelf_height = std::max(shelf_height, cell_height);
+    }
+
+    return y + shelf_height;
+}
+
+}
+
+namespace ascension::assets {
+
+Atlas_Layout
+pack_atlas(const std::vector<v2u>& sizes, u32 max_size, u32 padding)
+{
+    Atlas_Layout layout;
+    layout.regions.assign(sizes.size(), v4u{ 0 });
+    if (sizes.empty()) {
+        return layout;
+    }
+
+    // Images larger than the largest page are left out up front so they don't force every image into it.
+    std::vector<size_t> order;
+    u64 area = 0;
+    u32 widest = 0;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        const u32 cell_width = sizes[i].x + padding * 2;
+        const u32 cell_height = sizes[i].y + padding * 2;
+        if (cell_width <= max_size && cell_height <= max_size) {
+            order.push_back(i);
+            area += u64{ cell_width } * cell_height;
+            widest = std::max({ widest, cell_width, cell_height });
+        }
+    }
+    if (order.empty()) {
+        return layout;
+    }
+
+    // Tallest first keeps the shelves level, ties stay in their original order so the same images always pack the
+    // same way.
+    std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) { return sizes[a].y > sizes[b].y; });
+
+    u32 page_size = next_power_of_two(std::max(widest, static_cast<u32>(std::ceil(std::sqrt(static_cast<f64>(area))))));
+    page_size = std::min(page_size, max_size);
+
+    u32 used_height = 0;
+    for (; page_size < max_size; page_size *= 2) {
+        used_height = place_on_shelves(sizes, order, page_size, padding, false, layout.regions);
+        if (used_height != 0) {
+            break;
+        }
+    }
+    if (used_height == 0) {
+        page_size = max_size;
+        used_height = place_on_shelves(sizes, order, page_size, padding, true, layout.regions);
+    }
+
+    layout.width = page_size;
+    layout.height = used_height;
+    return layout;
+}
+
+void
+blit_atlas_image(const u8* pixels, u32 channels, const v4u& region, u8* page, u32 page_width, u32 page_height, u32 padding)
+{
+    const u32 width = region.z - region.x;
+    const u32 height = region.w - region.y;
+    if (width == 0 || height == 0) {
+        return;
+    }
+
+    const u32 page_x0 = region.x >= padding ? region.x - padding : 0;
+    const u32 page_y0 = region.y >= padding ? region.y - padding : 0;
+    const u32 page_x1 = std::min(region.z + padding, page_width);
+    const u32 page_y1 = std::min(region.w + padding, page_height);
+
+    for (u32 page_y = page_y0; page_y < page_y1; ++page_y) {
+        // Rows & columns in the padding repeat the nearest edge of the image.
+        const u32 y = std::min(page_y > region.y ? page_y - region.y : 0, height - 1);
+        for (u32 page_x = page_x0; page_x < page_x1; ++page_x) {
+            const u32 x = std::min(page_x > region.x ? page_x - region.x : 0, width - 1);
+            const u8* source = &pixels[(size_t{ y } * width + x) * channels];             // NOLINT
+            u8* target = &page[(size_t{ page_y } * page_width + page_x) * RGBA_CHANNELS]; // NOLINT
+
+            std::copy_n(source, std::min(channels, RGBA_CHANNELS), target);
+            if (channels < RGBA_CHANNELS) {
+                target[RGBA_CHANNELS - 1] = OPAQUE_ALPHA; // NOLINT
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,78 @@
+/**
+ * File: atlas_data.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:08:29
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:57:31
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/atlas_data.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "assets/sub_texture_data.hpp"
+
+namespace ascension::assets {
+
+bool
+parse_atlas_data(const u8* data, u64 size, std::vector<graphics::Sub_Texture_Region>& sub_textures)
+{
+    sub_textures.clear();
+    if (is_binary_sub_texture_data(data, size, ATLAS_DATA_MAGIC)) {
+        u32 count = 0;
+        if (!read_sub_texture_data_header(data, size, ATLAS_DATA_VERSION, sizeof(graphics::Sub_Texture_Region), count)) {
+            return false;
+        }
+
+        sub_textures.resize(count);
+        std::memcpy(
+            sub_textures.data(), data + SUB_TEXTURE_DATA_HEADER_SIZE, count * sizeof(graphics::Sub_Texture_Region) // NOLINT
+        );
+        return true;
+    }
+
+    return parse_sub_texture_text(data, size, [&sub_textures](graphics::Sub_Texture_Id id, const char*& it, const char* end) {
+        graphics::Sub_Texture_Region sub_texture;
+        sub_texture.id = id;
+        for (u32 i = 0; i < 4; ++i) {
+            if (!read_sub_texture_text_value(it, end, sub_texture.region[static_cast<i32>(i)])) {
+                return false;
+            }
+        }
+
+        sub_textures.push_back(sub_texture);
+        return true;
+    });
+}
+
+std::vector<u8>
+write_atlas_data(std::vector<graphics::Sub_Texture_Region> sub_textures)
+{
+    std::sort(sub_textures.begin(), sub_textures.end(), [](const auto& lhs, const auto& rhs) { return lhs.id < rhs.id; });
+
+    const size_t regions_size = sub_textures.size() * sizeof(graphics::Sub_Texture_Region);
+    auto data = make_sub_texture_data(
+        ATLAS_DATA_MAGIC, ATLAS_DATA_VERSION, static_cast<u32>(sub_textures.size()), sizeof(graphics::Sub_Texture_Region)
+    );
+    std::memcpy(data.data() + SUB_TEXTURE_DATA_HEADER_SIZE, sub_textures.data(), regions_size); // NOLINT
+    return data;
+}
+
+}
@@ -0,0 +1,408 @@
+/**
+ * File: block_compression.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:46:25
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:17:33
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/block_compression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+using ascension::assets::Block_Compression;
+
+constexpr u32 BLOCK_SIZE = 4;
+constexpr u32 BLOCK_TEXELS = BLOCK_SIZE * BLOCK_SIZE;
+constexpr u64 BC1_BLOCK_BYTES = 8;
+constexpr u64 BC3_BLOCK_BYTES = 16;
+constexpr u32 POWER_ITERATIONS = 8;
+
+using Texel = std::array<u8, 4>;
+using Block = std::array<Texel, BLOCK_TEXELS>;
+
+u32
+get_block_count(u32 size)
+{
+    return (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+}
+
+Block
+load_block(const u8* pixels, u32 width, u32 height, u32 channels, u32 block_x, u32 block_y)
+{
+    Block block{};
+    for (u32 y = 0; y < BLOCK_SIZE; ++y) {
+        for (u32 x = 0; x < BLOCK_SIZE; ++x) {
+            const u32 pixel_x = std::min(block_x * BLOCK_SIZE + x, width - 1);
+            const u32 pixel_y = std::min(block_y * BLOCK_SIZE + y, height - 1);
+            const u8* pixel = pixels + (size_t{ pixel_y } * width + pixel_x) * channels; // NOLINT
+
+            auto& texel = block[y * BLOCK_SIZE + x];
+            for (u32 channel = 0; channel < 4; ++channel) {
+                texel[channel] = channel < channels ? pixel[channel] : u8{ 255 }; // NOLINT
+            }
+        }
+    }
+    return block;
+}
+
+u16
+pack_565(f32 red, f32 green, f32 blue)
+{
+    const auto quantize = [](f32 value, f32 max) {
+        return static_cast<u32>(std::lround(std::clamp(value, 0.0f, 255.0f) * max / 255.0f));
+    };
+    return static_cast<u16>((quantize(red, 31.0f) << 11U) | (quantize(green, 63.0f) << 5U) | quantize(blue, 31.0f));
+}
+
+Texel
+unpack_565(u16 color)
+{
+    const u32 red = (color >> 11U) & 0x1fU;
+    const u32 green = (color >> 5U) & 0x3fU;
+    const u32 blue = color & 0x1fU;
+    return { static_cast<u8>((red << 3U) | (red >> 2U)),
+             static_cast<u8>((green << 2U) | (green >> 4U)),
+             static_cast<u8>((blue << 3U) | (blue >> 2U)),
+             255 };
+}
+
+u8
+interpolate(u32 a, u32 b, u32 weight_a, u32 weight_b)
+{
+    return static_cast<u8>((a * weight_a + b * weight_b) / (weight_a + weight_b));
+}
+
+std::array<Texel, 4>
+get_color_palette(u16 color_0, u16 color_1, bool four_colors)
+{
+    std::array<Texel, 4> palette{ unpack_565(color_0), unpack_565(color_1), Texel{}, Texel{} };
+    for (u32 channel = 0; channel < 3; ++channel) {
+        const u32 a = palette[0][channel];
+        const u32 b = palette[1][channel];
+        palette[2][channel] = four_colors ? interpolate(a, b, 2, 1) : interpolate(a, b, 1, 1);
+        palette[3][channel] = four_colors ? interpolate(a, b, 1, 2) : u8{ 0 };
+    }
+    palette[2][3] = 255;
+    palette[3][3] = four_colors ? u8{ 255 } : u8{ 0 };
+    return palette;
+}
+
+std::array<u8, 8>
+get_alpha_palette(u8 alpha_0, u8 alpha_1)
+{
+    std::array<u8, 8> palette{ alpha_0, alpha_1 };
+    if (alpha_0 > alpha_1) {
+        for (u32 i = 1; i < 7; ++i) {
+            palette[i + 1] = interpolate(alpha_0, alpha_1, 7 - i, i);
+        }
+    }
+    else {
+        for (u32 i = 1; i < 5; ++i) {
+            palette[i + 1] = interpolate(alpha_0, alpha_1, 5 - i, i);
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    return palette;
+}
+
+void
+write_u16(u8* out, u16 value)
+{
+    out[0] = static_cast<u8>(value & 0xffU); // NOLINT
+    out[1] = static_cast<u8>(value >> 8U);   // NOLINT
+}
+
+u16
+read_u16(const u8* in)
+{
+    return static_cast<u16>(in[0] | (in[1] << 8U)); // NOLINT
+}
+
+// Fit the endpoints to the principal axis of the block's colors, which captures most blocks' gradients far better
+// than the per channel bounding box. The bounding box is still used when the block has no principal axis.
+void
+encode_color_block(const Block& block, u8* out)
+{
+    std::array<f32, 3> mean{};
+    std::array<f32, 3> min_color{ 255.0f, 255.0f, 255.0f };
+    std::array<f32, 3> max_color{};
+    for (const auto& texel : block) {
+        for (u32 channel = 0; channel < 3; ++channel) {
+            const auto value = static_cast<f32>(texel[channel]);
+            mean[channel] += value / static_cast<f32>(BLOCK_TEXELS);
+            min_color[channel] = std::min(min_color[channel], value);
+            max_color[channel] = std::max(max_color[channel], value);
+        }
+    }
+
+    std::array<std::array<f32, 3>, 3> covariance{};
+    for (const auto& texel : block) {
+        for (u32 row = 0; row < 3; ++row) {
+            for (u32 column = 0; column < 3; ++column) {
+                covariance[row][column] +=
+                    (static_cast<f32>(texel[row]) - mean[row]) * (static_cast<f32>(texel[column]) - mean[column]);
+            }
+        }
+    }
+
+    // Seeded with the covariance column of the channel which varies most. A fixed seed can be orthogonal to the
+    // principal axis, a red to green gradient against 1, 1, 1 say, which collapses the block to its mean.
+    u32 seed = 0;
+    for (u32 channel = 1; channel < 3; ++channel) {
+        if (covariance[channel][channel] > covariance[seed][seed]) {
+            seed = channel;
+        }
+    }
+
+    std::array<f32, 3> axis = covariance[seed];
+    bool has_axis = covariance[seed][seed] > 0.0f;
+    for (u32 i = 0; i < POWER_ITERATIONS && has_axis; ++i) {
+        std::array<f32, 3> next{};
+        for (u32 row = 0; row < 3; ++row) {
+            next[row] = covariance[row][0] * axis[0] + covariance[row][1] * axis[1] + covariance[row][2] * axis[2];
+        }
+        const f32 length = std::max({ std::abs(next[0]), std::abs(next[1]), std::abs(next[2]) });
+        has_axis = length > 0.0f;
+        if (has_axis) {
+            axis = { next[0] / length, next[1] / length, next[2] / length };
+        }
+    }
+
+    std::array<f32, 3> endpoint_0 = max_color;
+    std::array<f32, 3> endpoint_1 = min_color;
+    if (has_axis) {
+        f32 min_projection = 0.0f;
+        f32 max_projection = 0.0f;
+        const f32 axis_length_squared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        for (const auto& texel : block) {
+            const f32 projection = ((static_cast<f32>(texel[0]) - mean[0]) * axis[0] +
+                                    (static_cast<f32>(texel[1]) - mean[1]) * axis[1] +
+                                    (static_cast<f32>(texel[2]) - mean[2]) * axis[2]) /
+                                   axis_length_squared;
+            min_projection = std::min(min_projection, projection);
+            max_projection = std::max(max_projection, projection);
+        }
+
+        for (u32 channel = 0; channel < 3; ++channel) {
+            endpoint_0[channel] = mean[channel] + axis[channel] * max_projection;
+            endpoint_1[channel] = mean[channel] + axis[channel] * min_projection;
+        }
+    }
+
+    u16 color_0 = pack_565(endpoint_0[0], endpoint_0[1], endpoint_0[2]);
+    u16 color_1 = pack_565(endpoint_1[0], endpoint_1[1], endpoint_1[2]);
+    // color_0 > color_1 selects the four color mode, equal endpoints are a solid block where every index is 0.
+    if (color_0 < color_1) {
+        std::swap(color_0, color_1);
+    }
+
+    u32 indices = 0;
+    if (color_0 != color_1) {
+        const auto palette = get_color_palette(color_0, color_1, true);
+        for (u32 i = 0; i < BLOCK_TEXELS; ++i) {
+            u32 best_index = 0;
+            i32 best_distance = std::numeric_limits<i32>::max();
+            for (u32 index = 0; index < palette.size(); ++index) {
+                i32 distance = 0;
+                for (u32 channel = 0; channel < 3; ++channel) {
+                    const i32 difference = i32{ block[i][channel] } - i32{ palette[index][channel] };
+                    distance += difference * difference;
+                }
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best_index = index;
+                }
+            }
+            indices |= best_index << (i * 2);
+        }
+    }
+
+    write_u16(out, color_0);
+    write_u16(out + 2, color_1); // NOLINT
+    for (u32 i = 0; i < 4; ++i) {
+        out[4 + i] = static_cast<u8>((indices >> (i * 8)) & 0xffU); // NOLINT
+    }
+}
+
+void
+encode_alpha_block(const Block& block, u8* out)
+{
+    u8 alpha_0 = 0;
+    u8 alpha_1 = 255;
+    for (const auto& texel : block) {
+        alpha_0 = std::max(alpha_0, texel[3]);
+        alpha_1 = std::min(alpha_1, texel[3]);
+    }
+
+    u64 indices = 0;
+    if (alpha_0 != alpha_1) {
+        const auto palette = get_alpha_palette(alpha_0, alpha_1);
+        for (u32 i = 0; i < BLOCK_TEXELS; ++i) {
+            u64 best_index = 0;
+            i32 best_distance = std::numeric_limits<i32>::max();
+            for (u32 index = 0; index < palette.size(); ++index) {
+                const i32 distance = std::abs(i32{ block[i][3] } - i32{ palette[index] });
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best_index = index;
+                }
+            }
+            indices |= best_index << (i * 3);
+        }
+    }
+
+    out[0] = alpha_0; // NOLINT
+    out[1] = alpha_1; // NOLINT
+    for (u32 i = 0; i < 6; ++i) {
+        out[2 + i] = static_cast<u8>((indices >> (i * 8)) & 0xffU); // NOLINT
+    }
+}
+
+void
+decode_color_block(const u8* in, bool four_colors, Block& block)
+{
+    const u16 color_0 = read_u16(in);
+    const u16 color_1 = read_u16(in + 2); // NOLINT
+    const auto palette = get_color_palette(color_0, color_1, four_colors || color_0 > color_1);
+
+    for (u32 i = 0; i < BLOCK_TEXELS; ++i) {
+        const u32 index = (in[4 + i / 4] >> ((i % 4) * 2)) & 0x3U; // NOLINT
+        block[i] = palette[index];
+    }
+}
+
+void
+decode_alpha_block(const u8* in, Block& block)
+{
+    const auto palette = get_alpha_palette(in[0], in[1]); // NOLINT
+
+    u64 indices = 0;
+    for (u32 i = 0; i < 6; ++i) {
+        indices |= u64{ in[2 + i] } << (i * 8); // NOLINT
+    }
+
+    for (u32 i = 0; i < BLOCK_TEXELS; ++i) {
+        block[i][3] = palette[(indices >> (i * 3)) & 0x7U];
+    }
+}
+
+}
+
+namespace ascension::assets {
+
+Block_Compression
+choose_block_compression(const u8* pixels, u32 width, u32 height, u32 channels)
+{
+    if (channels == 3) {
+        return Block_Compression::BC1;
+    }
+    if (channels != 4) {
+        return Block_Compression::None;
+    }
+
+    const size_t pixel_count = size_t{ width } * height;
+    for (size_t i = 0; i < pixel_count; ++i) {
+        if (pixels[i * 4 + 3] != 255) { // NOLINT
+            return Block_Compression::BC3;
+        }
+    }
+    return Block_Compression::BC1;
+}
+
+u64
+get_block_compressed_size(Block_Compression compression, u32 width, u32 height)
+{
+    const u64 block_count = u64{ get_block_count(width) } * get_block_count(height);
+    switch (compression) {
+        case Block_Compression::BC1:
+            return block_count * BC1_BLOCK_BYTES;
+        case Block_Compression::BC3:
+            return block_count * BC3_BLOCK_BYTES;
+        case Block_Compression::None:
+            break;
+    }
+    return 0;
+}
+
+std::vector<u8>
+compress_blocks(Block_Compression compression, const u8* pixels, u32 width, u32 height, u32 channels)
+{
+    std::vector<u8> blocks(get_block_compressed_size(compression, width, height));
+    if (blocks.empty()) {
+        return blocks;
+    }
+
+    u8* out = blocks.data();
+    for (u32 block_y = 0; block_y < get_block_count(height); ++block_y) {
+        for (u32 block_x = 0; block_x < get_block_count(width); ++block_x) {
+            const auto block = load_block(pixels, width, height, channels, block_x, block_y);
+            // BC3 stores the alpha block ahead of the color block.
+            if (compression == Block_Compression::BC3) {
+                encode_alpha_block(block, out);
+                out += BC3_BLOCK_BYTES - BC1_BLOCK_BYTES; // NOLINT
+            }
+            encode_color_block(block, out);
+            out += BC1_BLOCK_BYTES; // NOLINT
+        }
+    }
+    return blocks;
+}
+
+std::vector<u8>
+decompress_blocks(Block_Compression compression, const u8* blocks, u32 width, u32 height)
+{
+    std::vector<u8> pixels(size_t{ width } * height * 4);
+    if (compression == Block_Compression::None) {
+        return pixels;
+    }
+
+    const u8* in = blocks;
+    for (u32 block_y = 0; block_y < get_block_count(height); ++block_y) {
+        for (u32 block_x = 0; block_x < get_block_count(width); ++block_x) {
+            Block block{};
+            if (compression == Block_Compression::BC3) {
+                // The color block of BC3 is always in four color mode, alpha comes from the alpha block.
+                decode_color_block(in + (BC3_BLOCK_BYTES - BC1_BLOCK_BYTES), true, block); // NOLINT
+                decode_alpha_block(in, block);
+                in += BC3_BLOCK_BYTES; // NOLINT
+            }
+            else {
+                decode_color_block(in, false, block);
+                in += BC1_BLOCK_BYTES; // NOLINT
+            }
+
+            for (u32 y = 0; y < BLOCK_SIZE && block_y * BLOCK_SIZE + y < height; ++y) {
+                for (u32 x = 0; x < BLOCK_SIZE && block_x * BLOCK_SIZE + x < width; ++x) {
+                    const size_t pixel = size_t{ block_y * BLOCK_SIZE + y } * width + block_x * BLOCK_SIZE + x;
+                    std::copy_n(block[y * BLOCK_SIZE + x].begin(), 4, pixels.begin() + static_cast<i64>(pixel * 4));
+                }
+            }
+        }
+    }
+    return pixels;
+}
+
+}
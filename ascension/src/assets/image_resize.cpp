@@ -0,0 +1,293 @@
+/**
+ * File: image_resize.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:55:16
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:49:57
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/image_resize.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ASCENSION_RESIZE_SSE2
+#endif
+
+namespace {
+
+using ascension::assets::Resize_Filter;
+
+constexpr f32 PI = 3.14159265358979f;
+constexpr f32 MAX_CHANNEL = 255.0f;
+constexpr u32 RGBA_CHANNELS = 4;
+constexpr u32 ALPHA_CHANNEL = 3;
+
+// The source texels contributing to each destination texel along one axis. Every destination texel has the same
+// number of taps, padded with zero weights, so the filter loops never branch on the count.
+struct Axis_Weights {
+    std::vector<u32> starts;
+    std::vector<f32> weights;
+    u32 taps{ 0 };
+};
+
+f32
+get_filter_radius(Resize_Filter filter)
+{
+    switch (filter) {
+        case Resize_Filter::Box:
+            return 0.5f;
+        case Resize_Filter::Bilinear:
+            return 1.0f;
+        case Resize_Filter::Lanczos3:
+            return 3.0f;
+    }
+    return 1.0f;
+}
+
+f32
+sinc(f32 x)
+{
+    if (x == 0.0f) {
+        return 1.0f;
+    }
+    x *= PI;
+    return std::sin(x) / x;
+}
+
+f32
+evaluate_filter(Resize_Filter filter, f32 x)
+{
+    const f32 radius = get_filter_radius(filter);
+    switch (filter) {
+        case Resize_Filter::Box:
+            return (x >= -radius && x < radius) ? 1.0f : 0.0f;
+        case Resize_Filter::Bilinear:
+            return std::max(radius - std::abs(x), 0.0f);
+        case Resize_Filter::Lanczos3:
+            return std::abs(x) < radius ? sinc(x) * sinc(x / radius) : 0.0f;
+    }
+    return 0.0f;
+}
+
+Axis_Weights
+compute_axis_weights(Resize_Filter filter, u32 source_length, u32 length)
+{
+    const f32 scale = static_cast<f32>(length) / static_cast<f32>(source_length);
+    const f32 filter_scale = std::max(1.0f / scale, 1.0f);
+    const f32 support = get_filter_radius(filter) * filter_scale;
+
+    Axis_Weights axis;
+    axis.taps = std::min(static_cast<u32>(std::ceil(support * 2.0f)) + 1, source_length);
+    axis.starts.resize(length);
+    axis.weights.assign(static_cast<size_t>(length) * axis.taps, 0.0f);
+
+    for (u32 i = 0; i < length; ++i) {
+        // Texel centres sit at +0.5, the source texels within support of the destination centre contribute.
+        const f32 center = (static_cast<f32>(i) + 0.5f) / scale;
+        const auto first = static_cast<i64>(std::ceil(center - support - 0.5f));
+        const auto start = static_cast<u32>(std::clamp<i64>(first, 0, source_length - axis.taps));
+        axis.starts[i] = start;
+
+        f32* const weights = &axis.weights[static_cast<size_t>(i) * axis.taps];
+        f32 total = 0.0f;
+        for (u32 tap = 0; tap < axis.taps; ++tap) {
+            const f32 offset = (static_cast<f32>(start + tap) + 0.5f - center) / filter_scale;
+            weights[tap] = evaluate_filter(filter, offset); // NOLINT
+            total += weights[tap];                           // NOLINT
+        }
+
+        // Texels past the edges are dropped, normalizing makes up their weight with the edge texels.
+        if (total != 0.0f) {
+            for (u32 tap = 0; tap < axis.taps; ++tap) {
+                weights[tap] /= total; // NOLINT
+            }
+        }
+        else {
+            const auto nearest = std::clamp<i64>(static_cast<i64>(center), start, start + axis.taps - 1);
+            weights[nearest - start] = 1.0f; // NOLINT
+        }
+    }
+
+    return axis;
+}
+
+// Convert a row to floats, premultiplying colour by alpha for 4 channel images.
+void
+load_row(const u8* pixels, u32 width, u32 channels, f32* row)
+{
+    const u32 count = width * channels;
+    for (u32 i = 0; i < count; ++i) {
+        row[i] = static_cast<f32>(pixels[i]); // NOLINT
+    }
+
+    if (channels == RGBA_CHANNELS) {
+        for (u32 i = 0; i < count; i += RGBA_CHANNELS) {
+            const f32 alpha = row[i + ALPHA_CHANNEL] / MAX_CHANNEL; // NOLINT
+            row[i] *= alpha;                                        // NOLINT
+            row[i + 1] *= alpha;                                    // NOLINT
+            row[i + 2] *= alpha;                                    // NOLINT
+        }
+    }
+}
+
+void
+filter_row(const Axis_Weights& axis, const f32* row, u32 width, u32 channels, f32* out)
+{
+    for (u32 x = 0; x < width; ++x) {
+        const f32* const weights = &axis.weights[static_cast<size_t>(x) * axis.taps];
+        const f32* const source = &row[static_cast<size_t>(axis.starts[x]) * channels]; // NOLINT
+        f32* const texel = &out[static_cast<size_t>(x) * channels];                      // NOLINT
+
+#ifdef ASCENSION_RESIZE_SSE2
+        if (channels == RGBA_CHANNELS) {
+            // A whole texel per vector.
+            __m128 sum = _mm_setzero_ps();
+            for (u32 tap = 0; tap < axis.taps; ++tap) {
+                const __m128 value = _mm_loadu_ps(&source[tap * RGBA_CHANNELS]);   // NOLINT
+                sum = _mm_add_ps(sum, _mm_mul_ps(value, _mm_set1_ps(weights[tap]))); // NOLINT
+            }
+            _mm_storeu_ps(texel, sum);
+            continue;
+        }
+#endif
+
+        for (u32 c = 0; c < channels; ++c) {
+            f32 sum = 0.0f;
+            for (u32 tap = 0; tap < axis.taps; ++tap) {
+                sum += source[tap * channels + c] * weights[tap]; // NOLINT
+            }
+            texel[c] = sum; // NOLINT
+        }
+    }
+}
+
+// out += rows[row] * weight, over whole rows so the rows are streamed through in order.
+void
+accumulate_row(const f32* row, f32 weight, u32 count, f32* out)
+{
+    u32 i = 0;
+#ifdef ASCENSION_RESIZE_SSE2
+    const __m128 weight_4 = _mm_set1_ps(weight);
+    for (; i + 4 <= count; i += 4) {
+        const __m128 sum = _mm_add_ps(_mm_loadu_ps(&out[i]), _mm_mul_ps(_mm_loadu_ps(&row[i]), weight_4)); // NOLINT
+        _mm_storeu_ps(&out[i], sum);                                                                      // NOLINT
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] += row[i] * weight; // NOLINT
+    }
+}
+
+// Convert a filtered row back to bytes, undoing the premultiplication of 4 channel images.
+void
+store_row(f32* row, u32 width, u32 channels, u8* pixels)
+{
+    const u32 count = width * channels;
+    if (channels == RGBA_CHANNELS) {
+        for (u32 i = 0; i < count; i += RGBA_CHANNELS) {
+            const f32 alpha = row[i + ALPHA_CHANNEL];                     // NOLINT
+            const f32 unpremultiply = alpha > 0.0f ? MAX_CHANNEL / alpha : 0.0f;
+            row[i] *= unpremultiply;                                      // NOLINT
+            row[i + 1] *= unpremultiply;                                  // NOLINT
+            row[i + 2] *= unpremultiply;                                  // NOLINT
+        }
+    }
+
+    u32 i = 0;
+#ifdef ASCENSION_RESIZE_SSE2
+    // Lanczos overshoots around hard edges, values are clamped before rounding & packing down to bytes.
+    // Rounded half up by adding a half & truncating, like the scalar tail, the SSE rounding mode rounds half to even.
+    const __m128 min = _mm_setzero_ps();
+    const __m128 max = _mm_set1_ps(MAX_CHANNEL);
+    const __m128 half = _mm_set1_ps(0.5f);
+    for (; i + 4 <= count; i += 4) {
+        const __m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&row[i]), min), max); // NOLINT
+        const __m128i integers = _mm_cvttps_epi32(_mm_add_ps(value, half));
+        const __m128i shorts = _mm_packs_epi32(integers, integers);
+        const auto bytes = static_cast<u32>(_mm_cvtsi128_si32(_mm_packus_epi16(shorts, shorts)));
+        std::memcpy(&pixels[i], &bytes, sizeof(bytes)); // NOLINT
+    }
+#endif
+    for (; i < count; ++i) {
+        pixels[i] = static_cast<u8>(std::clamp(row[i], 0.0f, MAX_CHANNEL) + 0.5f); // NOLINT
+    }
+}
+
+}
+
+namespace ascension::assets {
+
+u32
+get_scaled_length(u32 length, f32 scale)
+{
+    return std::max(static_cast<u32>(std::lround(static_cast<f32>(length) * scale)), 1U);
+}
+
+std::vector<u8>
+resize_image(
+    const u8* pixels,
+    u32 width,
+    u32 height,
+    u32 channels,
+    u32 new_width,
+    u32 new_height,
+    Resize_Filter filter
+)
+{
+    assert(channels >= 1 && channels <= RGBA_CHANNELS);
+    if (width == 0 || height == 0 || new_width == 0 || new_height == 0) {
+        return {};
+    }
+
+    const auto horizontal = compute_axis_weights(filter, width, new_width);
+    const auto vertical = compute_axis_weights(filter, height, new_height);
+
+    // Horizontal pass first, each source row is filtered down to the new width.
+    const size_t row_size = static_cast<size_t>(new_width) * channels;
+    std::vector<f32> source_row(static_cast<size_t>(width) * channels);
+    std::vector<f32> rows(row_size * height);
+    for (u32 y = 0; y < height; ++y) {
+        load_row(&pixels[static_cast<size_t>(y) * width * channels], width, channels, source_row.data()); // NOLINT
+        filter_row(horizontal, source_row.data(), new_width, channels, &rows[y * row_size]);
+    }
+
+    // Vertical pass, each destination row is a weighted sum of whole filtered rows.
+    std::vector<u8> resized(row_size * new_height);
+    std::vector<f32> row(row_size);
+    for (u32 y = 0; y < new_height; ++y) {
+        std::fill(row.begin(), row.end(), 0.0f);
+        for (u32 tap = 0; tap < vertical.taps; ++tap) {
+            const f32 weight = vertical.weights[static_cast<size_t>(y) * vertical.taps + tap];
+            if (weight != 0.0f) {
+                const size_t source_y = vertical.starts[y] + tap;
+                accumulate_row(&rows[source_y * row_size], weight, static_cast<u32>(row_size), row.data());
+            }
+        }
+        store_row(row.data(), new_width, channels, &resized[y * row_size]);
+    }
+
+    return resized;
+}
+
+}
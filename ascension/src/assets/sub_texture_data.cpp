@@ -0,0 +1,56 @@
+/**
+ * File: sub_texture_data.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:56:47
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:57:31
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/sub_texture_data.hpp"
+
+#include <cstring>
+
+namespace ascension::assets {
+
+bool
+is_binary_sub_texture_data(const u8* data, u64 size, const Sub_Texture_Data_Magic& magic)
+{
+    return size >= SUB_TEXTURE_DATA_HEADER_SIZE && std::memcmp(data, magic.data(), magic.size()) == 0;
+}
+
+bool
+read_sub_texture_data_header(const u8* data, u64 size, u32 version, u64 record_size, u32& count)
+{
+    std::array<u32, 2> header{};
+    std::memcpy(header.data(), data + sizeof(Sub_Texture_Data_Magic), sizeof(header)); // NOLINT
+    count = header[1];
+    return header[0] == version && size - SUB_TEXTURE_DATA_HEADER_SIZE >= u64{ count } * record_size;
+}
+
+std::vector<u8>
+make_sub_texture_data(const Sub_Texture_Data_Magic& magic, u32 version, u32 count, u64 record_size)
+{
+    const std::array<u32, 2> header = { version, count };
+    std::vector<u8> data(SUB_TEXTURE_DATA_HEADER_SIZE + count * record_size);
+    std::memcpy(data.data(), magic.data(), magic.size());
+    std::memcpy(data.data() + magic.size(), header.data(), sizeof(header)); // NOLINT
+    return data;
+}
+
+}
@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-08 15:43:49
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-07-18 20:54:40
+ * Last Modified: 2026-10-18 16:22:43
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -26,6 +26,7 @@
 
 #include <SDL.h>
 
+#include "yuki/debug/flight_recorder.hpp"
 #include "yuki/debug/instrumentor.hpp"
 #include "yuki/platform/platform.hpp"
 
@@ -37,6 +38,8 @@ constexpr f64 millisecond_per_second = 1000.0;
 constexpr i32 updates_per_second = 60;
 constexpr f64 skip_update_ms = millisecond_per_second / updates_per_second;
 constexpr i32 max_skipped_frames = 5;
+// The full per-scope stats table is only logged every few seconds, the fps line is logged every second.
+constexpr i32 profile_stats_interval_seconds = 10;
 
 }
 
@@ -78,6 +81,7 @@ Application::run()
 
     i64 update_frames = 0;
     i64 render_frames = 0;
+    i32 stats_seconds = 0;
     f64 elapsed_time = 0.0;
 
     while (!m_should_quit) {
@@ -139,12 +143,26 @@ Application::run()
 
         ++render_frames;
 
+        PROFILE_FRAME_MARK();
+        FLIGHT_RECORDER_FRAME();
+
         elapsed_time += (yuki::Platform::get_platform_time(platform_state) - start_time);
         if (elapsed_time >= millisecond_per_second) {
-            core::log::debug("Update fps: {}  Render fps: {}", update_frames, render_frames);
+            core::log::debug(
+                "Update fps: {}  Render fps: {}  Frame time: {:.2f}ms",
+                update_frames,
+                render_frames,
+                elapsed_time / static_cast<f64>(render_frames)
+            );
             elapsed_time = 0;
             update_frames = 0;
             render_frames = 0;
+
+            // Per-scope timings over the rolling stats window, empty unless profiling is enabled.
+            if (++stats_seconds >= profile_stats_interval_seconds) {
+                PROFILE_LOG_STATS();
+                stats_seconds = 0;
+            }
         }
     }
 
@@ -167,6 +185,7 @@ void
 Application::update(f64 delta_time)
 {
     PROFILE_FUNCTION();
+    FLIGHT_RECORDER_SCOPE("Application::update");
     m_input_manager.clear_state();
     on_update(delta_time);
 }
@@ -175,6 +194,7 @@ void
 Application::render(f32 interpolation)
 {
     PROFILE_FUNCTION();
+    FLIGHT_RECORDER_SCOPE("Application::render");
     assert(m_window != nullptr);
 
     m_window->clear();
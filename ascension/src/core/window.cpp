@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-18 18:53:27
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-07-18 21:19:05
+ * Last Modified: 2026-10-18 14:53:53
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -48,6 +48,8 @@ Window::Window()
 
 Window::~Window()
 {
+    graphics::Renderer_2D::shutdown();
+
     if (m_internal_context != nullptr) {
         SDL_GL_DeleteContext(m_internal_context);
         m_internal_context = nullptr;
@@ -100,6 +102,7 @@ void
 Window::clear() // NOLINT
 {
     PROFILE_FUNCTION();
+    graphics::Renderer_2D::begin_frame();
     graphics::Renderer_2D::clear();
 }
 
@@ -0,0 +1,124 @@
+/**
+ * File: animation.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:13:49
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:18:17
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "graphics/animation.hpp"
+
+#include "core/log.hpp"
+
+namespace {
+
+// Frames need a length for an animation to advance through them, shorter frames are lengthened to this.
+constexpr f32 MIN_FRAME_DURATION = 0.001f;
+
+const ascension::graphics::Sub_Texture_Rect EMPTY_RECT{};
+
+}
+
+namespace ascension::graphics {
+
+void
+Animation::create(const std::shared_ptr<Texture_Atlas>& atlas, std::vector<Animation_Frame> frames)
+{
+    if (atlas == nullptr) {
+        core::log::error("Animation::create() attempting to create an animation from a null texture atlas");
+        return;
+    }
+
+    m_durations.clear();
+    m_rects.clear();
+    m_durations.reserve(frames.size());
+    m_rects.reserve(frames.size());
+    m_duration = 0.0f;
+
+    for (auto& frame : frames) {
+        if (frame.duration < MIN_FRAME_DURATION) {
+            core::log::warn("Animation::create() frame {} has no duration", m_rects.size());
+            frame.duration = MIN_FRAME_DURATION;
+        }
+
+        const auto* rect = atlas->find_sub_texture(frame.sub_texture_id);
+        if (rect == nullptr) {
+            core::log::warn("Animation::create() frame {} isn't in the texture atlas", m_rects.size());
+        }
+
+        m_durations.push_back(frame.duration);
+        m_rects.push_back(rect != nullptr ? *rect : EMPTY_RECT);
+        m_duration += frame.duration;
+    }
+
+    m_atlas = atlas;
+    m_frames = std::move(frames);
+}
+
+const Sub_Texture_Rect&
+Animation::get_frame(u32 index) const
+{
+    if (m_rects.empty()) {
+        return EMPTY_RECT;
+    }
+
+    return m_rects[index % m_rects.size()];
+}
+
+f32
+Animation::get_frame_duration(u32 index) const
+{
+    if (m_durations.empty()) {
+        return 0.0f;
+    }
+
+    return m_durations[index % m_durations.size()];
+}
+
+u32
+Animation::frame_count() const
+{
+    return static_cast<u32>(m_rects.size());
+}
+
+f32
+Animation::duration() const
+{
+    return m_duration;
+}
+
+const std::vector<Animation_Frame>&
+Animation::frames() const
+{
+    return m_frames;
+}
+
+const std::shared_ptr<Texture_Atlas>&
+Animation::get_atlas() const
+{
+    return m_atlas;
+}
+
+const std::shared_ptr<Texture_2D>&
+Animation::get_texture() const
+{
+    return m_atlas->get_texture();
+}
+
+}
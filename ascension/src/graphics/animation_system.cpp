@@ -0,0 +1,224 @@
+/**
+ * File: animation_system.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:14:34
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:18:17
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "graphics/animation_system.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "yuki/debug/instrumentor.hpp"
+
+#include "core/log.hpp"
+#include "graphics/animation.hpp"
+#include "graphics/sprite_batch.hpp"
+
+namespace ascension::graphics {
+
+namespace {
+
+template<typename T>
+void
+swap_remove(std::vector<T>& values, size_t index)
+{
+    values[index] = values.back();
+    values.pop_back();
+}
+
+}
+
+Animation_Instance
+Animation_System::play(const std::shared_ptr<Animation>& animation, const v2f& position, bool loop, f32 speed)
+{
+    if (animation == nullptr || animation->frame_count() == 0) {
+        core::log::error("Animation_System::play() attempting to play an animation without frames");
+        return {};
+    }
+
+    auto animation_index = static_cast<u32>(
+        std::distance(m_animations.begin(), std::find(m_animations.begin(), m_animations.end(), animation))
+    );
+    if (animation_index == m_animations.size()) {
+        m_animations.push_back(animation);
+    }
+
+    u32 slot_index = 0;
+    if (!m_free_slots.empty()) {
+        slot_index = m_free_slots.back();
+        m_free_slots.pop_back();
+    }
+    else {
+        slot_index = static_cast<u32>(m_slots.size());
+        m_slots.push_back({ 0, 0 });
+    }
+
+    auto& slot = m_slots[slot_index];
+    slot.dense_index = static_cast<u32>(m_frames.size());
+    ++slot.generation;
+
+    m_animation_indices.push_back(animation_index);
+    m_frames.push_back(0);
+    m_times.push_back(0.0f);
+    m_speeds.push_back(speed);
+    m_positions.push_back(position);
+    m_flags.push_back(loop ? FLAG_LOOP : 0);
+    m_slot_indices.push_back(slot_index);
+
+    return { slot_index, slot.generation };
+}
+
+void
+Animation_System::stop(Animation_Instance instance)
+{
+    const auto* dense_index = find(instance);
+    if (dense_index == nullptr) {
+        return;
+    }
+
+    // The last instance takes the stopped one's place, so its slot has to follow it.
+    const u32 index = *dense_index;
+    m_slots[m_slot_indices.back()].dense_index = index;
+
+    swap_remove(m_animation_indices, index);
+    swap_remove(m_frames, index);
+    swap_remove(m_times, index);
+    swap_remove(m_speeds, index);
+    swap_remove(m_positions, index);
+    swap_remove(m_flags, index);
+    swap_remove(m_slot_indices, index);
+
+    // The generation changes as the slot is freed, so stale instances don't resolve before the slot is reused.
+    ++m_slots[instance.index].generation;
+    m_free_slots.push_back(instance.index);
+}
+
+void
+Animation_System::clear()
+{
+    for (const auto slot_index : m_slot_indices) {
+        ++m_slots[slot_index].generation;
+        m_free_slots.push_back(slot_index);
+    }
+
+    m_animations.clear();
+    m_animation_indices.clear();
+    m_frames.clear();
+    m_times.clear();
+    m_speeds.clear();
+    m_positions.clear();
+    m_flags.clear();
+    m_slot_indices.clear();
+}
+
+void
+Animation_System::set_position(Animation_Instance instance, const v2f& position)
+{
+    if (const auto* dense_index = find(instance)) {
+        m_positions[*dense_index] = position;
+    }
+}
+
+void
+Animation_System::set_speed(Animation_Instance instance, f32 speed)
+{
+    if (const auto* dense_index = find(instance)) {
+        m_speeds[*dense_index] = speed;
+    }
+}
+
+bool
+Animation_System::is_finished(Animation_Instance instance) const
+{
+    const auto* dense_index = find(instance);
+    return dense_index == nullptr || (m_flags[*dense_index] & FLAG_FINISHED) != 0;
+}
+
+void
+Animation_System::update(f64 delta_time)
+{
+    PROFILE_FUNCTION();
+
+    const auto delta = static_cast<f32>(delta_time);
+    for (size_t i = 0; i < m_times.size(); ++i) {
+        if ((m_flags[i] & FLAG_FINISHED) != 0) {
+            continue;
+        }
+
+        const Animation& animation = *m_animations[m_animation_indices[i]];
+        f32 time = m_times[i] + delta * m_speeds[i];
+        u32 frame = m_frames[i];
+
+        // Whole loops are skipped in one go, so a long frame time can't step through every frame many times over.
+        if ((m_flags[i] & FLAG_LOOP) != 0 && time >= animation.duration()) {
+            time = std::fmod(time, animation.duration());
+        }
+
+        for (f32 duration = animation.get_frame_duration(frame); time >= duration;
+             duration = animation.get_frame_duration(frame)) {
+            if (frame + 1 < animation.frame_count()) {
+                ++frame;
+            }
+            else if ((m_flags[i] & FLAG_LOOP) != 0) {
+                frame = 0;
+            }
+            else {
+                m_flags[i] |= FLAG_FINISHED;
+                time = duration;
+                break;
+            }
+            time -= duration;
+        }
+
+        m_times[i] = time;
+        m_frames[i] = frame;
+    }
+}
+
+void
+Animation_System::draw(Sprite_Batch& sprite_batch) const
+{
+    PROFILE_FUNCTION();
+
+    for (size_t i = 0; i < m_frames.size(); ++i) {
+        const Animation& animation = *m_animations[m_animation_indices[i]];
+        sprite_batch.draw_texture(animation.get_texture(), animation.get_frame(m_frames[i]), m_positions[i]);
+    }
+}
+
+u32
+Animation_System::size() const
+{
+    return static_cast<u32>(m_frames.size());
+}
+
+const u32*
+Animation_System::find(Animation_Instance instance) const
+{
+    if (!instance.is_valid() || instance.index >= m_slots.size() || m_slots[instance.index].generation != instance.generation) {
+        return nullptr;
+    }
+
+    return &m_slots[instance.index].dense_index;
+}
+
+}
@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-12 15:45:35
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-05-19 20:25:03
+ * Last Modified: 2026-10-18 14:12:34
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -27,6 +27,7 @@
 #include <GL/glew.h>
 
 #include "core/log.hpp"
+#include "graphics/renderer_2d.hpp"
 
 namespace {
 
@@ -123,6 +124,7 @@ Buffer_Object::buffer_data(u32 size, const void* data)
 {
     bind();
     glBufferSubData(m_buffer_type, 0, size, data);
+    Renderer_2D::record_upload(size);
 }
 
 void
@@ -130,6 +132,7 @@ Buffer_Object::buffer_sub_data(i32 offset, u32 size, const void* data)
 {
     bind();
     glBufferSubData(m_buffer_type, offset, size, data);
+    Renderer_2D::record_upload(size);
 }
 
 bool
@@ -173,6 +176,7 @@ Vertex_Buffer_Object::draw_arrays(i32 start_index, i32 count, Draw_Mode mode)
     }
 
     glDrawArrays(gl_draw_mode(mode), start_index, count);
+    Renderer_2D::record_draw_call();
 }
 
 // Index_Buffer_Object
@@ -190,6 +194,7 @@ Index_Buffer_Object::draw_elements(i32 count, Draw_Mode mode)
     }
 
     glDrawElements(gl_draw_mode(mode), count, GL_UNSIGNED_INT, nullptr);
+    Renderer_2D::record_draw_call();
 }
 
 }
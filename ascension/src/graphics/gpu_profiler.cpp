@@ -0,0 +1,198 @@
+/**
+ * File: gpu_profiler.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:09:32
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 14:10:29
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "graphics/gpu_profiler.hpp"
+
+#include <chrono>
+
+#include <GL/glew.h>
+
+#include "yuki/debug/instrumentor.hpp"
+
+#include "core/log.hpp"
+
+namespace ascension::graphics {
+
+// Clocks drift apart slowly, so re-sync the GPU to CPU clock offset every few seconds.
+static constexpr u32 CALIBRATION_INTERVAL_FRAMES = 600;
+
+bool Gpu_Profiler::s_initialized = false;
+std::vector<u32> Gpu_Profiler::s_queries;
+std::vector<Gpu_Profiler::Frame> Gpu_Profiler::s_frames;
+u32 Gpu_Profiler::s_frame_index = 0;
+u32 Gpu_Profiler::s_frames_since_calibration = 0;
+i64 Gpu_Profiler::s_clock_offset_ns = 0;
+u64 Gpu_Profiler::s_dropped_scopes = 0;
+
+bool
+Gpu_Profiler::initialize(u32 frame_latency, u32 max_scopes_per_frame)
+{
+    if (s_initialized) {
+        core::log::error("Attempting to initialize static Gpu_Profiler more than once");
+        return true;
+    }
+
+    if (!GLEW_ARB_timer_query && !GLEW_VERSION_3_3) {
+        core::log::notice("GPU profiling disabled, GL_ARB_timer_query is not supported");
+        return false;
+    }
+
+    // One slot per frame in flight plus the frame being recorded.
+    const u32 frame_count = frame_latency + 1;
+    s_queries.resize(static_cast<size_t>(frame_count) * max_scopes_per_frame * 2);
+    glGenQueries(static_cast<i32>(s_queries.size()), s_queries.data());
+
+    s_frames.resize(frame_count);
+    size_t query = 0;
+    for (auto& frame : s_frames) {
+        frame.scopes.resize(max_scopes_per_frame);
+        for (auto& scope : frame.scopes) {
+            scope.begin_query = s_queries.at(query++);
+            scope.end_query = s_queries.at(query++);
+        }
+    }
+
+    s_frame_index = 0;
+    s_dropped_scopes = 0;
+    calibrate();
+
+    s_initialized = true;
+    return true;
+}
+
+void
+Gpu_Profiler::shutdown()
+{
+    if (!s_initialized) {
+        return;
+    }
+
+    glDeleteQueries(static_cast<i32>(s_queries.size()), s_queries.data());
+    s_queries.clear();
+    s_frames.clear();
+
+    s_initialized = false;
+}
+
+void
+Gpu_Profiler::begin_frame()
+{
+    if (!s_initialized) {
+        return;
+    }
+
+    s_frame_index = (s_frame_index + 1) % static_cast<u32>(s_frames.size());
+    collect_frame(s_frames.at(s_frame_index));
+
+    if (++s_frames_since_calibration >= CALIBRATION_INTERVAL_FRAMES) {
+        calibrate();
+    }
+}
+
+u32
+Gpu_Profiler::begin_scope(const char* name)
+{
+    if (!s_initialized || !yuki::debug::Instrumentor::get().is_session_active()) {
+        return INVALID_SCOPE;
+    }
+
+    auto& frame = s_frames.at(s_frame_index);
+    if (frame.scope_count >= frame.scopes.size()) {
+        ++s_dropped_scopes;
+        return INVALID_SCOPE;
+    }
+
+    auto& scope = frame.scopes.at(frame.scope_count);
+    scope.name = name;
+    glQueryCounter(scope.begin_query, GL_TIMESTAMP);
+
+    return frame.scope_count++;
+}
+
+void
+Gpu_Profiler::end_scope(u32 scope)
+{
+    if (scope == INVALID_SCOPE) {
+        return;
+    }
+
+    glQueryCounter(s_frames.at(s_frame_index).scopes.at(scope).end_query, GL_TIMESTAMP);
+}
+
+bool
+Gpu_Profiler::is_initialized()
+{
+    return s_initialized;
+}
+
+u64
+Gpu_Profiler::dropped_scope_count()
+{
+    return s_dropped_scopes;
+}
+
+void
+Gpu_Profiler::collect_frame(Frame& frame)
+{
+    for (u32 i = 0; i < frame.scope_count; ++i) {
+        const auto& scope = frame.scopes.at(i);
+
+        // Never stall on the GPU, anything still in flight this late is dropped instead.
+        i32 available = 0;
+        glGetQueryObjectiv(scope.end_query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == 0) {
+            s_dropped_scopes += frame.scope_count - i;
+            break;
+        }
+
+        u64 begin_ns = 0;
+        u64 end_ns = 0;
+        glGetQueryObjectui64v(scope.begin_query, GL_QUERY_RESULT, &begin_ns);
+        glGetQueryObjectui64v(scope.end_query, GL_QUERY_RESULT, &end_ns);
+
+        yuki::debug::Instrumentor::get().record_event(
+            scope.name,
+            static_cast<i64>(begin_ns) + s_clock_offset_ns,
+            static_cast<i64>(end_ns - begin_ns),
+            yuki::debug::Profile_Track::GPU
+        );
+    }
+
+    frame.scope_count = 0;
+}
+
+void
+Gpu_Profiler::calibrate()
+{
+    // GL_TIMESTAMP is the GPU time once all prior commands reached the GPU, so sample the CPU clock straight after.
+    i64 gpu_ns = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpu_ns);
+    const i64 cpu_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    s_clock_offset_ns = cpu_ns - gpu_ns;
+    s_frames_since_calibration = 0;
+}
+
+}
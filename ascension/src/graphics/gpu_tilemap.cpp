@@ -0,0 +1,271 @@
+/**
+ * File: gpu_tilemap.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:22:11
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:53:39
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "graphics/gpu_tilemap.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include "yuki/debug/instrumentor.hpp"
+
+#include "core/log.hpp"
+#include "graphics/buffer_object.hpp"
+#include "graphics/gpu_profiler.hpp"
+#include "graphics/renderer_2d.hpp"
+#include "graphics/sampler.hpp"
+#include "graphics/shader.hpp"
+#include "graphics/texture_2d.hpp"
+#include "graphics/texture_atlas.hpp"
+#include "graphics/vertex_array_object.hpp"
+
+namespace ascension::graphics {
+
+// Texture units the shader reads from, the atlas stays on 0 as it is for sprite batches.
+static constexpr u32 ATLAS_UNIT = 0;
+static constexpr u32 TILE_UNIT = 1;
+static constexpr u32 TILE_RECT_UNIT = 2;
+// Tile rects are wrapped into rows so large atlases stay under the maximum texture width, matches the shader.
+static constexpr u32 TILE_RECTS_PER_ROW = 256;
+// The index of empty tiles in the tile texture, matches the shader.
+static constexpr u16 EMPTY_TILE_INDEX = 0xFFFF;
+
+Gpu_Tilemap::Gpu_Tilemap()
+  : m_width(0)
+  , m_height(0)
+  , m_tile_size(0)
+  , m_position(0.0f)
+  , m_tile_rect_count(0)
+  , m_atlas_version(0)
+{
+}
+
+Gpu_Tilemap::~Gpu_Tilemap() = default;
+
+void
+Gpu_Tilemap::create(
+    u32 width,
+    u32 height,
+    const v2u& tile_size,
+    const std::shared_ptr<Texture_Atlas>& atlas,
+    const std::shared_ptr<Shader>& shader
+)
+{
+    if (atlas == nullptr || shader == nullptr) {
+        core::log::error("Gpu_Tilemap::create() attempting to create a tilemap without a texture atlas or shader");
+        return;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_tile_size = tile_size;
+    m_atlas = atlas;
+    m_shader = shader;
+    m_tiles.assign(static_cast<size_t>(width) * height, EMPTY_TILE_INDEX);
+    m_tile_ids.clear();
+    m_tile_indices.clear();
+
+    if (m_tile_texture == nullptr) {
+        m_tile_texture = std::make_unique<Texture_2D>();
+    }
+    m_tile_texture->create(width, height, reinterpret_cast<const u8*>(m_tiles.data()), Texture_2D::Format::R16UI);
+
+    update_tile_rects();
+
+    if (m_vao == nullptr) {
+        // Two triangles covering the screen in clip space, the vertex shader maps them back into the world.
+        static constexpr std::array<f32, 12> vertices{ -1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f,
+                                                       1.0f,  1.0f,  1.0f,  -1.0f, -1.0f, -1.0f };
+
+        m_vao = std::make_unique<Vertex_Array_Object>();
+        m_vao->create(true);
+
+        m_vbo = std::make_shared<Vertex_Buffer_Object>();
+        m_vbo->create(static_cast<u32>(sizeof(vertices)), vertices.data());
+        m_vbo->set_layout({ { Shader_Data_Type::Float, 2, false } });
+        m_vao->add_vertex_buffer(m_vbo);
+        m_vao->unbind();
+    }
+}
+
+void
+Gpu_Tilemap::set_tile(u32 x, u32 y, Sub_Texture_Id tile)
+{
+    if (x >= m_width || y >= m_height) {
+        core::log::warn("Gpu_Tilemap::set_tile() tile {}, {} is outside the {}x{} map", x, y, m_width, m_height);
+        return;
+    }
+
+    const u16 index = get_tile_index(tile);
+    auto& current = m_tiles[static_cast<size_t>(y) * m_width + x];
+    if (current != index) {
+        current = index;
+        m_tile_texture->update(x, y, 1, 1, reinterpret_cast<const u8*>(&index));
+        Renderer_2D::record_upload(sizeof(u16));
+    }
+}
+
+void
+Gpu_Tilemap::set_tiles(u32 x, u32 y, u32 width, u32 height, const Sub_Texture_Id* tiles)
+{
+    if (tiles == nullptr || x + width > m_width || y + height > m_height) {
+        core::log::warn(
+            "Gpu_Tilemap::set_tiles() tiles {}, {} {}x{} are outside the {}x{} map", x, y, width, height, m_width, m_height
+        );
+        return;
+    }
+
+    m_upload_tiles.resize(static_cast<size_t>(width) * height);
+    for (size_t i = 0; i < m_upload_tiles.size(); ++i) {
+        m_upload_tiles[i] = get_tile_index(tiles[i]); // NOLINT
+    }
+
+    for (u32 row = 0; row < height; ++row) {
+        std::copy_n(
+            &m_upload_tiles[static_cast<size_t>(row) * width],
+            width,
+            &m_tiles[static_cast<size_t>(y + row) * m_width + x]
+        );
+    }
+
+    m_tile_texture->update(x, y, width, height, reinterpret_cast<const u8*>(m_upload_tiles.data()));
+    Renderer_2D::record_upload(u64{ width } * height * sizeof(u16));
+}
+
+Sub_Texture_Id
+Gpu_Tilemap::get_tile(u32 x, u32 y) const
+{
+    if (x >= m_width || y >= m_height) {
+        return EMPTY_TILE;
+    }
+
+    const u16 index = m_tiles[static_cast<size_t>(y) * m_width + x];
+    return index != EMPTY_TILE_INDEX ? m_tile_ids[index] : EMPTY_TILE;
+}
+
+void
+Gpu_Tilemap::set_position(const v2f& position)
+{
+    m_position = position;
+}
+
+u16
+Gpu_Tilemap::get_tile_index(Sub_Texture_Id tile)
+{
+    if (tile == EMPTY_TILE) {
+        return EMPTY_TILE_INDEX;
+    }
+
+    const auto it = m_tile_indices.find(tile);
+    if (it != m_tile_indices.end()) {
+        return it->second;
+    }
+
+    if (m_tile_ids.size() >= EMPTY_TILE_INDEX) {
+        core::log::warn("Gpu_Tilemap::set_tile() more than {} different tiles, {:016x} is left empty", EMPTY_TILE_INDEX, tile);
+        return EMPTY_TILE_INDEX;
+    }
+
+    const auto index = static_cast<u16>(m_tile_ids.size());
+    m_tile_ids.push_back(tile);
+    m_tile_indices.emplace(tile, index);
+    return index;
+}
+
+void
+Gpu_Tilemap::update_tile_rects()
+{
+    m_tile_rect_count = static_cast<u32>(m_tile_ids.size());
+    m_atlas_version = m_atlas->version();
+    const u32 rect_width = std::clamp(m_tile_rect_count, 1U, TILE_RECTS_PER_ROW);
+    const u32 rect_height = std::max((m_tile_rect_count + TILE_RECTS_PER_ROW - 1) / TILE_RECTS_PER_ROW, 1U);
+
+    // Ids missing from the atlas keep an empty rect, the shader leaves them undrawn.
+    std::vector<v4f> rects(static_cast<size_t>(rect_width) * rect_height, v4f{ 0.0f });
+    for (u32 i = 0; i < m_tile_rect_count; ++i) {
+        if (const auto* rect = m_atlas->find_sub_texture(m_tile_ids[i])) {
+            rects[i] = rect->texture_coords;
+        }
+    }
+
+    if (m_tile_rect_texture == nullptr) {
+        m_tile_rect_texture = std::make_unique<Texture_2D>();
+    }
+    m_tile_rect_texture->create(
+        rect_width, rect_height, reinterpret_cast<const u8*>(rects.data()), Texture_2D::Format::RGBA32F
+    );
+}
+
+void
+Gpu_Tilemap::draw(const m4& projection_view)
+{
+    PROFILE_FUNCTION();
+    PROFILE_GPU_SCOPE("Gpu_Tilemap::draw");
+
+    if (m_vao == nullptr || m_width == 0 || m_height == 0) {
+        return;
+    }
+
+    if (m_tile_rect_count != m_tile_ids.size() || m_atlas_version != m_atlas->version()) {
+        update_tile_rects();
+    }
+
+    m_shader->bind();
+    m_shader->set_mat4f("m_inverse_projection_view", glm::inverse(projection_view));
+    m_shader->set_vec2f("u_map_position", m_position);
+    m_shader->set_vec2f("u_tile_size", v2f{ m_tile_size });
+    m_shader->set_vec2i("u_map_size", v2i{ static_cast<i32>(m_width), static_cast<i32>(m_height) });
+    m_shader->set_int("u_tile_count", static_cast<i32>(m_tile_rect_count));
+    m_shader->set_int("u_texture", static_cast<i32>(ATLAS_UNIT));
+    m_shader->set_int("u_tiles", static_cast<i32>(TILE_UNIT));
+    m_shader->set_int("u_tile_rects", static_cast<i32>(TILE_RECT_UNIT));
+
+    m_atlas->get_texture()->bind(ATLAS_UNIT);
+    Renderer_2D::get_default_sampler(*m_atlas->get_texture())->bind(ATLAS_UNIT);
+    // Integer textures are only complete with nearest filtering, the rects are fetched exactly either way.
+    m_tile_texture->bind(TILE_UNIT);
+    Renderer_2D::get_sampler(Sampler_Filter::NEAREST)->bind(TILE_UNIT);
+    m_tile_rect_texture->bind(TILE_RECT_UNIT);
+    Renderer_2D::get_sampler(Sampler_Filter::NEAREST)->bind(TILE_RECT_UNIT);
+
+    m_vao->bind();
+    m_vbo->draw_arrays(0, 6, Draw_Mode::Triangles);
+    m_vao->unbind();
+
+    Sampler::unbind(TILE_UNIT);
+    Sampler::unbind(TILE_RECT_UNIT);
+}
+
+u32
+Gpu_Tilemap::width() const
+{
+    return m_width;
+}
+
+u32
+Gpu_Tilemap::height() const
+{
+    return m_height;
+}
+
+}
@@ -0,0 +1,424 @@
+/**
+ * File: particle_emitter.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:26:26
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:50:56
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "graphics/particle_emitter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <future>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ASCENSION_PARTICLES_SSE2
+#endif
+
+#include "yuki/debug/instrumentor.hpp"
+#include "yuki/thread_pool.hpp"
+
+#include "core/log.hpp"
+#include "graphics/gpu_profiler.hpp"
+#include "graphics/sprite_batch.hpp"
+#include "graphics/texture_2d.hpp"
+
+namespace {
+
+constexpr u32 QUAD_POSITION_COUNT = 8;
+constexpr u32 QUAD_VERTEX_COUNT = 4;
+constexpr f32 MAX_CHANNEL = 255.0f;
+// Short enough to be gone the next update without dividing by zero.
+constexpr f32 MIN_LIFETIME = 0.001f;
+// Smaller pools aren't worth the cost of handing work to other threads.
+constexpr u32 MIN_PARTICLES_PER_JOB = 8192;
+
+// Colour components scaled to bytes, clamped so they can't overflow into the next channel when packed.
+std::array<f32, 4>
+get_color_channels(const v4f& color)
+{
+    return { std::clamp(color.r, 0.0f, 1.0f) * MAX_CHANNEL,
+             std::clamp(color.g, 0.0f, 1.0f) * MAX_CHANNEL,
+             std::clamp(color.b, 0.0f, 1.0f) * MAX_CHANNEL,
+             std::clamp(color.a, 0.0f, 1.0f) * MAX_CHANNEL };
+}
+
+// Run job over [0, count) in ranges, split between the thread pool & the calling thread when there's enough work.
+template<typename Job>
+void
+run_jobs(u32 count, yuki::Thread_Pool* thread_pool, const Job& job)
+{
+    if (thread_pool == nullptr || count < MIN_PARTICLES_PER_JOB * 2) {
+        job(0, count);
+        return;
+    }
+
+    // Ranges are whole vectors so only the last one has a scalar tail.
+    const u32 job_count = std::min(thread_pool->thread_count() + 1, count / MIN_PARTICLES_PER_JOB);
+    const u32 job_size = (count / job_count + 3) & ~3U;
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(job_count);
+    u32 begin = 0;
+    for (u32 i = 0; i + 1 < job_count && begin < count; ++i) {
+        const u32 end = std::min(begin + job_size, count);
+        futures.push_back(thread_pool->submit([&job, begin, end]() { job(begin, end); }));
+        begin = end;
+    }
+
+    job(begin, count);
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+}
+
+namespace ascension::graphics {
+
+Particle_Emitter::Particle_Emitter()
+  : m_position(0.0f)
+  , m_count(0)
+  , m_emission_remainder(0.0f)
+{
+}
+
+Particle_Emitter::~Particle_Emitter() = default;
+
+void
+Particle_Emitter::create(
+    u32 max_particles,
+    const Particle_Emitter_Config& config,
+    const std::shared_ptr<Texture_2D>& texture,
+    const std::shared_ptr<Shader>& shader
+)
+{
+    if (texture == nullptr || shader == nullptr) {
+        core::log::error("Particle_Emitter::create() attempting to create an emitter without a texture or shader");
+        return;
+    }
+
+    m_config = config;
+    m_texture = texture;
+
+    Batch_Config batch_config(max_particles, texture, shader);
+    batch_config.has_colors = true;
+    m_batch = std::make_shared<Batch>(batch_config);
+
+    m_count = 0;
+    m_position_x.assign(max_particles, 0.0f);
+    m_position_y.assign(max_particles, 0.0f);
+    m_velocity_x.assign(max_particles, 0.0f);
+    m_velocity_y.assign(max_particles, 0.0f);
+    m_ages.assign(max_particles, 0.0f);
+    m_inverse_lifetimes.assign(max_particles, 0.0f);
+    m_emission_remainder = 0.0f;
+}
+
+void
+Particle_Emitter::set_config(const Particle_Emitter_Config& config)
+{
+    m_config = config;
+}
+
+void
+Particle_Emitter::set_position(const v2f& position)
+{
+    m_position = position;
+}
+
+void
+Particle_Emitter::emit(u32 count)
+{
+    count = std::min(count, capacity() - m_count);
+
+    std::uniform_real_distribution<f32> unit(0.0f, 1.0f);
+    const auto random_between = [&](f32 min, f32 max) { return min + (max - min) * unit(m_random); };
+
+    for (u32 i = m_count; i < m_count + count; ++i) {
+        m_position_x[i] = m_position.x;
+        m_position_y[i] = m_position.y;
+        m_velocity_x[i] = random_between(m_config.min_velocity.x, m_config.max_velocity.x);
+        m_velocity_y[i] = random_between(m_config.min_velocity.y, m_config.max_velocity.y);
+        m_ages[i] = 0.0f;
+        m_inverse_lifetimes[i] =
+            1.0f / std::max(random_between(m_config.min_lifetime, m_config.max_lifetime), MIN_LIFETIME);
+    }
+
+    m_count += count;
+}
+
+void
+Particle_Emitter::clear()
+{
+    m_count = 0;
+    m_emission_remainder = 0.0f;
+}
+
+void
+Particle_Emitter::update(f64 delta_time, yuki::Thread_Pool* thread_pool)
+{
+    PROFILE_FUNCTION();
+
+    const auto dt = static_cast<f32>(delta_time);
+    run_jobs(m_count, thread_pool, [this, dt](u32 begin, u32 end) { integrate(begin, end, dt); });
+    remove_dead();
+
+    m_emission_remainder += m_config.emission_rate * dt;
+    const auto spawn_count = static_cast<u32>(m_emission_remainder);
+    m_emission_remainder -= static_cast<f32>(spawn_count);
+    emit(spawn_count);
+}
+
+void
+Particle_Emitter::draw(yuki::Thread_Pool* thread_pool)
+{
+    PROFILE_FUNCTION();
+    PROFILE_GPU_SCOPE("Particle_Emitter::draw");
+
+    if (m_batch == nullptr || m_count == 0) {
+        return;
+    }
+
+    // Flushing clears the batch's texture along with its quads.
+    if (m_batch->current_texture_id() == 0) {
+        m_batch->set_texture(m_texture);
+    }
+
+    const Batch_Quads quads = m_batch->allocate_quads(m_count);
+    if (quads.count == 0) {
+        return;
+    }
+
+    run_jobs(quads.count, thread_pool, [this, &quads](u32 begin, u32 end) {
+        write_quads(begin, end, quads.positions, quads.texture_coords, quads.colors);
+    });
+
+    m_batch->flush();
+}
+
+u32
+Particle_Emitter::size() const
+{
+    return m_count;
+}
+
+u32
+Particle_Emitter::capacity() const
+{
+    return static_cast<u32>(m_ages.size());
+}
+
+void
+Particle_Emitter::integrate(u32 begin, u32 end, f32 delta_time)
+{
+    f32* const position_x = m_position_x.data();
+    f32* const position_y = m_position_y.data();
+    f32* const velocity_x = m_velocity_x.data();
+    f32* const velocity_y = m_velocity_y.data();
+    f32* const ages = m_ages.data();
+
+    // Semi-implicit Euler, velocity first so acceleration reaches the position in the same step.
+    const f32 acceleration_x = m_config.acceleration.x * delta_time;
+    const f32 acceleration_y = m_config.acceleration.y * delta_time;
+
+    u32 i = begin;
+#ifdef ASCENSION_PARTICLES_SSE2
+    const __m128 delta_time_4 = _mm_set1_ps(delta_time);
+    const __m128 acceleration_x_4 = _mm_set1_ps(acceleration_x);
+    const __m128 acceleration_y_4 = _mm_set1_ps(acceleration_y);
+    for (; i + 4 <= end; i += 4) {
+        const __m128 vx = _mm_add_ps(_mm_loadu_ps(&velocity_x[i]), acceleration_x_4); // NOLINT
+        const __m128 vy = _mm_add_ps(_mm_loadu_ps(&velocity_y[i]), acceleration_y_4); // NOLINT
+        _mm_storeu_ps(&velocity_x[i], vx);                                            // NOLINT
+        _mm_storeu_ps(&velocity_y[i], vy);                                            // NOLINT
+
+        const __m128 x = _mm_add_ps(_mm_loadu_ps(&position_x[i]), _mm_mul_ps(vx, delta_time_4)); // NOLINT
+        const __m128 y = _mm_add_ps(_mm_loadu_ps(&position_y[i]), _mm_mul_ps(vy, delta_time_4)); // NOLINT
+        _mm_storeu_ps(&position_x[i], x);                                                        // NOLINT
+        _mm_storeu_ps(&position_y[i], y);                                                        // NOLINT
+
+        _mm_storeu_ps(&ages[i], _mm_add_ps(_mm_loadu_ps(&ages[i]), delta_time_4)); // NOLINT
+    }
+#endif
+    for (; i < end; ++i) {
+        velocity_x[i] += acceleration_x;         // NOLINT
+        velocity_y[i] += acceleration_y;         // NOLINT
+        position_x[i] += velocity_x[i] * delta_time; // NOLINT
+        position_y[i] += velocity_y[i] * delta_time; // NOLINT
+        ages[i] += delta_time;                   // NOLINT
+    }
+}
+
+void
+Particle_Emitter::write_quads(u32 begin, u32 end, f32* positions, f32* texture_coords, u32* colors) const
+{
+    const f32* const position_x = m_position_x.data();
+    const f32* const position_y = m_position_y.data();
+    const f32* const ages = m_ages.data();
+    const f32* const inverse_lifetimes = m_inverse_lifetimes.data();
+
+    // Over life values are start + delta * life, life running from 0 at spawn to 1 at death.
+    const f32 start_half_size = m_config.start_size * 0.5f;
+    const f32 delta_half_size = (m_config.end_size - m_config.start_size) * 0.5f;
+    // Colours are rounded half up by truncating, the half is added to the start so both paths round alike.
+    std::array<f32, 4> start_color = get_color_channels(m_config.start_color);
+    std::array<f32, 4> delta_color = get_color_channels(m_config.end_color);
+    for (u32 channel = 0; channel < 4; ++channel) {
+        delta_color.at(channel) -= start_color.at(channel);
+        start_color.at(channel) += 0.5f;
+    }
+
+    // Every particle uses the whole texture, wound as Batch::add winds its vertices.
+    const v4f uv = m_texture->texture_coords();
+    const std::array<f32, QUAD_POSITION_COUNT> quad_texture_coords{ uv.x, uv.y, uv.x, uv.w, uv.z, uv.w, uv.z, uv.y };
+
+    u32 i = begin;
+#ifdef ASCENSION_PARTICLES_SSE2
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 start_half_size_4 = _mm_set1_ps(start_half_size);
+    const __m128 delta_half_size_4 = _mm_set1_ps(delta_half_size);
+    const __m128 texture_coords_low = _mm_loadu_ps(&quad_texture_coords[0]);
+    const __m128 texture_coords_high = _mm_loadu_ps(&quad_texture_coords[4]);
+
+    for (; i + 4 <= end; i += 4) {
+        const __m128 life = _mm_min_ps(_mm_mul_ps(_mm_loadu_ps(&ages[i]), _mm_loadu_ps(&inverse_lifetimes[i])), one); // NOLINT
+        const __m128 half_size = _mm_add_ps(start_half_size_4, _mm_mul_ps(delta_half_size_4, life));
+
+        const __m128 x = _mm_loadu_ps(&position_x[i]); // NOLINT
+        const __m128 y = _mm_loadu_ps(&position_y[i]); // NOLINT
+        const __m128 left = _mm_sub_ps(x, half_size);
+        const __m128 right = _mm_add_ps(x, half_size);
+        const __m128 bottom = _mm_sub_ps(y, half_size);
+        const __m128 top = _mm_add_ps(y, half_size);
+
+        // Interleave the 4 particles' edges into quads, each quad is 2 vectors of bottom left & top left then top
+        // right & bottom right.
+        const __m128 left_bottom_low = _mm_unpacklo_ps(left, bottom);
+        const __m128 left_top_low = _mm_unpacklo_ps(left, top);
+        const __m128 right_top_low = _mm_unpacklo_ps(right, top);
+        const __m128 right_bottom_low = _mm_unpacklo_ps(right, bottom);
+        const __m128 left_bottom_high = _mm_unpackhi_ps(left, bottom);
+        const __m128 left_top_high = _mm_unpackhi_ps(left, top);
+        const __m128 right_top_high = _mm_unpackhi_ps(right, top);
+        const __m128 right_bottom_high = _mm_unpackhi_ps(right, bottom);
+
+        f32* const quad = &positions[static_cast<size_t>(i) * QUAD_POSITION_COUNT]; // NOLINT
+        _mm_storeu_ps(&quad[0], _mm_movelh_ps(left_bottom_low, left_top_low));     // NOLINT
+        _mm_storeu_ps(&quad[4], _mm_movelh_ps(right_top_low, right_bottom_low));   // NOLINT
+        _mm_storeu_ps(&quad[8], _mm_movehl_ps(left_top_low, left_bottom_low));     // NOLINT
+        _mm_storeu_ps(&quad[12], _mm_movehl_ps(right_bottom_low, right_top_low));  // NOLINT
+        _mm_storeu_ps(&quad[16], _mm_movelh_ps(left_bottom_high, left_top_high));  // NOLINT
+        _mm_storeu_ps(&quad[20], _mm_movelh_ps(right_top_high, right_bottom_high)); // NOLINT
+        _mm_storeu_ps(&quad[24], _mm_movehl_ps(left_top_high, left_bottom_high));  // NOLINT
+        _mm_storeu_ps(&quad[28], _mm_movehl_ps(right_bottom_high, right_top_high)); // NOLINT
+
+        f32* const quad_texture = &texture_coords[static_cast<size_t>(i) * QUAD_POSITION_COUNT]; // NOLINT
+        for (u32 j = 0; j < 4; ++j) {
+            _mm_storeu_ps(&quad_texture[j * QUAD_POSITION_COUNT], texture_coords_low);      // NOLINT
+            _mm_storeu_ps(&quad_texture[j * QUAD_POSITION_COUNT + 4], texture_coords_high); // NOLINT
+        }
+
+        if (colors == nullptr) {
+            continue;
+        }
+
+        // Each channel truncated to a byte & shifted into place, red in the low byte.
+        __m128i packed = _mm_setzero_si128();
+        for (u32 channel = 0; channel < 4; ++channel) {
+            const __m128 value = _mm_add_ps(
+                _mm_set1_ps(start_color.at(channel)), _mm_mul_ps(_mm_set1_ps(delta_color.at(channel)), life)
+            );
+            packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_cvttps_epi32(value), static_cast<i32>(channel * 8)));
+        }
+
+        // The same colour for all 4 vertices of each quad.
+        auto* const quad_colors = reinterpret_cast<__m128i*>(&colors[static_cast<size_t>(i) * QUAD_VERTEX_COUNT]); // NOLINT
+        _mm_storeu_si128(&quad_colors[0], _mm_shuffle_epi32(packed, 0x00)); // NOLINT
+        _mm_storeu_si128(&quad_colors[1], _mm_shuffle_epi32(packed, 0x55)); // NOLINT
+        _mm_storeu_si128(&quad_colors[2], _mm_shuffle_epi32(packed, 0xAA)); // NOLINT
+        _mm_storeu_si128(&quad_colors[3], _mm_shuffle_epi32(packed, 0xFF)); // NOLINT
+    }
+#endif
+    for (; i < end; ++i) {
+        const f32 life = std::min(ages[i] * inverse_lifetimes[i], 1.0f); // NOLINT
+        const f32 half_size = start_half_size + delta_half_size * life;
+        const f32 left = position_x[i] - half_size;   // NOLINT
+        const f32 right = position_x[i] + half_size;  // NOLINT
+        const f32 bottom = position_y[i] - half_size; // NOLINT
+        const f32 top = position_y[i] + half_size;    // NOLINT
+
+        f32* const quad = &positions[static_cast<size_t>(i) * QUAD_POSITION_COUNT]; // NOLINT
+        const std::array<f32, QUAD_POSITION_COUNT> quad_positions{ left, bottom, left, top, right, top, right, bottom };
+        std::copy(quad_positions.begin(), quad_positions.end(), quad);
+        std::copy(
+            quad_texture_coords.begin(),
+            quad_texture_coords.end(),
+            &texture_coords[static_cast<size_t>(i) * QUAD_POSITION_COUNT] // NOLINT
+        );
+
+        if (colors == nullptr) {
+            continue;
+        }
+
+        u32 packed = 0;
+        for (u32 channel = 0; channel < 4; ++channel) {
+            const f32 value = start_color.at(channel) + delta_color.at(channel) * life;
+            packed |= static_cast<u32>(value) << (channel * 8U);
+        }
+        std::fill_n(&colors[static_cast<size_t>(i) * QUAD_VERTEX_COUNT], QUAD_VERTEX_COUNT, packed); // NOLINT
+    }
+}
+
+void
+Particle_Emitter::remove_dead()
+{
+    PROFILE_FUNCTION();
+
+    u32 i = 0;
+    while (i < m_count) {
+#ifdef ASCENSION_PARTICLES_SSE2
+        // Skip 4 particles at a time while none of them have died, most updates remove few.
+        if (i + 4 <= m_count) {
+            const __m128 life = _mm_mul_ps(_mm_loadu_ps(&m_ages[i]), _mm_loadu_ps(&m_inverse_lifetimes[i]));
+            if (_mm_movemask_ps(_mm_cmpge_ps(life, _mm_set1_ps(1.0f))) == 0) {
+                i += 4;
+                continue;
+            }
+        }
+#endif
+        if (m_ages[i] * m_inverse_lifetimes[i] < 1.0f) {
+            ++i;
+            continue;
+        }
+
+        // The last particle takes the dead one's place & is checked next.
+        --m_count;
+        m_position_x[i] = m_position_x[m_count];
+        m_position_y[i] = m_position_y[m_count];
+        m_velocity_x[i] = m_velocity_x[m_count];
+        m_velocity_y[i] = m_velocity_y[m_count];
+        m_ages[i] = m_ages[m_count];
+        m_inverse_lifetimes[i] = m_inverse_lifetimes[m_count];
+    }
+}
+
+}
@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-29 17:02:08
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-08-10 12:04:25
+ * Last Modified: 2026-10-18 15:49:34
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -26,13 +26,21 @@
 
 #include <GL/glew.h>
 
+#include "yuki/debug/instrumentor.hpp"
+
 #include "core/log.hpp"
 
+#include "graphics/gpu_profiler.hpp"
+#include "graphics/sampler.hpp"
 #include "graphics/sprite_font.hpp"
+#include "graphics/texture_2d.hpp"
 
 namespace ascension::graphics {
 
 bool Renderer_2D::s_initialized = false;
+std::vector<std::shared_ptr<Sampler>> Renderer_2D::s_samplers;
+Render_Stats Renderer_2D::s_current_stats;
+Render_Stats Renderer_2D::s_frame_stats;
 
 bool
 Renderer_2D::initialize()
@@ -52,6 +60,18 @@ Renderer_2D::initialize()
         return false;
     }
 
+    // GPU timings are optional, the renderer works fine without timer query support.
+    Gpu_Profiler::initialize();
+
+    for (const auto filter : { Sampler_Filter::NEAREST, Sampler_Filter::LINEAR, Sampler_Filter::TRILINEAR }) {
+        auto sampler = std::make_shared<Sampler>();
+        if (!sampler->create(filter)) {
+            return false;
+        }
+        s_samplers.push_back(sampler);
+    }
+    get_sampler(Sampler_Filter::LINEAR)->bind();
+
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -63,6 +83,29 @@ Renderer_2D::initialize()
     return true;
 }
 
+void
+Renderer_2D::shutdown()
+{
+    Gpu_Profiler::shutdown();
+
+    s_samplers.clear();
+    s_initialized = false;
+}
+
+void
+Renderer_2D::begin_frame()
+{
+    s_frame_stats = s_current_stats;
+    s_current_stats = {};
+
+    PROFILE_COUNTER("draw calls", s_frame_stats.draw_calls);
+    PROFILE_COUNTER("quads", s_frame_stats.quads);
+    PROFILE_COUNTER("batches flushed", s_frame_stats.batches_flushed);
+    PROFILE_COUNTER("bytes uploaded", s_frame_stats.bytes_uploaded);
+
+    Gpu_Profiler::begin_frame();
+}
+
 void
 Renderer_2D::set_clear_color(v4f color)
 {
@@ -96,10 +139,83 @@ Renderer_2D::enable_blending(Blend_Function blend_func)
     }
 }
 
+void
+Renderer_2D::record_draw_call()
+{
+    ++s_current_stats.draw_calls;
+}
+
+void
+Renderer_2D::record_quads(u32 count)
+{
+    s_current_stats.quads += count;
+}
+
+void
+Renderer_2D::record_upload(u64 bytes)
+{
+    s_current_stats.bytes_uploaded += bytes;
+}
+
+void
+Renderer_2D::record_texture_bind()
+{
+    ++s_current_stats.texture_binds;
+}
+
+void
+Renderer_2D::record_shader_bind()
+{
+    ++s_current_stats.shader_binds;
+}
+
+void
+Renderer_2D::record_vertex_array_bind()
+{
+    ++s_current_stats.vertex_array_binds;
+}
+
+void
+Renderer_2D::record_batch_created()
+{
+    ++s_current_stats.batches_created;
+}
+
+void
+Renderer_2D::record_batch_flushed()
+{
+    ++s_current_stats.batches_flushed;
+}
+
+void
+Renderer_2D::record_sprites_dropped(u32 count)
+{
+    s_current_stats.sprites_dropped += count;
+}
+
+const std::shared_ptr<Sampler>&
+Renderer_2D::get_sampler(Sampler_Filter filter)
+{
+    assert(static_cast<size_t>(filter) < s_samplers.size());
+    return s_samplers[static_cast<size_t>(filter)];
+}
+
+const std::shared_ptr<Sampler>&
+Renderer_2D::get_default_sampler(const Texture_2D& texture)
+{
+    return get_sampler(texture.mip_levels() > 1 ? Sampler_Filter::TRILINEAR : Sampler_Filter::LINEAR);
+}
+
 bool
 Renderer_2D::is_initialized()
 {
     return s_initialized;
 }
 
+const Render_Stats&
+Renderer_2D::get_frame_stats()
+{
+    return s_frame_stats;
+}
+
 }
@@ -0,0 +1,145 @@
+/**
+ * File: sampler.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:50:03
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 14:53:53
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "graphics/sampler.hpp"
+
+#include <GL/glew.h>
+
+#include "core/log.hpp"
+
+namespace {
+
+constexpr GLint
+filter_to_gl_min_filter(ascension::graphics::Sampler_Filter filter)
+{
+    switch (filter) {
+        case ascension::graphics::Sampler_Filter::NEAREST:
+            return GL_NEAREST_MIPMAP_NEAREST;
+        case ascension::graphics::Sampler_Filter::LINEAR:
+            return GL_LINEAR;
+        case ascension::graphics::Sampler_Filter::TRILINEAR:
+            return GL_LINEAR_MIPMAP_LINEAR;
+    }
+    return GL_LINEAR;
+}
+
+constexpr GLint
+filter_to_gl_mag_filter(ascension::graphics::Sampler_Filter filter)
+{
+    switch (filter) {
+        case ascension::graphics::Sampler_Filter::NEAREST:
+            return GL_NEAREST;
+        case ascension::graphics::Sampler_Filter::LINEAR:
+        case ascension::graphics::Sampler_Filter::TRILINEAR:
+            return GL_LINEAR;
+    }
+    return GL_LINEAR;
+}
+
+constexpr GLint
+wrap_to_gl_wrap(ascension::graphics::Sampler_Wrap wrap)
+{
+    switch (wrap) {
+        case ascension::graphics::Sampler_Wrap::CLAMP_TO_EDGE:
+            return GL_CLAMP_TO_EDGE;
+        case ascension::graphics::Sampler_Wrap::REPEAT:
+            return GL_REPEAT;
+    }
+    return GL_CLAMP_TO_EDGE;
+}
+
+}
+namespace ascension::graphics {
+
+Sampler::Sampler()
+  : m_id(0)
+  , m_filter(Sampler_Filter::LINEAR)
+  , m_wrap(Sampler_Wrap::CLAMP_TO_EDGE)
+{
+}
+
+Sampler::~Sampler()
+{
+    if (m_id > 0) {
+        glDeleteSamplers(1, &m_id);
+        m_id = 0;
+    }
+}
+
+bool
+Sampler::create(Sampler_Filter filter, Sampler_Wrap wrap)
+{
+    m_filter = filter;
+    m_wrap = wrap;
+
+    if (m_id == 0) {
+        glGenSamplers(1, &m_id);
+    }
+
+    if (m_id == 0) {
+        core::log::error("Failed to create sampler with error {}", glGetError());
+        return false;
+    }
+
+    // NOTE: NEAREST picks the closest mip level too, textures without a mip chain only have the base level so the
+    // /n    mipmapped min filters sample exactly as their non mipmapped versions do.
+    glSamplerParameteri(m_id, GL_TEXTURE_MIN_FILTER, filter_to_gl_min_filter(filter));
+    glSamplerParameteri(m_id, GL_TEXTURE_MAG_FILTER, filter_to_gl_mag_filter(filter));
+    glSamplerParameteri(m_id, GL_TEXTURE_WRAP_S, wrap_to_gl_wrap(wrap));
+    glSamplerParameteri(m_id, GL_TEXTURE_WRAP_T, wrap_to_gl_wrap(wrap));
+
+    return true;
+}
+
+void
+Sampler::bind(u32 unit) const
+{
+    glBindSampler(unit, m_id);
+}
+
+void
+Sampler::unbind(u32 unit)
+{
+    glBindSampler(unit, 0);
+}
+
+u32
+Sampler::id() const
+{
+    return m_id;
+}
+
+Sampler_Filter
+Sampler::filter() const
+{
+    return m_filter;
+}
+
+Sampler_Wrap
+Sampler::wrap() const
+{
+    return m_wrap;
+}
+
+}
@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-11 20:36:05
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-05-08 21:25:19
+ * Last Modified: 2026-10-18 14:45:10
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -30,6 +30,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "core/log.hpp"
+#include "graphics/renderer_2d.hpp"
 
 namespace {
 
@@ -100,25 +101,34 @@ Shader::create(const std::string& vertex_source, const std::string& fragment_sou
         return;
     }
 
-    m_id = glCreateProgram();
-    glAttachShader(m_id, vertex_shader);
-    glAttachShader(m_id, fragment_shader);
-    glLinkProgram(m_id);
-    if (!check_shader_errors(m_id, Error_Check_Type::LINK)) {
+    const u32 program = glCreateProgram();
+    glAttachShader(program, vertex_shader);
+    glAttachShader(program, fragment_shader);
+    glLinkProgram(program);
+    if (!check_shader_errors(program, Error_Check_Type::LINK)) {
         glDeleteShader(vertex_shader);
         glDeleteShader(fragment_shader);
-        glDeleteProgram(m_id);
+        glDeleteProgram(program);
         return;
     }
 
     glDeleteShader(vertex_shader);
     glDeleteShader(fragment_shader);
+
+    // Only replace the program once the new one has linked, so reloading a shader with errors keeps the last
+    // working version.
+    if (m_id != 0) {
+        glDeleteProgram(m_id);
+    }
+    m_id = program;
+    m_uniform_cache.clear();
 }
 
 void
 Shader::bind() const
 {
     glUseProgram(m_id);
+    Renderer_2D::record_shader_bind();
 }
 
 void
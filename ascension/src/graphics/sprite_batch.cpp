@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-15 14:54:44
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-08-10 12:23:09
+ * Last Modified: 2026-10-18 15:49:34
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -24,6 +24,7 @@
 
 #include "graphics/sprite_batch.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
 
@@ -34,9 +35,13 @@
 
 #include "core/log.hpp"
 #include "graphics/buffer_object.hpp"
+#include "graphics/gpu_profiler.hpp"
+#include "graphics/renderer_2d.hpp"
+#include "graphics/sampler.hpp"
 #include "graphics/shader.hpp"
 #include "graphics/sprite_font.hpp"
 #include "graphics/texture_2d.hpp"
+#include "graphics/texture_atlas.hpp"
 #include "graphics/vertex_array_object.hpp"
 
 namespace ascension::graphics {
@@ -45,6 +50,18 @@ static constexpr u32 QUAD_VERTEX_COUNT = 4;
 static constexpr u32 QUAD_VERTEX_COMPONENT_COUNT = QUAD_VERTEX_COUNT * 2;
 static constexpr u32 QUAD_INDEX_COUNT = 6;
 static constexpr u32 PIXEL_BIT_SHIFT = 6;
+static constexpr u32 WHITE = 0xFFFFFFFF;
+static constexpr u32 BATCH_LOG_MAX_PER_SECOND = 5;
+
+static core::log::Channel
+get_batch_log_channel()
+{
+    // A full batch is hit for every sprite drawn past the limit, so these records are rate limited.
+    static const core::log::Channel s_channel = core::log::register_channel(
+        "ascension.batch", { yuki::debug::Severity::LOG_DEBUG, BATCH_LOG_MAX_PER_SECOND, 1 }
+    );
+    return s_channel;
+}
 
 // Batch
 Batch::Batch()
@@ -62,9 +79,13 @@ void
 Batch::create(const Batch_Config& config)
 {
     m_config = config;
+    Renderer_2D::record_batch_created();
 
     m_vertex_positions.reserve(static_cast<size_t>(m_config.max_size) * QUAD_VERTEX_COMPONENT_COUNT);
     m_texture_coords.reserve(static_cast<size_t>(m_config.max_size) * QUAD_VERTEX_COMPONENT_COUNT);
+    if (m_config.has_colors) {
+        m_colors.reserve(static_cast<size_t>(m_config.max_size) * QUAD_VERTEX_COUNT);
+    }
 
     m_vao = std::make_unique<Vertex_Array_Object>();
     m_vao->create(true);
@@ -79,6 +100,13 @@ Batch::create(const Batch_Config& config)
     m_ubo->set_layout({ { Shader_Data_Type::Float, 2, true } });
     m_vao->add_vertex_buffer(m_ubo);
 
+    if (m_config.has_colors) {
+        m_cbo = std::make_shared<Vertex_Buffer_Object>();
+        m_cbo->create(sizeof(u32) * m_config.max_size * QUAD_VERTEX_COUNT);
+        m_cbo->set_layout({ { Shader_Data_Type::UByte, 4, true } });
+        m_vao->add_vertex_buffer(m_cbo);
+    }
+
     static const std::array<u32, 6> indices_template{ 0, 1, 2, 2, 3, 0 };
     std::vector<u32> indices(static_cast<size_t>(QUAD_INDEX_COUNT) * m_config.max_size);
 
@@ -112,6 +140,12 @@ Batch::set_texture(const std::shared_ptr<Texture_2D>& texture)
     m_config.texture = texture;
 }
 
+void
+Batch::set_sampler(const std::shared_ptr<Sampler>& sampler)
+{
+    m_config.sampler = sampler;
+}
+
 void
 Batch::set_is_static(bool is_static)
 {
@@ -125,12 +159,14 @@ Batch::add(const v2f& position, const v2u& size, const v4f& tex_coords)
 
     if (m_config.max_size == 0 || m_config.texture == nullptr) {
         core::log::error("Attempting to add texture to uninitialized batch");
+        Renderer_2D::record_sprites_dropped(1);
         return;
     }
 
     // TODO: Work out if we just want to immediately draw here instead.
     if (m_current_size >= m_config.max_size) {
-        core::log::warn("Attempting to add texture to full batch.");
+        core::log::warn(get_batch_log_channel(), "Attempting to add texture to full batch.");
+        Renderer_2D::record_sprites_dropped(1);
         return;
     }
 
@@ -158,6 +194,10 @@ Batch::add(const v2f& position, const v2u& size, const v4f& tex_coords)
     m_texture_coords.emplace_back(tex_coords.z);
     m_texture_coords.emplace_back(tex_coords.y);
 
+    if (m_config.has_colors) {
+        m_colors.insert(m_colors.end(), QUAD_VERTEX_COUNT, WHITE);
+    }
+
     ++m_current_size;
 }
 
@@ -173,10 +213,53 @@ Batch::add(const Texture_2D& sub_texture, const v2f& position)
     add(position, sub_texture.size(), sub_texture.texture_coords());
 }
 
+void
+Batch::add(const Sub_Texture_Rect& sub_texture, const v2f& position)
+{
+    add(position, sub_texture.size, sub_texture.texture_coords);
+}
+
+Batch_Quads
+Batch::allocate_quads(u32 count)
+{
+    if (m_config.max_size == 0 || m_config.texture == nullptr) {
+        core::log::error("Attempting to allocate quads in uninitialized batch");
+        Renderer_2D::record_sprites_dropped(count);
+        return {};
+    }
+
+    const u32 allocated = std::min(count, m_config.max_size - m_current_size);
+    if (allocated < count) {
+        core::log::warn(
+            get_batch_log_channel(), "Attempting to allocate {} quads in batch with space for {}.", count, allocated
+        );
+        Renderer_2D::record_sprites_dropped(count - allocated);
+    }
+    if (allocated == 0) {
+        return {};
+    }
+
+    const size_t first = m_current_size;
+    m_current_size += allocated;
+    m_vertex_positions.resize(static_cast<size_t>(m_current_size) * QUAD_VERTEX_COMPONENT_COUNT);
+    m_texture_coords.resize(static_cast<size_t>(m_current_size) * QUAD_VERTEX_COMPONENT_COUNT);
+    if (m_config.has_colors) {
+        m_colors.resize(static_cast<size_t>(m_current_size) * QUAD_VERTEX_COUNT);
+    }
+
+    Batch_Quads quads;
+    quads.positions = &m_vertex_positions[first * QUAD_VERTEX_COMPONENT_COUNT];
+    quads.texture_coords = &m_texture_coords[first * QUAD_VERTEX_COMPONENT_COUNT];
+    quads.colors = m_config.has_colors ? &m_colors[first * QUAD_VERTEX_COUNT] : nullptr;
+    quads.count = allocated;
+    return quads;
+}
+
 void
 Batch::flush()
 {
     PROFILE_FUNCTION();
+    PROFILE_GPU_SCOPE("Batch::flush");
 
     assert(m_vao != nullptr);
     assert(m_config.shader != nullptr);
@@ -184,15 +267,28 @@ Batch::flush()
 
     m_config.shader->bind();
     m_config.texture->bind();
+    // Batches sharing a texture can sample it differently, so the sampler is always rebound with the texture.
+    if (m_config.sampler != nullptr) {
+        m_config.sampler->bind();
+    }
+    else {
+        Renderer_2D::get_default_sampler(*m_config.texture)->bind();
+    }
 
     m_vao->bind();
 
     m_vbo->buffer_data(static_cast<u32>(m_vertex_positions.size() * sizeof(f32)), m_vertex_positions.data());
     m_ubo->buffer_data(static_cast<u32>(m_texture_coords.size() * sizeof(f32)), m_texture_coords.data());
+    if (m_cbo != nullptr) {
+        m_cbo->buffer_data(static_cast<u32>(m_colors.size() * sizeof(u32)), m_colors.data());
+    }
 
     m_ibo->draw_elements(static_cast<i32>(m_current_size * QUAD_INDEX_COUNT), Draw_Mode::Triangles);
     m_vao->unbind();
 
+    Renderer_2D::record_quads(m_current_size);
+    Renderer_2D::record_batch_flushed();
+
     if (!m_config.is_static) {
         clear();
     }
@@ -205,6 +301,7 @@ Batch::clear()
 
     m_vertex_positions.clear();
     m_texture_coords.clear();
+    m_colors.clear();
     m_current_size = 0;
     m_config.texture = nullptr;
 }
@@ -283,6 +380,18 @@ Sprite_Batch::create_batch(const Batch_Config& config)
     }
 
     m_batches.emplace_back(std::make_shared<Batch>(config));
+    if (config.sampler == nullptr) {
+        m_batches.back()->set_sampler(m_sampler);
+    }
+}
+
+void
+Sprite_Batch::set_sampler(const std::shared_ptr<Sampler>& sampler)
+{
+    m_sampler = sampler;
+    for (auto& batch : m_batches) {
+        batch->set_sampler(sampler);
+    }
 }
 
 void
@@ -313,6 +422,17 @@ Sprite_Batch::draw_texture(
     draw_texture_internal(texture, position, sub_texture.size(), sub_texture.texture_coords(), is_static);
 }
 
+void
+Sprite_Batch::draw_texture(
+    const std::shared_ptr<Texture_2D>& texture,
+    const Sub_Texture_Rect& sub_texture,
+    const v2f& position,
+    bool is_static
+)
+{
+    draw_texture_internal(texture, position, sub_texture.size, sub_texture.texture_coords, is_static);
+}
+
 void
 Sprite_Batch::draw_string(
     const std::shared_ptr<Sprite_Font>& font,
@@ -375,7 +495,8 @@ Sprite_Batch::draw_texture_internal(
     }
     else {
         // TODO: Consider if we should try and empty the fullest batch?
-        core::log::error("Sprite_Batch::draw() trying to draw new texture when all batches are full!");
+        core::log::error(get_batch_log_channel(), "Sprite_Batch::draw() trying to draw new texture when all batches are full!");
+        Renderer_2D::record_sprites_dropped(1);
     }
 }
 
@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-07-17 21:08:32
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-08-12 16:39:48
+ * Last Modified: 2026-10-18 15:06:38
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -75,6 +75,22 @@ Sprite_Font::create(std::string filepath, const std::shared_ptr<Shader>& font_sh
     m_shader = font_shader;
 }
 
+void
+Sprite_Font::create(
+    std::string name,
+    const u8* data,
+    u64 data_size,
+    std::shared_ptr<const void> data_owner,
+    const std::shared_ptr<Shader>& font_shader
+)
+{
+    m_filepath = std::move(name);
+    m_font_data = data;
+    m_font_data_size = data_size;
+    m_font_data_owner = std::move(data_owner);
+    m_shader = font_shader;
+}
+
 const Sprite_Font::Glyph&
 Sprite_Font::get_glyph(u32 character, u32 font_size)
 {
@@ -88,7 +104,12 @@ Sprite_Font::get_glyph(u32 character, u32 font_size)
         size_cache.texture->create(m_max_texture_size, m_max_texture_size, nullptr);
 
         auto* ft_font_face = static_cast<FT_Face>(size_cache.font_face);
-        if (FT_New_Face(ft_library, m_filepath.c_str(), 0, &ft_font_face) != 0) {
+        const auto result = m_font_data != nullptr
+                              ? FT_New_Memory_Face(
+                                    ft_library, m_font_data, static_cast<FT_Long>(m_font_data_size), 0, &ft_font_face
+                                )
+                              : FT_New_Face(ft_library, m_filepath.c_str(), 0, &ft_font_face);
+        if (result != 0) {
             core::log::error("Failed to create font face {} ({}) for character {}", m_filepath, font_size, character);
             return m_empty_glyph;
         }
@@ -162,7 +183,7 @@ Sprite_Font::get_glyph(u32 character, u32 font_size)
         const auto sub_tex_coords = v4f{ sub_tex_uv_x, sub_tex_uv_y + sub_tex_uv_h, sub_tex_uv_x + sub_tex_uv_w, sub_tex_uv_y };
 
         Glyph glyph;
-        glyph.sub_texture.create(temp_texture->width(), temp_texture->height(), sub_tex_coords, nullptr);
+        glyph.sub_texture.create_view(size_cache.texture, temp_texture->width(), temp_texture->height(), sub_tex_coords);
         glyph.texture = size_cache.texture;
         glyph.advance = static_cast<u32>(font_face->glyph->advance.x);
         glyph.bearing = v2{ font_face->glyph->bitmap_left, font_face->glyph->bitmap_top };
@@ -173,4 +194,14 @@ Sprite_Font::get_glyph(u32 character, u32 font_size)
 
     return m_font_cache[font_size].glyph_cache[character];
 }
+
+u64
+Sprite_Font::texture_bytes() const
+{
+    u64 bytes = 0;
+    for (const auto& [font_size, size_cache] : m_font_cache) {
+        bytes += size_cache.texture->byte_size();
+    }
+    return bytes;
+}
 }
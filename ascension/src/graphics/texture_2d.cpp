@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-11 19:41:46
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-08-12 16:40:23
+ * Last Modified: 2026-10-18 15:23:29
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -24,13 +24,16 @@
 
 #include "graphics/texture_2d.hpp"
 
+#include <algorithm>
+
 #include <GL/glew.h>
 
 #include "core/log.hpp"
+#include "graphics/renderer_2d.hpp"
 
 namespace {
 
-constexpr int
+constexpr GLenum
 format_to_gl_format(ascension::graphics::Texture_2D::Format format)
 {
     switch (format) {
@@ -40,12 +43,90 @@ format_to_gl_format(ascension::graphics::Texture_2D::Format format)
             return GL_RGBA;
         case ascension::graphics::Texture_2D::Format::RED:
             return GL_RED;
+        case ascension::graphics::Texture_2D::Format::R16UI:
+            return GL_RED_INTEGER;
+        case ascension::graphics::Texture_2D::Format::RGBA32F:
+            return GL_RGBA;
         default:
             return GL_RGBA;
     }
     return GL_RGBA;
 }
 
+constexpr GLenum
+format_to_gl_internal_format(ascension::graphics::Texture_2D::Format format)
+{
+    switch (format) {
+        case ascension::graphics::Texture_2D::Format::RGB:
+            return GL_RGB8;
+        case ascension::graphics::Texture_2D::Format::RGBA:
+            return GL_RGBA8;
+        case ascension::graphics::Texture_2D::Format::RED:
+            return GL_R8;
+        case ascension::graphics::Texture_2D::Format::BC1:
+            return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case ascension::graphics::Texture_2D::Format::BC3:
+            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case ascension::graphics::Texture_2D::Format::R16UI:
+            return GL_R16UI;
+        case ascension::graphics::Texture_2D::Format::RGBA32F:
+            return GL_RGBA32F;
+    }
+    return GL_RGBA8;
+}
+
+constexpr GLenum
+format_to_gl_type(ascension::graphics::Texture_2D::Format format)
+{
+    switch (format) {
+        case ascension::graphics::Texture_2D::Format::R16UI:
+            return GL_UNSIGNED_SHORT;
+        case ascension::graphics::Texture_2D::Format::RGBA32F:
+            return GL_FLOAT;
+        default:
+            return GL_UNSIGNED_BYTE;
+    }
+    return GL_UNSIGNED_BYTE;
+}
+
+constexpr GLenum
+format_to_gl_compressed_format(ascension::graphics::Texture_2D::Format format)
+{
+    switch (format) {
+        case ascension::graphics::Texture_2D::Format::BC1:
+            return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case ascension::graphics::Texture_2D::Format::BC3:
+            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        default:
+            return 0;
+    }
+    return 0;
+}
+
+constexpr u64
+format_byte_size(ascension::graphics::Texture_2D::Format format, u32 width, u32 height)
+{
+    const u64 pixel_count = u64{ width } * height;
+    const u64 block_count = u64{ (width + 3) / 4 } * ((height + 3) / 4);
+    switch (format) {
+        case ascension::graphics::Texture_2D::Format::RGB:
+            return pixel_count * 3;
+        case ascension::graphics::Texture_2D::Format::RGBA:
+            return pixel_count * 4;
+        case ascension::graphics::Texture_2D::Format::RED:
+            return pixel_count;
+        case ascension::graphics::Texture_2D::Format::BC1:
+            return block_count * 8;
+        case ascension::graphics::Texture_2D::Format::BC3:
+            return block_count * 16;
+        case ascension::graphics::Texture_2D::Format::R16UI:
+            return pixel_count * 2;
+        case ascension::graphics::Texture_2D::Format::RGBA32F:
+            return pixel_count * 16;
+    }
+    return pixel_count * 4;
+}
+
 }
 namespace ascension::graphics {
 
@@ -54,6 +135,7 @@ Texture_2D::Texture_2D()
   , m_width(0)
   , m_height(0)
   , m_format(Format::RGBA)
+  , m_mip_levels(1)
   , m_texture_coords(0.0f, 0.0f, 1.0f, 1.0f)
 {
 }
@@ -67,67 +149,184 @@ Texture_2D::~Texture_2D()
 }
 
 void
-Texture_2D::create(u32 width, u32 height, u8* data, Format format)
+Texture_2D::create(u32 width, u32 height, const u8* data, Format format, u32 mip_levels)
 {
-    create(width, height, { 0.0f, 0.0f, 1.0f, 1.0f }, data, format);
-}
+    m_parent.reset();
+
+    const GLenum gl_compressed_format = format_to_gl_compressed_format(format);
+    const bool generate_mip_chain = mip_levels == GENERATE_MIP_CHAIN && gl_compressed_format == 0;
+    if (mip_levels == GENERATE_MIP_CHAIN) {
+        // The driver can't generate block compressed levels, those mip chains are built offline by the asset packer.
+        mip_levels = generate_mip_chain ? get_mip_chain_length(width, height) : 1;
+    }
+    mip_levels = std::clamp(mip_levels, 1U, get_mip_chain_length(width, height));
+
+    // Storage is immutable, creating an existing texture again only re-uploads its pixels in place when the size,
+    // format & levels are unchanged so anything holding the texture keeps working when it's reloaded.
+    const bool has_storage =
+        m_id != 0 && m_width == width && m_height == height && m_format == format && m_mip_levels == mip_levels;
+    if (m_id != 0 && !has_storage) {
+        glDeleteTextures(1, &m_id);
+        m_id = 0;
+    }
 
-void
-Texture_2D::create(u32 width, u32 height, v4f texture_coords, u8* data, Format format)
-{
     m_width = width;
     m_height = height;
 
     m_format = format;
+    m_mip_levels = mip_levels;
 
-    m_texture_coords = texture_coords;
+    m_texture_coords = { 0.0f, 0.0f, 1.0f, 1.0f };
 
-    glGenTextures(1, &m_id);
+    if (m_id == 0) {
+        glGenTextures(1, &m_id);
+    }
 
     if (m_id == 0) {
         core::log::error("Failed to create texture with error {}", glGetError());
         return;
     }
 
+    if (width == 0 || height == 0) {
+        return;
+    }
+
     i32 previous_pixel_store = 4;
     glGetIntegerv(GL_UNPACK_ALIGNMENT, &previous_pixel_store);
 
-    const i32 gl_format = format_to_gl_format(format);
-    if (format == Format::RED) {
+    if (format == Format::RED || format == Format::RGB || format == Format::R16UI) {
         //  NOTE: We generate some textures on the fly such as texture atlases for fonts, the font data loaded by
         //  /n    TrueType is stored in single alignment in the red channel, which is then filter later in the shader.
+        //  /n    Rows of RGB images from stb_image are tightly packed as well.
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     }
 
     bind();
 
-    glTexImage2D(
+    if (!has_storage) {
+        glTexStorage2D(
+            GL_TEXTURE_2D,
+            static_cast<GLsizei>(mip_levels),
+            format_to_gl_internal_format(format),
+            static_cast<GLsizei>(width),
+            static_cast<GLsizei>(height)
+        );
+    }
+
+    if (data != nullptr) {
+        const u32 upload_levels = generate_mip_chain ? 1 : mip_levels;
+        u64 offset = 0;
+        for (u32 level = 0; level < upload_levels; ++level) {
+            const auto level_width = static_cast<GLsizei>(std::max(width >> level, 1U));
+            const auto level_height = static_cast<GLsizei>(std::max(height >> level, 1U));
+            const u64 level_size = get_byte_size(format, width >> level, height >> level);
+
+            if (gl_compressed_format != 0) {
+                // Uploaded as is, no conversion by the driver & 4-8x less data to copy than the decompressed pixels.
+                glCompressedTexSubImage2D(
+                    GL_TEXTURE_2D,
+                    static_cast<GLint>(level),
+                    0,
+                    0,
+                    level_width,
+                    level_height,
+                    gl_compressed_format,
+                    static_cast<GLsizei>(level_size),
+                    &data[offset]
+                );
+            }
+            else {
+                glTexSubImage2D(
+                    GL_TEXTURE_2D,
+                    static_cast<GLint>(level),
+                    0,
+                    0,
+                    level_width,
+                    level_height,
+                    format_to_gl_format(format),
+                    format_to_gl_type(format),
+                    &data[offset]
+                );
+            }
+
+            offset += level_size;
+        }
+
+        if (generate_mip_chain && mip_levels > 1) {
+            glGenerateMipmap(GL_TEXTURE_2D);
+        }
+    }
+
+    unbind();
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, previous_pixel_store);
+}
+
+void
+Texture_2D::create_view(const std::shared_ptr<Texture_2D>& texture, u32 width, u32 height, v4f texture_coords)
+{
+    if (m_id != 0) {
+        glDeleteTextures(1, &m_id);
+        m_id = 0;
+    }
+
+    // Views of views point straight at the texture which owns the pixels.
+    m_parent = texture != nullptr && texture->m_parent != nullptr ? texture->m_parent : texture;
+
+    m_width = width;
+    m_height = height;
+
+    m_format = texture != nullptr ? texture->m_format : Format::RGBA;
+    m_mip_levels = texture != nullptr ? texture->m_mip_levels : 1;
+
+    m_texture_coords = texture_coords;
+}
+
+void
+Texture_2D::update(u32 x, u32 y, u32 width, u32 height, const u8* data)
+{
+    if (m_parent != nullptr || m_id == 0 || data == nullptr) {
+        core::log::error("Texture_2D::update() attempting to update a view or an empty texture");
+        return;
+    }
+    if (format_to_gl_compressed_format(m_format) != 0) {
+        core::log::error("Texture_2D::update() block compressed textures can't be updated");
+        return;
+    }
+    if (x + width > m_width || y + height > m_height) {
+        core::log::error(
+            "Texture_2D::update() region {}, {} {}x{} is outside the {}x{} texture", x, y, width, height, m_width, m_height
+        );
+        return;
+    }
+
+    i32 previous_pixel_store = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &previous_pixel_store);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    bind();
+    glTexSubImage2D(
         GL_TEXTURE_2D,
         0,
-        gl_format,
+        static_cast<GLint>(x),
+        static_cast<GLint>(y),
         static_cast<GLsizei>(width),
         static_cast<GLsizei>(height),
-        0,
-        static_cast<GLenum>(gl_format),
-        GL_UNSIGNED_BYTE,
+        format_to_gl_format(m_format),
+        format_to_gl_type(m_format),
         data
     );
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
     unbind();
 
     glPixelStorei(GL_UNPACK_ALIGNMENT, previous_pixel_store);
 }
 
 void
-Texture_2D::bind() const
+Texture_2D::bind(u32 unit) const
 {
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_id);
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, id());
+    Renderer_2D::record_texture_bind();
 }
 
 void
@@ -139,7 +338,14 @@ Texture_2D::unbind()
 u32
 Texture_2D::id() const
 {
-    return m_id;
+    // Looked up rather than copied, the parent's GL object is replaced when it's reloaded at a new size.
+    return m_parent != nullptr ? m_parent->m_id : m_id;
+}
+
+bool
+Texture_2D::is_view() const
+{
+    return m_parent != nullptr;
 }
 
 u32
@@ -160,6 +366,50 @@ Texture_2D::size() const
     return { m_width, m_height };
 }
 
+u32
+Texture_2D::mip_levels() const
+{
+    return m_mip_levels;
+}
+
+u64
+Texture_2D::byte_size() const
+{
+    if (m_parent != nullptr) {
+        return 0;
+    }
+    return get_byte_size(m_format, m_width, m_height, m_mip_levels);
+}
+
+bool
+Texture_2D::is_format_supported(Format format)
+{
+    if (format == Format::BC1 || format == Format::BC3) {
+        return GLEW_EXT_texture_compression_s3tc != 0;
+    }
+    return true;
+}
+
+u32
+Texture_2D::get_mip_chain_length(u32 width, u32 height)
+{
+    u32 levels = 1;
+    for (u32 size = std::max(width, height); size > 1; size >>= 1U) {
+        ++levels;
+    }
+    return levels;
+}
+
+u64
+Texture_2D::get_byte_size(Format format, u32 width, u32 height, u32 mip_levels)
+{
+    u64 byte_size = 0;
+    for (u32 level = 0; level < mip_levels; ++level) {
+        byte_size += format_byte_size(format, std::max(width >> level, 1U), std::max(height >> level, 1U));
+    }
+    return byte_size;
+}
+
 v4f
 Texture_2D::texture_coords() const
 {
@@ -169,25 +419,25 @@ Texture_2D::texture_coords() const
 bool
 operator==(const Texture_2D& tex_1, const Texture_2D& tex_2)
 {
-    return tex_1.m_id == tex_2.m_id;
+    return tex_1.id() == tex_2.id();
 }
 
 bool
 operator!=(const Texture_2D& tex_1, const Texture_2D& tex_2)
 {
-    return tex_1.m_id != tex_2.m_id;
+    return tex_1.id() != tex_2.id();
 }
 
 bool
 operator<(const Texture_2D& tex_1, const Texture_2D& tex_2)
 {
-    return tex_1.m_id < tex_2.m_id;
+    return tex_1.id() < tex_2.id();
 }
 
 bool
 operator>(const Texture_2D& tex_1, const Texture_2D& tex_2)
 {
-    return tex_1.m_id > tex_2.m_id;
+    return tex_1.id() > tex_2.id();
 }
 
 }
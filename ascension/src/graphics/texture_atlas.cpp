@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-07-05 18:55:49
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-07-09 17:34:29
+ * Last Modified: 2026-10-18 15:56:17
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -24,70 +24,85 @@
 
 #include "graphics/texture_atlas.hpp"
 
+#include <algorithm>
+
 #include "core/log.hpp"
 
 namespace ascension::graphics {
 
 void
-Texture_Atlas::create(const std::shared_ptr<Texture_2D>& texture, const std::unordered_map<std::string, v4u>& sub_textures)
+Texture_Atlas::create(const std::shared_ptr<Texture_2D>& texture, std::vector<Sub_Texture_Region> sub_textures)
 {
     if (texture == nullptr) {
         core::log::error("Texture_Atlas::create() attempting to create a texture_atlas from a null texture");
         return;
     }
 
-    m_sub_textures.reserve(sub_textures.size());
-    m_coord_ids.reserve(sub_textures.size());
-
-    Texture_2D null_texture;
-    null_texture.create(0, 0, nullptr);
-
-    m_coord_ids[""] = 0;
-    m_sub_textures.push_back(null_texture);
-
-    for (const auto& sub_texture_data : sub_textures) {
-        m_coord_ids[sub_texture_data.first] = static_cast<u32>(m_sub_textures.size());
-
-        const v4u& image_dims = sub_texture_data.second;
-        const u32 sub_texture_width = image_dims.z - image_dims.x;
-        const u32 sub_texture_height = image_dims.w - image_dims.y;
-
-        const v4f sub_texture_coords = {
-            static_cast<f32>(image_dims.x) / static_cast<f32>(texture->width()),
-            static_cast<f32>(image_dims.y) / static_cast<f32>(texture->height()),
-            static_cast<f32>(image_dims.z) / static_cast<f32>(texture->width()),
-            static_cast<f32>(image_dims.w) / static_cast<f32>(texture->height()),
-        };
-
-        Texture_2D sub_texture;
-        sub_texture.create(sub_texture_width, sub_texture_height, sub_texture_coords, nullptr);
+    // Binary atlas data is stored sorted by id, the sort is only paid for text .dat files.
+    const auto by_id = [](const Sub_Texture_Region& lhs, const Sub_Texture_Region& rhs) { return lhs.id < rhs.id; };
+    if (!std::is_sorted(sub_textures.begin(), sub_textures.end(), by_id)) {
+        std::sort(sub_textures.begin(), sub_textures.end(), by_id);
+    }
 
-        m_sub_textures.push_back(sub_texture);
+    m_ids.clear();
+    m_rects.clear();
+    m_ids.reserve(sub_textures.size());
+    m_rects.reserve(sub_textures.size());
+
+    const auto texture_width = static_cast<f32>(texture->width());
+    const auto texture_height = static_cast<f32>(texture->height());
+    for (const auto& sub_texture : sub_textures) {
+        if (!m_ids.empty() && m_ids.back() == sub_texture.id) {
+            core::log::error("Texture_Atlas::create() sub-texture id {:016x} is used more than once", sub_texture.id);
+            continue;
+        }
+
+        const v4u& image_dims = sub_texture.region;
+        m_ids.push_back(sub_texture.id);
+        m_rects.push_back({ { static_cast<f32>(image_dims.x) / texture_width,
+                              static_cast<f32>(image_dims.y) / texture_height,
+                              static_cast<f32>(image_dims.z) / texture_width,
+                              static_cast<f32>(image_dims.w) / texture_height },
+                            { image_dims.z - image_dims.x, image_dims.w - image_dims.y } });
     }
 
     m_texture = texture;
+    ++m_version;
 }
 
-const Texture_2D&
-Texture_Atlas::get_sub_texture(const std::string& name) const
+const Sub_Texture_Rect*
+Texture_Atlas::find_sub_texture(Sub_Texture_Id id) const
 {
-    if (m_coord_ids.count(name) == 0) {
-        core::log::warn("Texture_Atlas::get_texture_coords() Attempting to get non-existant sub_texture: '{}'", name);
-        return m_sub_textures.at(0);
+    const auto it = std::lower_bound(m_ids.begin(), m_ids.end(), id);
+    if (it == m_ids.end() || *it != id) {
+        return nullptr;
     }
 
-    return m_sub_textures.at(m_coord_ids.at(name));
+    return &m_rects[static_cast<size_t>(it - m_ids.begin())];
+}
+
+u32
+Texture_Atlas::size() const
+{
+    return static_cast<u32>(m_rects.size());
 }
 
-const Texture_2D&
-Texture_Atlas::get_sub_texture(u32 coords_id) const
+Texture_2D
+Texture_Atlas::get_sub_texture(const std::string& name) const
 {
-    if (coords_id >= m_sub_textures.size()) {
-        core::log::warn("Texture_Atlas::get_texture_coords() Attempting to get non-existant sub_texture: {}", coords_id);
-        return m_sub_textures.at(0);
+    const auto* rect = find_sub_texture(make_sub_texture_id(name));
+    if (rect == nullptr) {
+        core::log::warn("Texture_Atlas::get_sub_texture() Attempting to get non-existant sub_texture: '{}'", name);
+        return {};
     }
 
-    return m_sub_textures.at(coords_id);
+    return make_view(*rect);
+}
+
+bool
+Texture_Atlas::has_sub_texture(const std::string& name) const
+{
+    return find_sub_texture(make_sub_texture_id(name)) != nullptr;
 }
 
 const std::shared_ptr<Texture_2D>&
@@ -96,4 +111,18 @@ Texture_Atlas::get_texture() const
     return m_texture;
 }
 
+u32
+Texture_Atlas::version() const
+{
+    return m_version;
+}
+
+Texture_2D
+Texture_Atlas::make_view(const Sub_Texture_Rect& rect) const
+{
+    Texture_2D sub_texture;
+    sub_texture.create_view(m_texture, rect.size.x, rect.size.y, rect.texture_coords);
+    return sub_texture;
+}
+
 }
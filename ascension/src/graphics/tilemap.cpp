@@ -0,0 +1,275 @@
+/**
+ * File: tilemap.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 15:19:20
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:53:39
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "graphics/tilemap.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "yuki/debug/instrumentor.hpp"
+
+#include "core/log.hpp"
+#include "graphics/buffer_object.hpp"
+#include "graphics/gpu_profiler.hpp"
+#include "graphics/renderer_2d.hpp"
+#include "graphics/sampler.hpp"
+#include "graphics/shader.hpp"
+#include "graphics/texture_atlas.hpp"
+#include "graphics/vertex_array_object.hpp"
+
+namespace ascension::graphics {
+
+static constexpr u32 QUAD_VERTEX_COUNT = 4;
+static constexpr u32 QUAD_INDEX_COUNT = 6;
+// Position & texture coordinates.
+static constexpr u32 TILE_VERTEX_COMPONENT_COUNT = 4;
+static constexpr u32 CHUNK_TILE_COUNT = Tilemap::CHUNK_SIZE * Tilemap::CHUNK_SIZE;
+
+Tilemap::Tilemap()
+  : m_width(0)
+  , m_height(0)
+  , m_tile_size(0)
+  , m_position(0.0f)
+  , m_atlas_version(0)
+  , m_chunks_x(0)
+  , m_chunks_y(0)
+{
+}
+
+Tilemap::~Tilemap() = default;
+
+void
+Tilemap::create(
+    u32 width,
+    u32 height,
+    const v2u& tile_size,
+    const std::shared_ptr<Texture_Atlas>& atlas,
+    const std::shared_ptr<Shader>& shader
+)
+{
+    if (atlas == nullptr || shader == nullptr) {
+        core::log::error("Tilemap::create() attempting to create a tilemap without a texture atlas or shader");
+        return;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_tile_size = tile_size;
+    m_atlas = atlas;
+    m_atlas_version = atlas->version();
+    m_shader = shader;
+    m_tiles.assign(static_cast<size_t>(width) * height, EMPTY_TILE);
+
+    m_chunks_x = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_chunks_y = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_chunks.clear();
+    m_chunks.resize(static_cast<size_t>(m_chunks_x) * m_chunks_y);
+
+    if (m_ibo == nullptr) {
+        static const std::array<u32, 6> indices_template{ 0, 1, 2, 2, 3, 0 };
+        std::vector<u32> indices(static_cast<size_t>(QUAD_INDEX_COUNT) * CHUNK_TILE_COUNT);
+        for (u32 i = 0; i < CHUNK_TILE_COUNT; ++i) {
+            for (u32 j = 0; j < QUAD_INDEX_COUNT; ++j) {
+                indices[i * QUAD_INDEX_COUNT + j] = indices_template.at(j) + i * QUAD_VERTEX_COUNT;
+            }
+        }
+
+        m_ibo = std::make_shared<Index_Buffer_Object>();
+        m_ibo->create(static_cast<u32>(indices.size() * sizeof(u32)), indices.data());
+    }
+}
+
+void
+Tilemap::set_tile(u32 x, u32 y, Sub_Texture_Id tile)
+{
+    if (x >= m_width || y >= m_height) {
+        core::log::warn("Tilemap::set_tile() tile {}, {} is outside the {}x{} map", x, y, m_width, m_height);
+        return;
+    }
+
+    auto& current = m_tiles[static_cast<size_t>(y) * m_width + x];
+    if (current != tile) {
+        current = tile;
+        m_chunks[static_cast<size_t>(y / CHUNK_SIZE) * m_chunks_x + x / CHUNK_SIZE].is_dirty = true;
+    }
+}
+
+Sub_Texture_Id
+Tilemap::get_tile(u32 x, u32 y) const
+{
+    if (x >= m_width || y >= m_height) {
+        return EMPTY_TILE;
+    }
+
+    return m_tiles[static_cast<size_t>(y) * m_width + x];
+}
+
+void
+Tilemap::set_position(const v2f& position)
+{
+    // Chunk geometry is built in world space, so it all moves with the map.
+    if (position != m_position) {
+        m_position = position;
+        invalidate();
+    }
+}
+
+void
+Tilemap::set_sampler(const std::shared_ptr<Sampler>& sampler)
+{
+    m_sampler = sampler;
+}
+
+void
+Tilemap::invalidate()
+{
+    for (auto& chunk : m_chunks) {
+        chunk.is_dirty = true;
+    }
+}
+
+void
+Tilemap::draw(const v4f& view)
+{
+    PROFILE_FUNCTION();
+    PROFILE_GPU_SCOPE("Tilemap::draw");
+
+    if (m_chunks.empty()) {
+        return;
+    }
+
+    if (m_atlas_version != m_atlas->version()) {
+        m_atlas_version = m_atlas->version();
+        invalidate();
+    }
+
+    // The range of chunks overlapping the view, clamped to the map.
+    const v2f chunk_size = { static_cast<f32>(m_tile_size.x * CHUNK_SIZE), static_cast<f32>(m_tile_size.y * CHUNK_SIZE) };
+    const auto first_chunk = [](f32 offset, f32 size) { return static_cast<i64>(std::floor(offset / size)); };
+    const i64 x0 = std::max<i64>(first_chunk(view.x - m_position.x, chunk_size.x), 0);
+    const i64 y0 = std::max<i64>(first_chunk(view.y - m_position.y, chunk_size.y), 0);
+    const i64 x1 = std::min<i64>(first_chunk(view.z - m_position.x, chunk_size.x), i64{ m_chunks_x } - 1);
+    const i64 y1 = std::min<i64>(first_chunk(view.w - m_position.y, chunk_size.y), i64{ m_chunks_y } - 1);
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+
+    m_shader->bind();
+    m_atlas->get_texture()->bind();
+    if (m_sampler != nullptr) {
+        m_sampler->bind();
+    }
+    else {
+        Renderer_2D::get_default_sampler(*m_atlas->get_texture())->bind();
+    }
+
+    for (auto chunk_y = static_cast<u32>(y0); chunk_y <= static_cast<u32>(y1); ++chunk_y) {
+        for (auto chunk_x = static_cast<u32>(x0); chunk_x <= static_cast<u32>(x1); ++chunk_x) {
+            auto& chunk = m_chunks[static_cast<size_t>(chunk_y) * m_chunks_x + chunk_x];
+            if (chunk.is_dirty) {
+                build_chunk(chunk_x, chunk_y);
+            }
+            if (chunk.quad_count == 0) {
+                continue;
+            }
+
+            chunk.vao->bind();
+            m_ibo->draw_elements(static_cast<i32>(chunk.quad_count * QUAD_INDEX_COUNT), Draw_Mode::Triangles);
+            chunk.vao->unbind();
+
+            Renderer_2D::record_quads(chunk.quad_count);
+        }
+    }
+}
+
+u32
+Tilemap::width() const
+{
+    return m_width;
+}
+
+u32
+Tilemap::height() const
+{
+    return m_height;
+}
+
+void
+Tilemap::build_chunk(u32 chunk_x, u32 chunk_y)
+{
+    PROFILE_FUNCTION();
+
+    auto& chunk = m_chunks[static_cast<size_t>(chunk_y) * m_chunks_x + chunk_x];
+    chunk.is_dirty = false;
+
+    m_vertices.clear();
+    const u32 x_end = std::min((chunk_x + 1) * CHUNK_SIZE, m_width);
+    const u32 y_end = std::min((chunk_y + 1) * CHUNK_SIZE, m_height);
+    for (u32 y = chunk_y * CHUNK_SIZE; y < y_end; ++y) {
+        for (u32 x = chunk_x * CHUNK_SIZE; x < x_end; ++x) {
+            const Sub_Texture_Id tile = m_tiles[static_cast<size_t>(y) * m_width + x];
+            const auto* rect = tile != EMPTY_TILE ? m_atlas->find_sub_texture(tile) : nullptr;
+            if (rect == nullptr) {
+                continue;
+            }
+
+            const v4f& uv = rect->texture_coords;
+            const f32 left = m_position.x + static_cast<f32>(x * m_tile_size.x);
+            const f32 bottom = m_position.y + static_cast<f32>(y * m_tile_size.y);
+            const f32 right = left + static_cast<f32>(m_tile_size.x);
+            const f32 top = bottom + static_cast<f32>(m_tile_size.y);
+
+            // Wound as in Batch::add, bottom left, top left, top right then bottom right.
+            m_vertices.insert(
+                m_vertices.end(),
+                { left, bottom, uv.x, uv.y, left, top, uv.x, uv.w, right, top, uv.z, uv.w, right, bottom, uv.z, uv.y }
+            );
+        }
+    }
+
+    chunk.quad_count = static_cast<u32>(m_vertices.size() / (QUAD_VERTEX_COUNT * TILE_VERTEX_COMPONENT_COUNT));
+    if (chunk.quad_count == 0) {
+        return;
+    }
+
+    if (chunk.vao == nullptr) {
+        chunk.vao = std::make_unique<Vertex_Array_Object>();
+        chunk.vao->create(true);
+
+        chunk.vbo = std::make_shared<Vertex_Buffer_Object>();
+        chunk.vbo->create(sizeof(f32) * CHUNK_TILE_COUNT * QUAD_VERTEX_COUNT * TILE_VERTEX_COMPONENT_COUNT);
+        chunk.vbo->set_layout({ { Shader_Data_Type::Float, 2, false }, { Shader_Data_Type::Float, 2, false } });
+        chunk.vao->add_vertex_buffer(chunk.vbo);
+
+        // The element buffer binding is part of the vertex array's state, so it's bound to each chunk's.
+        m_ibo->bind();
+        chunk.vao->set_index_buffer(m_ibo);
+        chunk.vao->unbind();
+    }
+
+    chunk.vbo->buffer_data(static_cast<u32>(m_vertices.size() * sizeof(f32)), m_vertices.data());
+}
+
+}
@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-12 20:54:24
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-05-19 19:56:46
+ * Last Modified: 2026-10-18 15:30:22
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -30,6 +30,7 @@
 
 #include "core/log.hpp"
 #include "graphics/buffer_object.hpp"
+#include "graphics/renderer_2d.hpp"
 #include "graphics/shader_data_types.hpp"
 
 namespace {
@@ -53,6 +54,8 @@ shader_type_to_opengl(ascension::graphics::Shader_Data_Type type)
             return GL_INT;
         case ascension::graphics::Shader_Data_Type::Bool:
             return GL_BOOL;
+        case ascension::graphics::Shader_Data_Type::UByte:
+            return GL_UNSIGNED_BYTE;
         default:
             ascension::core::log::error("shader_type_to_opengl() Invalid shader_data_type {}", magic_enum::enum_name(type));
             return 0;
@@ -93,6 +96,7 @@ void
 Vertex_Array_Object::bind()
 {
     glBindVertexArray(m_id);
+    Renderer_2D::record_vertex_array_bind();
     m_is_bound = true;
 }
 
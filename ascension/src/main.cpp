@@ -3,7 +3,7 @@
  * Project: ascension
  * File Created: 2023-04-06 21:17:10
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-07-17 20:55:16
+ * Last Modified: 2026-10-18 14:23:41
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -24,6 +24,7 @@
 
 #include <SDL.h>
 
+#include "yuki/debug/flight_recorder.hpp"
 #include "yuki/debug/instrumentor.hpp"
 #include "yuki/debug/logger.hpp"
 
@@ -37,6 +38,13 @@ constexpr u32 WIN_DEFAULT_Y = 200;
 constexpr u32 WIN_DEFAULT_WIDTH = 1600;
 constexpr u32 WIN_DEFAULT_HEIGHT = 900;
 
+constexpr u64 LOG_MAX_FILE_SIZE = 16 * 1024 * 1024;
+constexpr std::chrono::hours LOG_MAX_FILE_AGE{ 24 };
+constexpr u32 LOG_MAX_ROTATED_FILES = 10;
+
+// Frames slower than this dump the flight recorder, about three missed frames at 60Hz.
+constexpr f64 FLIGHT_RECORDER_HITCH_MS = 50.0;
+
 int
 main(i32 argc, char** argv)
 {
@@ -46,7 +54,12 @@ main(i32 argc, char** argv)
     UNUSED_PARAM(argv);
 
     yuki::debug::Logger::initialize("logs/app.log", yuki::debug::Severity::LOG_DEBUG, true, true);
-    PROFILE_BEGIN_SESSION("ascension", "logs/timings.json");
+    yuki::debug::Logger::set_log_rotation({ LOG_MAX_FILE_SIZE, LOG_MAX_FILE_AGE, LOG_MAX_ROTATED_FILES, true });
+    yuki::debug::Logger::set_log_file_mode(yuki::debug::Log_File_Mode::MAPPED);
+    PROFILE_BEGIN_SESSION("ascension", "logs/timings.ytrace");
+
+    yuki::debug::Flight_Recorder::get().set_hitch_threshold(FLIGHT_RECORDER_HITCH_MS);
+    yuki::debug::Flight_Recorder::get().install_signal_handler();
 
     core::log::critical("Critical Test");
     core::log::error("Error Test");
@@ -59,10 +72,12 @@ main(i32 argc, char** argv)
     if (game.initialize("Ascension", WIN_DEFAULT_X, WIN_DEFAULT_Y, WIN_DEFAULT_WIDTH, WIN_DEFAULT_HEIGHT)) {
         const auto result = game.run();
 
+        yuki::debug::Flight_Recorder::get().shutdown();
         PROFILE_END_SESSION();
         return result;
     }
 
+    yuki::debug::Flight_Recorder::get().shutdown();
     PROFILE_END_SESSION();
     return 1;
 }
@@ -0,0 +1,106 @@
+/**
+ * File: test_animation_data.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 16:34:08
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:36:54
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/animation_data.hpp"
+
+#include "assets/sub_texture_data.hpp"
+#include "test.hpp"
+
+namespace {
+
+using ascension::graphics::Animation_Frame;
+using ascension::graphics::make_sub_texture_id;
+
+bool
+parse(const std::string& text, std::vector<Animation_Frame>& frames)
+{
+    return ascension::assets::parse_animation_data(reinterpret_cast<const u8*>(text.data()), text.size(), frames); // NOLINT
+}
+
+bool
+parse(const std::vector<u8>& data, std::vector<Animation_Frame>& frames)
+{
+    return ascension::assets::parse_animation_data(data.data(), data.size(), frames);
+}
+
+}
+
+TEST(animation_data_parses_text_in_play_order)
+{
+    std::vector<Animation_Frame> frames;
+    CHECK(parse("cherry 0.15\nstrawberry 0.15\r\ngrape 0.3\n", frames));
+    CHECK(frames.size() == 3);
+    CHECK(frames[0].sub_texture_id == make_sub_texture_id("cherry") && frames[0].duration == 0.15f);
+    CHECK(frames[1].sub_texture_id == make_sub_texture_id("strawberry"));
+    CHECK(frames[2].sub_texture_id == make_sub_texture_id("grape") && frames[2].duration == 0.3f);
+}
+
+TEST(animation_data_rejects_malformed_text)
+{
+    std::vector<Animation_Frame> frames;
+    CHECK(!parse("cherry", frames));
+    CHECK(!parse("cherry fast", frames));
+}
+
+TEST(animation_data_round_trips_binary)
+{
+    // Frames keep their order, unlike atlas sub-textures they aren't sorted.
+    const std::vector<Animation_Frame> written = {
+        { make_sub_texture_id("grape"), 0.3f },
+        { make_sub_texture_id("cherry"), 0.15f },
+        { make_sub_texture_id("grape"), 0.5f },
+    };
+
+    std::vector<Animation_Frame> frames;
+    CHECK(parse(ascension::assets::write_animation_data(written), frames));
+    CHECK(frames.size() == written.size());
+    for (size_t i = 0; i < frames.size() && i < written.size(); ++i) {
+        CHECK(frames[i].sub_texture_id == written[i].sub_texture_id && frames[i].duration == written[i].duration);
+    }
+}
+
+TEST(animation_data_rejects_truncated_binary)
+{
+    auto data = ascension::assets::write_animation_data({ { make_sub_texture_id("cherry"), 0.15f } });
+    data.pop_back();
+
+    std::vector<Animation_Frame> frames;
+    CHECK(!parse(data, frames));
+}
+
+TEST(sub_texture_data_header)
+{
+    const ascension::assets::Sub_Texture_Data_Magic magic = { 'T', 'E', 'S', 'T' };
+    const auto data = ascension::assets::make_sub_texture_data(magic, 2, 3, 8);
+    CHECK(data.size() == ascension::assets::SUB_TEXTURE_DATA_HEADER_SIZE + 3 * 8);
+    CHECK(ascension::assets::is_binary_sub_texture_data(data.data(), data.size(), magic));
+    CHECK(!ascension::assets::is_binary_sub_texture_data(data.data(), data.size(), { 'A', 'N', 'I', 'M' }));
+    // Text shorter than a header is never mistaken for binary data, even if it starts with the magic.
+    CHECK(!ascension::assets::is_binary_sub_texture_data(data.data(), 4, magic));
+
+    u32 count = 0;
+    CHECK(ascension::assets::read_sub_texture_data_header(data.data(), data.size(), 2, 8, count) && count == 3);
+    CHECK(!ascension::assets::read_sub_texture_data_header(data.data(), data.size(), 1, 8, count));
+    CHECK(!ascension::assets::read_sub_texture_data_header(data.data(), data.size(), 2, 9, count));
+}
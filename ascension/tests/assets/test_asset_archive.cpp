@@ -0,0 +1,191 @@
+/**
+ * File: test_asset_archive.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 16:37:29
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:39:11
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/asset_archive.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#include "test.hpp"
+
+namespace {
+
+using ascension::assets::Asset_Archive;
+using ascension::assets::Asset_Archive_Writer;
+using ascension::assets::Asset_Type;
+using ascension::assets::Block_Compression;
+using ascension::assets::make_asset_id;
+
+const std::string SHADER_SOURCE = "vertfragment";
+const std::vector<u8> PIXELS = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+
+Asset_Archive::Entry
+make_shader_entry()
+{
+    Asset_Archive::Entry entry;
+    entry.name = "shaders/sprite";
+    entry.type = Asset_Type::Shader;
+    entry.vertex_size = 4;
+    return entry;
+}
+
+// A 2x2 RGBA texture, 16 bytes of pixels.
+Asset_Archive::Entry
+make_texture_entry()
+{
+    Asset_Archive::Entry entry;
+    entry.name = "textures/unicorn";
+    entry.type = Asset_Type::Texture;
+    entry.width = 2;
+    entry.height = 2;
+    entry.channels = 4;
+    return entry;
+}
+
+std::string
+write_archive(const std::string& filename, const Asset_Archive::Entry& shader, const Asset_Archive::Entry& texture)
+{
+    Asset_Archive_Writer writer;
+    writer.add(shader, reinterpret_cast<const u8*>(SHADER_SOURCE.data()), SHADER_SOURCE.size()); // NOLINT
+    writer.add(texture, PIXELS.data(), PIXELS.size());
+
+    const auto filepath = ascension::tests::write_test_file(filename, "");
+    CHECK(writer.write(filepath));
+    return filepath;
+}
+
+std::string
+read_file(const std::string& filepath)
+{
+    std::ifstream file(filepath, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+    std::string data(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(data.data(), static_cast<std::streamsize>(data.size()));
+    return data;
+}
+
+bool
+opens(const std::string& filename, const std::string& data)
+{
+    Asset_Archive archive;
+    const bool is_open = archive.open(ascension::tests::write_test_file(filename, data));
+    CHECK(is_open == archive.is_open());
+    return is_open;
+}
+
+bool
+opens(const std::string& filename, const Asset_Archive::Entry& shader, const Asset_Archive::Entry& texture)
+{
+    return opens(filename, read_file(write_archive(filename, shader, texture)));
+}
+
+}
+
+TEST(asset_archive_round_trips_entries)
+{
+    Asset_Archive archive;
+    CHECK(archive.open(write_archive("round_trip.aarc", make_shader_entry(), make_texture_entry())));
+    CHECK(archive.entries(Asset_Type::Shader).size() == 1);
+    CHECK(archive.entries(Asset_Type::Texture).size() == 1);
+    CHECK(archive.entries(Asset_Type::Font).empty());
+
+    const auto* shader = archive.find(Asset_Type::Shader, make_asset_id("shaders/sprite"));
+    CHECK(shader && shader->vertex_size == 4 && shader->size == SHADER_SOURCE.size());
+    CHECK(shader && std::memcmp(archive.data(*shader), SHADER_SOURCE.data(), SHADER_SOURCE.size()) == 0);
+
+    const auto* texture = archive.find(Asset_Type::Texture, make_asset_id("textures/unicorn"));
+    CHECK(texture && texture->width == 2 && texture->height == 2 && texture->channels == 4);
+    CHECK(texture && texture->offset % Asset_Archive::DATA_ALIGNMENT == 0);
+    CHECK(texture && std::memcmp(archive.data(*texture), PIXELS.data(), PIXELS.size()) == 0);
+
+    // Names are only unique per type.
+    CHECK(!archive.find(Asset_Type::Texture, make_asset_id("shaders/sprite")));
+}
+
+TEST(asset_archive_rejects_malformed_files)
+{
+    const auto data = read_file(write_archive("malformed.aarc", make_shader_entry(), make_texture_entry()));
+    CHECK(opens("valid.aarc", data));
+
+    CHECK(!opens("empty.aarc", ""));
+    CHECK(!opens("magic.aarc", "XXXX" + data.substr(4)));
+    CHECK(!opens("truncated.aarc", data.substr(0, data.size() - 1)));
+
+    auto version = data;
+    version[4] = static_cast<char>(Asset_Archive::VERSION + 1);
+    CHECK(!opens("version.aarc", version));
+
+    auto index_offset = data;
+    std::memset(index_offset.data() + 12, 0xFF, sizeof(u64));
+    CHECK(!opens("index_offset.aarc", index_offset));
+
+    // The shader is the first entry, its offset follows the name, the empty dependency & the type.
+    u64 index = 0;
+    std::memcpy(&index, data.data() + 12, sizeof(index));
+    const auto offset_field = index + sizeof(u32) + make_shader_entry().name.size() + sizeof(u32) + sizeof(u32);
+
+    auto entry_offset = data;
+    std::memset(entry_offset.data() + offset_field, 0xFF, sizeof(u64));
+    CHECK(!opens("entry_offset.aarc", entry_offset));
+
+    // In bounds on its own, but running past the end of the file.
+    auto entry_size = data;
+    const u64 size = data.size();
+    std::memcpy(entry_size.data() + offset_field + sizeof(u64), &size, sizeof(size));
+    CHECK(!opens("entry_size.aarc", entry_size));
+}
+
+TEST(asset_archive_rejects_entries_smaller_than_their_contents)
+{
+    auto shader = make_shader_entry();
+    shader.vertex_size = static_cast<u32>(SHADER_SOURCE.size() + 1);
+    CHECK(!opens("vertex_size.aarc", shader, make_texture_entry()));
+
+    auto texture = make_texture_entry();
+    texture.width = 4;
+    CHECK(!opens("texture_size.aarc", make_shader_entry(), texture));
+
+    // The 3 channel textures are uploaded as RGB, 2x2 fits.
+    texture = make_texture_entry();
+    texture.channels = 3;
+    CHECK(opens("rgb.aarc", make_shader_entry(), texture));
+
+    // A 4x4 BC1 block is 8 bytes, 8x8 is 4 blocks.
+    texture = make_texture_entry();
+    texture.compression = Block_Compression::BC1;
+    CHECK(opens("bc1.aarc", make_shader_entry(), texture));
+    texture.width = 8;
+    texture.height = 8;
+    CHECK(!opens("bc1_size.aarc", make_shader_entry(), texture));
+
+    texture = make_texture_entry();
+    texture.mip_levels = 2;
+    CHECK(!opens("mip_size.aarc", make_shader_entry(), texture));
+    texture.mip_levels = 0;
+    CHECK(!opens("no_mips.aarc", make_shader_entry(), texture));
+
+    texture = make_texture_entry();
+    texture.compression = static_cast<Block_Compression>(99);
+    CHECK(!opens("compression.aarc", make_shader_entry(), texture));
+}
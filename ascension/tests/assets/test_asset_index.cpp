@@ -0,0 +1,218 @@
+/**
+ * File: test_asset_index.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 16:30:45
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:33:40
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/asset_index.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#include <fmt/format.h>
+
+#include "assets/asset_manifest.hpp"
+#include "test.hpp"
+
+namespace {
+
+using ascension::assets::Asset_Index;
+using ascension::assets::Asset_Manifest;
+using ascension::assets::make_asset_id;
+
+// A manifest with one of every kind of record: authored & generated atlases, their textures, a shader & an animation.
+std::string
+write_manifest(const std::string& prefix, const std::string& textures)
+{
+    const auto textures_filepath = ascension::tests::write_test_file(prefix + "_textures.xml", textures);
+    const auto shaders_filepath = ascension::tests::write_test_file(
+        prefix + "_shaders.xml",
+        R"(<assets>
+            <asset name="sprite" type="Shader" filepath="assets/shaders/">
+                <vertex>sprite.vert</vertex>
+                <fragment>sprite.frag</fragment>
+            </asset>
+        </assets>)"
+    );
+    const auto animations_filepath = ascension::tests::write_test_file(
+        prefix + "_animations.xml",
+        R"(<assets>
+            <asset name="spin" type="Animation" filepath="assets/animations/spin.anim">
+                <texture_atlas>textures/fruits</texture_atlas>
+            </asset>
+        </assets>)"
+    );
+
+    return ascension::tests::write_test_file(
+        prefix + ".xml",
+        fmt::format(
+            R"(<assets>
+                <asset name="textures" type="Asset_List" filepath="{}" />
+                <asset name="shaders" type="Asset_List" filepath="{}" />
+                <asset name="animations" type="Asset_List" filepath="{}" />
+            </assets>)",
+            textures_filepath,
+            shaders_filepath,
+            animations_filepath
+        )
+    );
+}
+
+constexpr const char* TEXTURES = R"(<assets>
+    <asset name="unicorn" type="Texture" filepath="assets/textures/unicorn.png">
+        <scale>0.5</scale>
+        <mipmaps>1</mipmaps>
+        <atlas>sprites</atlas>
+    </asset>
+    <asset name="wabbit" type="Texture" filepath="assets/textures/wabbit.png">
+        <atlas>sprites</atlas>
+    </asset>
+    <asset name="fruits" type="Texture_Atlas" filepath="assets/textures/fruits.dat">
+        <asset name="fruits" type="Texture" filepath="assets/textures/fruits.png" />
+    </asset>
+</assets>)";
+
+bool
+build_index(Asset_Index& index, const std::string& prefix, const std::string& textures)
+{
+    Asset_Manifest manifest;
+    return manifest.load(write_manifest(prefix, textures)) && index.build(manifest);
+}
+
+void
+check_index(const Asset_Index& index)
+{
+    using ascension::assets::Asset_Type;
+
+    CHECK(index.size() == 8);
+    CHECK(index.count(Asset_Type::Texture) == 4);
+    CHECK(index.count(Asset_Type::Texture_Atlas) == 2);
+
+    const auto unicorn = index.find_texture(make_asset_id("textures/unicorn"));
+    CHECK(unicorn && unicorn->name == "unicorn" && unicorn->filepath == "assets/textures/unicorn.png");
+    CHECK(unicorn && unicorn->scale == 0.5f && unicorn->mipmaps && unicorn->atlas == "textures/sprites");
+
+    const auto fruits = index.find_texture_atlas(make_asset_id("textures/fruits"));
+    CHECK(fruits && !fruits->is_generated && fruits->sub_texture_id == "textures/fruits");
+    CHECK(index.find_texture(make_asset_id("textures/fruits")).has_value());
+
+    const auto sprites = index.find_texture_atlas(make_asset_id("textures/sprites"));
+    CHECK(sprites && sprites->is_generated);
+    const auto page = index.find_texture(make_asset_id("textures/sprites"));
+    CHECK(page && page->is_atlas_page);
+    CHECK(index.find_atlas_members("textures/sprites").size() == 2);
+
+    const auto shader = index.find_shader(make_asset_id("shaders/sprite"));
+    CHECK(shader && shader->vertex_src_file == "sprite.vert" && shader->fragment_src_file == "sprite.frag");
+    const auto animation = index.find_animation(make_asset_id("animations/spin"));
+    CHECK(animation && animation->texture_atlas == "textures/fruits");
+
+    // Unknown ids still land on a slot, & the same id looked up as another type is a different key.
+    CHECK(!index.find_texture(make_asset_id("textures/missing")));
+    CHECK(!index.find_shader(make_asset_id("textures/unicorn")));
+    CHECK(!index.find_font(make_asset_id("shaders/sprite")));
+}
+
+std::string
+read_file(const std::string& filepath)
+{
+    std::ifstream file(filepath, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+    std::string data(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(data.data(), static_cast<std::streamsize>(data.size()));
+    return data;
+}
+
+}
+
+TEST(asset_index_finds_every_asset)
+{
+    Asset_Index index;
+    CHECK(build_index(index, "index", TEXTURES));
+    check_index(index);
+}
+
+TEST(asset_index_hash_places_every_record)
+{
+    std::string textures = "<assets>";
+    for (u32 i = 0; i < 1000; ++i) {
+        textures += fmt::format(R"(<asset name="texture_{0}" type="Texture" filepath="texture_{0}.png" />)", i);
+    }
+    textures += "</assets>";
+
+    Asset_Index index;
+    CHECK(build_index(index, "many", textures));
+    for (u32 i = 0; i < 1000; ++i) {
+        const auto texture = index.find_texture(make_asset_id(fmt::format("textures/texture_{}", i)));
+        CHECK(texture && texture->name == fmt::format("texture_{}", i));
+        CHECK(!index.find_texture(make_asset_id(fmt::format("textures/missing_{}", i))));
+    }
+}
+
+TEST(asset_index_rejects_duplicate_ids)
+{
+    // The generated atlas "fruits" has the same name, & so the same id, as the authored one.
+    const std::string textures = R"(<assets>
+        <asset name="cherry" type="Texture" filepath="assets/textures/cherry.png">
+            <atlas>fruits</atlas>
+        </asset>
+        <asset name="fruits" type="Texture_Atlas" filepath="assets/textures/fruits.dat">
+            <asset name="fruits" type="Texture" filepath="assets/textures/fruits.png" />
+        </asset>
+    </assets>)";
+
+    Asset_Index index;
+    CHECK(!build_index(index, "duplicate", textures));
+    CHECK(index.size() == 0);
+}
+
+TEST(asset_index_round_trips_through_a_file)
+{
+    Asset_Index index;
+    CHECK(build_index(index, "round_trip", TEXTURES));
+    const auto filepath = ascension::tests::write_test_file("round_trip.idx", "");
+    CHECK(index.write(filepath));
+
+    Asset_Index loaded;
+    CHECK(loaded.load(filepath));
+    check_index(loaded);
+}
+
+TEST(asset_index_rejects_malformed_files)
+{
+    Asset_Index index;
+    CHECK(build_index(index, "malformed", TEXTURES));
+    const auto filepath = ascension::tests::write_test_file("malformed.idx", "");
+    CHECK(index.write(filepath));
+    const auto data = read_file(filepath);
+
+    Asset_Index loaded;
+    CHECK(!loaded.load(ascension::tests::write_test_file("truncated.idx", data.substr(0, data.size() / 2))));
+    CHECK(!loaded.load(ascension::tests::write_test_file("magic.idx", "XXXX" + data.substr(4))));
+
+    // The first slot follows the header & the bucket displacements, point it past the records.
+    u32 bucket_count = 0;
+    std::memcpy(&bucket_count, data.data() + 12, sizeof(bucket_count));
+    auto bad_slot = data;
+    std::memset(bad_slot.data() + 20 + bucket_count * sizeof(u32), 0xFF, sizeof(u32));
+    CHECK(!loaded.load(ascension::tests::write_test_file("bad_slot.idx", bad_slot)));
+    CHECK(loaded.size() == 0);
+}
@@ -0,0 +1,109 @@
+/**
+ * File: test_atlas_data.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 16:34:08
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:36:12
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/atlas_data.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "test.hpp"
+
+namespace {
+
+using ascension::graphics::make_sub_texture_id;
+using ascension::graphics::Sub_Texture_Region;
+
+bool
+parse(const std::string& text, std::vector<Sub_Texture_Region>& sub_textures)
+{
+    return ascension::assets::parse_atlas_data(reinterpret_cast<const u8*>(text.data()), text.size(), sub_textures); // NOLINT
+}
+
+bool
+parse(const std::vector<u8>& data, std::vector<Sub_Texture_Region>& sub_textures)
+{
+    return ascension::assets::parse_atlas_data(data.data(), data.size(), sub_textures);
+}
+
+}
+
+TEST(atlas_data_parses_text)
+{
+    // Blank lines, tabs & windows line endings are all skipped.
+    std::vector<Sub_Texture_Region> sub_textures;
+    CHECK(parse("watermelon 0 64 64 128\r\n\n  pear\t0 0 32 32", sub_textures));
+    CHECK(sub_textures.size() == 2);
+    CHECK(sub_textures[0].id == make_sub_texture_id("watermelon") && sub_textures[0].region == v4u(0, 64, 64, 128));
+    CHECK(sub_textures[1].id == make_sub_texture_id("pear") && sub_textures[1].region == v4u(0, 0, 32, 32));
+
+    CHECK(parse("", sub_textures) && sub_textures.empty());
+}
+
+TEST(atlas_data_rejects_malformed_text)
+{
+    std::vector<Sub_Texture_Region> sub_textures;
+    CHECK(!parse("watermelon 0 64 x 128", sub_textures));
+    CHECK(!parse("watermelon 0 64", sub_textures));
+    CHECK(!parse("watermelon 0 64 -64 128", sub_textures));
+}
+
+TEST(atlas_data_round_trips_binary_sorted_by_id)
+{
+    const std::vector<Sub_Texture_Region> written = {
+        { make_sub_texture_id("watermelon"), { 0, 64, 64, 128 } },
+        { make_sub_texture_id("pineapple"), { 64, 64, 128, 128 } },
+        { make_sub_texture_id("pear"), { 0, 0, 32, 32 } },
+    };
+
+    std::vector<Sub_Texture_Region> sub_textures;
+    CHECK(parse(ascension::assets::write_atlas_data(written), sub_textures));
+    CHECK(sub_textures.size() == written.size());
+    for (size_t i = 0; i < sub_textures.size(); ++i) {
+        CHECK(i == 0 || sub_textures[i - 1].id < sub_textures[i].id);
+
+        const auto region = std::find_if(written.begin(), written.end(), [&](const Sub_Texture_Region& sub_texture) {
+            return sub_texture.id == sub_textures[i].id;
+        });
+        CHECK(region != written.end() && region->region == sub_textures[i].region);
+    }
+}
+
+TEST(atlas_data_rejects_malformed_binary)
+{
+    const auto data = ascension::assets::write_atlas_data({ { make_sub_texture_id("pear"), { 0, 0, 32, 32 } } });
+    std::vector<Sub_Texture_Region> sub_textures;
+
+    auto truncated = data;
+    truncated.pop_back();
+    CHECK(!parse(truncated, sub_textures));
+
+    // The version & then the count follow the magic.
+    auto wrong_version = data;
+    wrong_version[4] = 0xFF;
+    CHECK(!parse(wrong_version, sub_textures));
+
+    auto huge_count = data;
+    std::memset(huge_count.data() + 8, 0xFF, sizeof(u32));
+    CHECK(!parse(huge_count, sub_textures));
+}
@@ -0,0 +1,115 @@
+/**
+ * File: test_block_compression.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 16:16:00
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:17:33
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/block_compression.hpp"
+
+#include <cstdlib>
+
+#include "test.hpp"
+
+namespace {
+
+using ascension::assets::Block_Compression;
+
+// The largest difference of any channel between the source & the decoded RGBA image.
+i32
+get_max_error(const std::vector<u8>& rgba, const std::vector<u8>& decoded)
+{
+    i32 max_error = 0;
+    for (size_t i = 0; i < rgba.size(); ++i) {
+        max_error = std::max(max_error, std::abs(i32{ rgba[i] } - i32{ decoded[i] }));
+    }
+    return max_error;
+}
+
+std::vector<u8>
+round_trip(Block_Compression compression, const std::vector<u8>& rgba, u32 width, u32 height)
+{
+    const auto blocks = ascension::assets::compress_blocks(compression, rgba.data(), width, height, 4);
+    return ascension::assets::decompress_blocks(compression, blocks.data(), width, height);
+}
+
+}
+
+TEST(bc1_keeps_a_red_to_green_gradient)
+{
+    // Orthogonal to 1, 1, 1, every texel has the same channel sum.
+    const u8 reds[] = { 255, 170, 85, 0 };
+    std::vector<u8> rgba;
+    for (u32 y = 0; y < 4; ++y) {
+        for (const u8 red : reds) {
+            rgba.insert(rgba.end(), { red, static_cast<u8>(255 - red), 0, 255 });
+        }
+    }
+
+    const auto decoded = round_trip(Block_Compression::BC1, rgba, 4, 4);
+    CHECK(decoded.size() == rgba.size());
+    CHECK(get_max_error(rgba, decoded) <= 8);
+    CHECK(decoded[0] > 240 && decoded[1] < 16);
+    CHECK(decoded[12] < 16 && decoded[13] > 240);
+}
+
+TEST(bc1_keeps_a_flat_block)
+{
+    std::vector<u8> rgba;
+    for (u32 i = 0; i < 16; ++i) {
+        rgba.insert(rgba.end(), { 200, 100, 50, 255 });
+    }
+
+    const auto decoded = round_trip(Block_Compression::BC1, rgba, 4, 4);
+    CHECK(decoded.size() == rgba.size());
+    // Only the 565 quantization is lost.
+    CHECK(get_max_error(rgba, decoded) <= 4);
+}
+
+TEST(bc3_keeps_alpha_gradient)
+{
+    std::vector<u8> rgba;
+    for (u32 i = 0; i < 16; ++i) {
+        rgba.insert(rgba.end(), { 128, 128, 128, static_cast<u8>(i * 17) });
+    }
+
+    const auto decoded = round_trip(Block_Compression::BC3, rgba, 4, 4);
+    CHECK(decoded.size() == rgba.size());
+    CHECK(get_max_error(rgba, decoded) <= 20);
+    CHECK(decoded[3] == 0 && decoded[63] == 255);
+}
+
+TEST(block_compression_pads_partial_blocks)
+{
+    // 5x3 is two blocks wide & one high, the partial blocks repeat the edge texels.
+    std::vector<u8> rgba(5 * 3 * 4, 255);
+    CHECK(ascension::assets::get_block_compressed_size(Block_Compression::BC1, 5, 3) == 16);
+    CHECK(ascension::assets::get_block_compressed_size(Block_Compression::BC3, 5, 3) == 32);
+    CHECK(get_max_error(rgba, round_trip(Block_Compression::BC1, rgba, 5, 3)) == 0);
+}
+
+TEST(block_compression_chooses_bc3_for_alpha)
+{
+    std::vector<u8> rgba(4 * 4 * 4, 255);
+    CHECK(ascension::assets::choose_block_compression(rgba.data(), 4, 4, 4) == Block_Compression::BC1);
+    rgba[7] = 128;
+    CHECK(ascension::assets::choose_block_compression(rgba.data(), 4, 4, 4) == Block_Compression::BC3);
+    CHECK(ascension::assets::choose_block_compression(rgba.data(), 4, 4, 2) == Block_Compression::None);
+}
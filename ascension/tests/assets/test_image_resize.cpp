@@ -0,0 +1,90 @@
+/**
+ * File: test_image_resize.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 16:29:05
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:29:16
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "assets/image_resize.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "test.hpp"
+
+namespace {
+
+using ascension::assets::Resize_Filter;
+
+constexpr Resize_Filter FILTERS[] = { Resize_Filter::Box, Resize_Filter::Bilinear, Resize_Filter::Lanczos3 };
+
+bool
+is_near(u8 value, i32 expected, i32 tolerance = 1)
+{
+    return std::abs(i32{ value } - expected) <= tolerance;
+}
+
+}
+
+TEST(resize_scaled_length_is_never_zero)
+{
+    CHECK(ascension::assets::get_scaled_length(100, 0.5f) == 50);
+    CHECK(ascension::assets::get_scaled_length(3, 0.1f) == 1);
+}
+
+TEST(resize_keeps_flat_images_flat)
+{
+    // The weights of every filter sum to one, so a flat image never gains ringing or darkens at the edges.
+    const std::vector<u8> rgba(16 * 16 * 4, 96);
+    for (const auto filter : FILTERS) {
+        for (const u32 size : { 5U, 37U }) {
+            const auto resized = ascension::assets::resize_image(rgba.data(), 16, 16, 4, size, size, filter);
+            CHECK(resized.size() == size * size * 4);
+            CHECK(std::all_of(resized.begin(), resized.end(), [](u8 value) { return is_near(value, 96); }));
+        }
+    }
+}
+
+TEST(resize_box_averages_when_shrinking)
+{
+    const u8 stripes[] = { 0, 255, 0, 255 };
+    const auto resized = ascension::assets::resize_image(stripes, 4, 1, 1, 2, 1, Resize_Filter::Box);
+    CHECK(resized.size() == 2);
+    CHECK(is_near(resized[0], 128) && is_near(resized[1], 128));
+}
+
+TEST(resize_box_is_nearest_when_enlarging)
+{
+    const u8 texels[] = { 10, 200 };
+    const auto resized = ascension::assets::resize_image(texels, 2, 1, 1, 4, 1, Resize_Filter::Box);
+    CHECK(resized == std::vector<u8>({ 10, 10, 200, 200 }));
+}
+
+TEST(resize_doesnt_bleed_transparent_colour)
+{
+    // Opaque red next to fully transparent green, filtered premultiplied the result stays red.
+    const u8 texels[] = { 255, 0, 0, 255, 0, 255, 0, 0 };
+    for (const auto filter : FILTERS) {
+        const auto resized = ascension::assets::resize_image(texels, 2, 1, 4, 1, 1, filter);
+        CHECK(resized.size() == 4);
+        CHECK(is_near(resized[0], 255) && is_near(resized[1], 0) && is_near(resized[2], 0));
+        CHECK(is_near(resized[3], 128, 2));
+    }
+}
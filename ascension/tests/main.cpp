@@ -0,0 +1,98 @@
+/**
+ * File: main.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 16:16:00
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:33:40
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "test.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace ascension::tests {
+
+namespace {
+
+u32 s_failures = 0;
+
+std::filesystem::path
+get_test_directory()
+{
+    return std::filesystem::temp_directory_path() / "ascension_tests";
+}
+
+}
+
+std::vector<Test_Case>&
+get_test_cases()
+{
+    static std::vector<Test_Case> test_cases;
+    return test_cases;
+}
+
+bool
+register_test(const char* name, void (*function)())
+{
+    get_test_cases().push_back({ name, function });
+    return true;
+}
+
+void
+report_failure(const char* file, i32 line, const char* expression)
+{
+    std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expression);
+    ++s_failures;
+}
+
+std::string
+write_test_file(const std::string& filename, const std::string& contents)
+{
+    const auto filepath = get_test_directory() / filename;
+    std::ofstream file(filepath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    file << contents;
+    return filepath.string();
+}
+
+}
+
+int
+main()
+{
+    using namespace ascension::tests;
+
+    std::error_code error;
+    std::filesystem::remove_all(get_test_directory(), error);
+    std::filesystem::create_directories(get_test_directory());
+
+    u32 failed_tests = 0;
+    for (const auto& test_case : get_test_cases()) {
+        const u32 failures = s_failures;
+        test_case.function();
+        if (s_failures != failures) {
+            std::fprintf(stderr, "FAILED %s\n", test_case.name);
+            ++failed_tests;
+        }
+    }
+
+    std::printf("%zu tests, %u failed\n", get_test_cases().size(), failed_tests);
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+/**
+ * File: test.hpp
+ * Project: ascension
+ * File Created: 2026-10-18 16:16:00
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:33:40
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <vector>
+
+namespace ascension::tests {
+
+// A minimal harness for the engine's pure logic, tests register themselves with TEST & CHECK records a failure without
+// stopping the test so one run reports every broken expectation.
+struct Test_Case {
+    const char* name;
+    void (*function)();
+};
+
+std::vector<Test_Case>& get_test_cases();
+bool register_test(const char* name, void (*function)());
+void report_failure(const char* file, i32 line, const char* expression);
+
+// Write a file into the scratch directory, which is emptied before the tests run. Returns the file's path.
+std::string write_test_file(const std::string& filename, const std::string& contents);
+
+}
+
+#define TEST(name)                                                                                                   \
+    static void name();                                                                                              \
+    static const bool name##_registered = ::ascension::tests::register_test(#name, name);                            \
+    static void name()
+
+#define CHECK(expression)                                                                                            \
+    do {                                                                                                             \
+        if (!(expression)) {                                                                                         \
+            ::ascension::tests::report_failure(__FILE__, __LINE__, #expression);                                     \
+        }                                                                                                            \
+    } while (false)
@@ -0,0 +1,470 @@
+/**
+ * File: main.cpp
+ * Project: ascension
+ * File Created: 2026-10-18 14:26:57
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:18:17
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <unordered_set>
+
+#define STBI_NO_THREAD_LOCALS
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb/stb_image.h>
+
+#include "yuki/debug/logger.hpp"
+
+#include "assets/animation_data.hpp"
+#include "assets/asset_archive.hpp"
+#include "assets/asset_index.hpp"
+#include "assets/asset_manifest.hpp"
+#include "assets/atlas_builder.hpp"
+#include "assets/atlas_data.hpp"
+#include "assets/block_compression.hpp"
+#include "assets/image_resize.hpp"
+
+namespace {
+
+using namespace ascension::assets;
+
+void
+print_usage()
+{
+    std::cerr << "usage: ascension_asset_packer <assets.xml> [-o <assets.pak>] [--compress] [--index <assets.idx>]\n"
+              << "  -o          Pack every asset referenced by the manifest into a single archive, textures are stored\n"
+              << "              decoded along with their mip chain if the manifest asks for <mipmaps>.\n"
+              << "  --compress  Block compress packed textures, BC1 when opaque & BC3 with alpha.\n"
+              << "  --index     Compile the manifests into an asset index, loaded in place of the xml manifests.\n";
+}
+
+bool
+read_file(const std::string& filepath, std::vector<u8>& data)
+{
+    std::ifstream file(filepath, std::ifstream::in | std::ifstream::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open " << filepath << "\n";
+        return false;
+    }
+
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// unordered_map order changes between runs, sort so the same assets always produce the same archive.
+template<typename T>
+std::vector<std::string>
+get_sorted_names(const std::unordered_map<std::string, T>& assets)
+{
+    std::vector<std::string> names;
+    names.reserve(assets.size());
+    for (const auto& [name, asset] : assets) {
+        names.push_back(name);
+    }
+
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+// Halve an image with a 2x2 box filter, odd edges average the last texel with itself.
+std::vector<u8>
+downsample(const u8* pixels, u32 width, u32 height, u32 channels)
+{
+    const u32 next_width = std::max(width / 2, 1U);
+    const u32 next_height = std::max(height / 2, 1U);
+
+    std::vector<u8> next(static_cast<size_t>(next_width) * next_height * channels);
+    for (u32 y = 0; y < next_height; ++y) {
+        const u32 y0 = std::min(y * 2, height - 1);
+        const u32 y1 = std::min(y * 2 + 1, height - 1);
+        for (u32 x = 0; x < next_width; ++x) {
+            const u32 x0 = std::min(x * 2, width - 1);
+            const u32 x1 = std::min(x * 2 + 1, width - 1);
+            for (u32 c = 0; c < channels; ++c) {
+                const auto texel = [&](u32 texel_x, u32 texel_y) -> u32 {
+                    return pixels[(static_cast<size_t>(texel_y) * width + texel_x) * channels + c]; // NOLINT
+                };
+                const u32 sum = texel(x0, y0) + texel(x1, y0) + texel(x0, y1) + texel(x1, y1);
+                next[(static_cast<size_t>(y) * next_width + x) * channels + c] = static_cast<u8>((sum + 2) / 4);
+            }
+        }
+    }
+
+    return next;
+}
+
+struct Image {
+    std::vector<u8> pixels;
+    u32 width{ 0 };
+    u32 height{ 0 };
+    u32 channels{ 0 };
+};
+
+bool
+load_image(const Texture_Asset& asset, Image& image)
+{
+    stbi_set_flip_vertically_on_load(asset.flip_on_load ? 1 : 0);
+
+    i32 width = 0;
+    i32 height = 0;
+    i32 file_channels = 0;
+    // Textures are RGB or RGBA, grey & grey-alpha images are expanded to RGBA while decoding.
+    stbi_info(asset.filepath.c_str(), &width, &height, &file_channels);
+    const i32 channels = file_channels == 3 ? 3 : 4;
+    auto* const data = stbi_load(asset.filepath.c_str(), &width, &height, &file_channels, channels);
+    if (data == nullptr) {
+        std::cerr << "Failed to decode texture " << asset.filepath << ": " << stbi_failure_reason() << "\n";
+        return false;
+    }
+
+    image.width = static_cast<u32>(width);
+    image.height = static_cast<u32>(height);
+    image.channels = static_cast<u32>(channels);
+
+    const auto byte_size = static_cast<u64>(width) * static_cast<u64>(height) * static_cast<u64>(channels);
+    image.pixels.assign(data, data + byte_size); // NOLINT
+    stbi_image_free(data);
+
+    // Scaled here so packed textures load at their final size, with nothing left to resample at runtime.
+    if (asset.scale > 0.0f && asset.scale != 1.0f) {
+        const u32 scaled_width = get_scaled_length(image.width, asset.scale);
+        const u32 scaled_height = get_scaled_length(image.height, asset.scale);
+        image.pixels = resize_image(
+            image.pixels.data(), image.width, image.height, image.channels, scaled_width, scaled_height, asset.scale_filter
+        );
+        image.width = scaled_width;
+        image.height = scaled_height;
+    }
+
+    return true;
+}
+
+void
+add_texture(Asset_Archive_Writer& writer, const std::string& name, Image image, bool mipmaps, bool compress)
+{
+    Asset_Archive::Entry entry;
+    entry.name = name;
+    entry.type = Asset_Type::Texture;
+    entry.width = image.width;
+    entry.height = image.height;
+    entry.channels = image.channels;
+
+    if (compress) {
+        entry.compression = choose_block_compression(image.pixels.data(), entry.width, entry.height, entry.channels);
+    }
+
+    // Levels are stored one after another down to 1x1. The chain is built here rather than on the GPU at load
+    // as block compressed textures can't have their mips generated.
+    std::vector<u8> levels;
+    std::vector<u8>& level = image.pixels;
+    u32 level_width = entry.width;
+    u32 level_height = entry.height;
+    for (entry.mip_levels = 1;; ++entry.mip_levels) {
+        if (entry.compression != Block_Compression::None) {
+            const auto blocks = compress_blocks(entry.compression, level.data(), level_width, level_height, entry.channels);
+            levels.insert(levels.end(), blocks.begin(), blocks.end());
+        }
+        else {
+            levels.insert(levels.end(), level.begin(), level.end());
+        }
+
+        if (!mipmaps || (level_width == 1 && level_height == 1)) {
+            break;
+        }
+
+        level = downsample(level.data(), level_width, level_height, entry.channels);
+        level_width = std::max(level_width / 2, 1U);
+        level_height = std::max(level_height / 2, 1U);
+    }
+
+    writer.add(entry, levels.data(), levels.size());
+}
+
+bool
+pack_texture(Asset_Archive_Writer& writer, const std::string& name, const Texture_Asset& asset, bool compress)
+{
+    Image image;
+    if (!load_image(asset, image)) {
+        return false;
+    }
+
+    add_texture(writer, name, std::move(image), asset.mipmaps, compress);
+    return true;
+}
+
+// Pack the textures marked with this <atlas> into one page, written as a texture & a texture atlas both named after
+// the atlas. Returns the textures placed in the page, any that didn't fit are packed on their own.
+bool
+pack_generated_atlas(
+    Asset_Archive_Writer& writer,
+    const std::string& atlas,
+    const std::vector<std::string>& members,
+    const std::unordered_map<std::string, Texture_Asset>& textures,
+    bool compress,
+    std::unordered_set<std::string>& packed
+)
+{
+    std::vector<Image> images(members.size());
+    std::vector<v2u> sizes;
+    sizes.reserve(members.size());
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (!load_image(textures.at(members[i]), images[i])) {
+            return false;
+        }
+        sizes.emplace_back(images[i].width, images[i].height);
+    }
+
+    const auto layout = pack_atlas(sizes);
+    Image page;
+    page.width = layout.width;
+    page.height = layout.height;
+    page.channels = 4;
+    page.pixels.resize(size_t{ layout.width } * layout.height * 4, 0);
+
+    std::vector<ascension::graphics::Sub_Texture_Region> sub_textures;
+    for (size_t i = 0; i < members.size(); ++i) {
+        const auto& region = layout.regions[i];
+        if (region.z == region.x) {
+            std::cerr << "Texture " << members[i] << " doesn't fit in atlas " << atlas << ", packing it on its own\n";
+            continue;
+        }
+
+        blit_atlas_image(images[i].pixels.data(), images[i].channels, region, page.pixels.data(), page.width, page.height);
+        sub_textures.push_back({ ascension::graphics::make_sub_texture_id(textures.at(members[i]).name), region });
+        packed.insert(members[i]);
+    }
+
+    if (sub_textures.empty()) {
+        return true;
+    }
+
+    add_texture(writer, atlas, std::move(page), false, compress);
+
+    Asset_Archive::Entry entry;
+    entry.name = atlas;
+    entry.dependency = atlas;
+    entry.type = Asset_Type::Texture_Atlas;
+    const auto data = write_atlas_data(std::move(sub_textures));
+    writer.add(entry, data.data(), data.size());
+    return true;
+}
+
+bool
+pack_texture_atlas(Asset_Archive_Writer& writer, const std::string& name, const Texture_Atlas_Asset& asset)
+{
+    std::vector<u8> text;
+    std::vector<ascension::graphics::Sub_Texture_Region> sub_textures;
+    if (!read_file(asset.filepath, text)) {
+        return false;
+    }
+    if (!parse_atlas_data(text.data(), text.size(), sub_textures)) {
+        std::cerr << "Failed to parse texture atlas " << asset.filepath << "\n";
+        return false;
+    }
+
+    Asset_Archive::Entry entry;
+    entry.name = name;
+    entry.dependency = asset.sub_texture_id;
+    entry.type = Asset_Type::Texture_Atlas;
+
+    // Stored sorted by id, so the atlas loads with a copy rather than parsing & sorting the text.
+    const auto data = write_atlas_data(std::move(sub_textures));
+    writer.add(entry, data.data(), data.size());
+    return true;
+}
+
+bool
+pack_shader(Asset_Archive_Writer& writer, const std::string& name, const Shader_Asset& asset)
+{
+    std::vector<u8> data;
+    std::vector<u8> fragment_data;
+    if (!read_file(asset.filepath + asset.vertex_src_file, data) ||
+        !read_file(asset.filepath + asset.fragment_src_file, fragment_data)) {
+        return false;
+    }
+
+    Asset_Archive::Entry entry;
+    entry.name = name;
+    entry.type = Asset_Type::Shader;
+    entry.vertex_size = static_cast<u32>(data.size());
+
+    data.insert(data.end(), fragment_data.begin(), fragment_data.end());
+    writer.add(entry, data.data(), data.size());
+    return true;
+}
+
+bool
+pack_font(Asset_Archive_Writer& writer, const std::string& name, const Font_Asset& asset)
+{
+    std::vector<u8> data;
+    if (!read_file(asset.filepath, data)) {
+        return false;
+    }
+
+    Asset_Archive::Entry entry;
+    entry.name = name;
+    entry.type = Asset_Type::Font;
+
+    writer.add(entry, data.data(), data.size());
+    return true;
+}
+
+bool
+pack_animation(Asset_Archive_Writer& writer, const std::string& name, const Animation_Asset& asset)
+{
+    std::vector<u8> text;
+    std::vector<ascension::graphics::Animation_Frame> frames;
+    if (!read_file(asset.filepath, text)) {
+        return false;
+    }
+    if (!parse_animation_data(text.data(), text.size(), frames)) {
+        std::cerr << "Failed to parse animation " << asset.filepath << "\n";
+        return false;
+    }
+
+    Asset_Archive::Entry entry;
+    entry.name = name;
+    entry.dependency = asset.texture_atlas;
+    entry.type = Asset_Type::Animation;
+
+    const auto data = write_animation_data(frames);
+    writer.add(entry, data.data(), data.size());
+    return true;
+}
+
+}
+
+int
+main(int argc, char** argv)
+{
+    const std::vector<std::string> args(argv + 1, argv + argc); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    std::string manifest_filepath;
+    std::string output_filepath;
+    std::string index_filepath;
+    bool compress = false;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "-o" && i + 1 < args.size()) {
+            output_filepath = args[++i];
+        }
+        else if (args[i] == "--compress") {
+            compress = true;
+        }
+        else if (args[i] == "--index" && i + 1 < args.size()) {
+            index_filepath = args[++i];
+        }
+        else if (args[i] == "-h" || args[i] == "--help") {
+            print_usage();
+            return 0;
+        }
+        else {
+            manifest_filepath = args[i];
+        }
+    }
+
+    if (manifest_filepath.empty() || (output_filepath.empty() && index_filepath.empty())) {
+        print_usage();
+        return 1;
+    }
+
+    // Manifest errors are reported through the logger, its directory goes next to the outputs rather than in the
+    // working directory, which is the asset source tree when run by the build.
+    const auto log_directory = std::filesystem::path(index_filepath.empty() ? output_filepath : index_filepath).parent_path();
+    yuki::debug::Logger::initialize(
+        (log_directory / "logs" / "asset_packer.log").string(), yuki::debug::Severity::LOG_WARNING, false, true
+    );
+
+    Asset_Manifest manifest;
+    if (!manifest.load(manifest_filepath)) {
+        return 1;
+    }
+
+    if (!index_filepath.empty()) {
+        Asset_Index index;
+        if (!index.build(manifest) || !index.write(index_filepath)) {
+            std::cerr << "Failed to write " << index_filepath << "\n";
+            return 1;
+        }
+
+        std::cout << "Indexed " << index.size() << " assets into " << index_filepath << "\n";
+    }
+
+    if (output_filepath.empty()) {
+        return 0;
+    }
+
+    Asset_Archive_Writer writer;
+    std::map<std::string, std::vector<std::string>> generated_atlases;
+    for (const auto& name : get_sorted_names(manifest.textures())) {
+        const auto& atlas = manifest.textures().at(name).atlas;
+        if (!atlas.empty()) {
+            generated_atlases[atlas].push_back(name);
+        }
+    }
+
+    std::unordered_set<std::string> packed;
+    for (const auto& [atlas, members] : generated_atlases) {
+        if (!pack_generated_atlas(writer, atlas, members, manifest.textures(), compress, packed)) {
+            return 1;
+        }
+    }
+    for (const auto& name : get_sorted_names(manifest.textures())) {
+        if (packed.count(name) != 0) {
+            continue;
+        }
+        if (!pack_texture(writer, name, manifest.textures().at(name), compress)) {
+            return 1;
+        }
+    }
+    for (const auto& name : get_sorted_names(manifest.texture_atlases())) {
+        if (!pack_texture_atlas(writer, name, manifest.texture_atlases().at(name))) {
+            return 1;
+        }
+    }
+    for (const auto& name : get_sorted_names(manifest.shaders())) {
+        if (!pack_shader(writer, name, manifest.shaders().at(name))) {
+            return 1;
+        }
+    }
+    for (const auto& name : get_sorted_names(manifest.fonts())) {
+        if (!pack_font(writer, name, manifest.fonts().at(name))) {
+            return 1;
+        }
+    }
+    for (const auto& name : get_sorted_names(manifest.animations())) {
+        if (!pack_animation(writer, name, manifest.animations().at(name))) {
+            return 1;
+        }
+    }
+
+    if (!writer.write(output_filepath)) {
+        std::cerr << "Failed to write " << output_filepath << "\n";
+        return 1;
+    }
+
+    std::cout << "Packed " << manifest.textures().size() << " textures, " << manifest.texture_atlases().size()
+              << " texture atlases, " << manifest.shaders().size() << " shaders, " << manifest.fonts().size()
+              << " fonts & " << manifest.animations().size() << " animations into " << output_filepath << "\n";
+    return 0;
+}
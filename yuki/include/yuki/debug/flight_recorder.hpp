@@ -0,0 +1,160 @@
+/**
+ * File: flight_recorder.hpp
+ * Project: yuki
+ * File Created: 2026-10-18 14:22:14
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 14:23:41
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "yuki/debug/profile_event.hpp"
+
+namespace yuki::debug {
+
+/**
+ * @class Flight_Recorder
+ *
+ * @brief An always-on recorder of the most recent frame times & top level scope durations.
+ * Unlike the Instrumentor it is compiled into release builds, recording is a couple of stores into fixed-size
+ * rings, so it can run in the field. The rings are written out as a Chrome trace json file when a frame takes
+ * longer than the hitch threshold, or when a dump is requested by a hotkey or SIGUSR1.
+ *
+ * Frames & scopes must be recorded from a single thread, usually the main thread.
+ */
+class Flight_Recorder {
+public:
+    // Roughly the last 30 seconds at 60 frames per second.
+    static constexpr size_t MAX_FRAMES = 2048;
+    static constexpr size_t MAX_SCOPES = 16384;
+
+    Flight_Recorder(const Flight_Recorder&) = delete;
+    Flight_Recorder(Flight_Recorder&&) = delete;
+    Flight_Recorder& operator=(const Flight_Recorder&) = delete;
+    Flight_Recorder& operator=(Flight_Recorder&&) = delete;
+
+    /**
+     * @brief Get the global Flight_Recorder object.
+     */
+    static Flight_Recorder& get();
+
+    /**
+     * @brief Set the directory dumps are written to, defaults to logs.
+     */
+    void set_output_directory(const std::string& directory);
+
+    /**
+     * @brief Set the frame time above which the recorder dumps automatically, 0 disables automatic dumps.
+     * Automatic dumps are rate limited, so a stretch of slow frames produces a single dump.
+     *
+     * @param   threshold_ms    The frame time in milliseconds counted as a hitch.
+     */
+    void set_hitch_threshold(f64 threshold_ms);
+
+    /**
+     * @brief Dump the recorder when the process receives SIGUSR1, does nothing on platforms without it.
+     */
+    void install_signal_handler();
+
+    /**
+     * @brief Mark the end of the current frame & the start of the next one.
+     * Requested & hitch dumps are started from here, on a background thread.
+     */
+    void mark_frame();
+
+    /**
+     * @brief Record a completed top level scope of the current frame.
+     *
+     * @param   name          The static name of the scope.
+     * @param   start_ns      The steady clock time in nanoseconds the scope started at.
+     * @param   duration_ns   The time in nanoseconds elapsed during the scope.
+     */
+    void record_scope(const char* name, i64 start_ns, i64 duration_ns);
+
+    /**
+     * @brief Request a dump at the end of the current frame, safe to call from any thread or a signal handler.
+     */
+    void request_dump();
+
+    /**
+     * @brief Wait for any dump still being written.
+     */
+    void shutdown();
+
+private:
+    Flight_Recorder() = default;
+    ~Flight_Recorder();
+
+    /**
+     * @brief Copy the rings into the dump buffers & write them out on the dump thread.
+     *
+     * @param   reason  Appended to the dump's filename, e.g. hitch or request.
+     */
+    void start_dump(const char* reason);
+
+    /**
+     * @brief Write the dump buffers to a new file in the output directory, runs on the dump thread.
+     */
+    void write_dump(const std::string& filepath, size_t frame_count, size_t scope_count) const;
+
+    std::string m_output_directory{ "logs" };
+    i64 m_hitch_threshold_ns{ 0 };
+
+    std::array<Profile_Event, MAX_FRAMES> m_frames;
+    std::array<Profile_Event, MAX_SCOPES> m_scopes;
+    size_t m_frame_count{ 0 };
+    size_t m_scope_count{ 0 };
+    i64 m_frame_start_ns{ 0 };
+    i64 m_last_hitch_dump_ns{ 0 };
+
+    std::atomic<bool> m_dump_requested{ false };
+    std::atomic<bool> m_dump_in_progress{ false };
+    std::unique_ptr<std::thread> m_dump_thread;
+    std::array<Profile_Event, MAX_FRAMES> m_dump_frames;
+    std::array<Profile_Event, MAX_SCOPES> m_dump_scopes;
+};
+
+class Flight_Recorder_Scope {
+public:
+    explicit Flight_Recorder_Scope(const char* name);
+    ~Flight_Recorder_Scope();
+
+    Flight_Recorder_Scope(const Flight_Recorder_Scope&) = delete;
+    Flight_Recorder_Scope(Flight_Recorder_Scope&&) = delete;
+    Flight_Recorder_Scope& operator=(const Flight_Recorder_Scope&) = delete;
+    Flight_Recorder_Scope& operator=(Flight_Recorder_Scope&&) = delete;
+
+private:
+    const char* m_name;
+    i64 m_start_ns;
+};
+
+}
+
+// Not gated on YUKI_DEBUG, the flight recorder is meant to run in release builds.
+#define FLIGHT_RECORDER_FRAME() yuki::debug::Flight_Recorder::get().mark_frame() // NOLINT
+// NOLINTNEXTLINE
+#define FLIGHT_RECORDER_SCOPE_LINE_INTERNAL(name, line) yuki::debug::Flight_Recorder_Scope flight_scope##line(name)
+#define FLIGHT_RECORDER_SCOPE_LINE(name, line) FLIGHT_RECORDER_SCOPE_LINE_INTERNAL(name, line) // NOLINT
+#define FLIGHT_RECORDER_SCOPE(name) FLIGHT_RECORDER_SCOPE_LINE(name, __LINE__)                 // NOLINT
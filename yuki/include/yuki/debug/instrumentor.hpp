@@ -3,7 +3,7 @@
  * Project: yuki
  * File Created: 2023-03-06 20:00:03
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-04-26 15:22:55
+ * Last Modified: 2026-10-18 16:24:43
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -25,17 +25,104 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
+
+#include "yuki/debug/profile_event.hpp"
+#include "yuki/debug/profile_stats.hpp"
+#include "yuki/debug/trace_file.hpp"
 
 namespace yuki::debug {
 
+/**
+ * @class Profile_Event_Buffer
+ *
+ * @brief Lock-free single producer/single consumer ring of profiling events.
+ * Each instrumented thread owns one buffer which only it writes to, the Instrumentor's drain thread reads them.
+ * Buffers are released when their thread exits and reused by the next new thread, so a thread index can be shared by
+ * several short-lived threads one after another.
+ */
+class Profile_Event_Buffer {
+public:
+    static constexpr size_t CAPACITY = 65536;
+
+    explicit Profile_Event_Buffer(u32 thread_index);
+
+    /**
+     * @brief Push an event onto the ring, only called from the owning thread.
+     * The event is dropped & counted if the ring is full.
+     *
+     * @param   event   The completed profiling event.
+     */
+    void push(const Profile_Event& event);
+
+    /**
+     * @brief Pop all events currently in the ring, only called from the drain thread.
+     *
+     * @param   callback    Invoked for each event in the order they were pushed.
+     *
+     * @return  The number of events popped.
+     */
+    template<typename Callback>
+    size_t drain(Callback&& callback)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+
+        for (size_t i = tail; i != head; ++i) {
+            callback(m_events[i & (CAPACITY - 1)]); // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+
+        m_tail.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    /**
+     * @brief Get the number of events dropped since the last call, due to the ring being full.
+     */
+    u64 take_dropped_count();
+
+    [[nodiscard]] u32 thread_index() const;
+
+    /**
+     * @brief Claim a released buffer for the calling thread.
+     *
+     * @return  true if the buffer was free & is now owned by the calling thread.
+     */
+    bool try_acquire();
+
+    /**
+     * @brief Hand the buffer back once its owning thread exits, events still in the ring are drained as usual.
+     */
+    void release();
+
+    Profile_Event_Buffer(const Profile_Event_Buffer&) = delete;
+    Profile_Event_Buffer(Profile_Event_Buffer&&) = delete;
+    Profile_Event_Buffer& operator=(const Profile_Event_Buffer&) = delete;
+    Profile_Event_Buffer& operator=(Profile_Event_Buffer&&) = delete;
+
+private:
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Profile_Event_Buffer capacity must be a power of two");
+
+    std::array<Profile_Event, CAPACITY> m_events;
+    alignas(64) std::atomic<size_t> m_head;
+    alignas(64) std::atomic<size_t> m_tail;
+    std::atomic<u64> m_dropped;
+    std::atomic<bool> m_owned;
+    u32 m_thread_index;
+};
+
 /**
  * @class Instrumentor
  *
  * @brief A debug utility class for profiling/instrumenting code.
+ * Events are recorded into per-thread ring buffers and written to the session file by a background thread,
+ * so no locks, allocations or file IO happen inside the profiled code.
  */
 class Instrumentor {
 public:
@@ -56,44 +143,151 @@ public:
      * This will collect and output profiling calls until end_session is called.
      *
      * @param   name      The name of the profiling session.
-     * @param   filepath  The filepath to output the results to. Results are in json format.
+     * @param   filepath  The filepath to output the results to. Results are in Chrome trace json format, unless
+     *                    the extension is .ytrace, in which case they are streamed into binary trace segments.
      */
     void begin_session(const std::string& name, const std::string& filepath = "logs/results.json");
 
+    /**
+     * @brief Set the size of binary trace segments & how many are kept on disk, used by the next session.
+     * Defaults to 64MiB segments & 8 segments, 0 segments keeps every segment.
+     */
+    void set_trace_limits(u64 max_segment_size, u32 max_segments);
+
     /**
      * @brief End the current profiling session.
+     * Drains any remaining events from the thread buffers before the results file is closed.
      */
     void end_session();
 
     /**
-     * @brief Output a profiling result into the active session.
+     * @brief Record a completed profiling scope into the calling thread's event buffer.
+     * Does nothing if there is no active session.
      *
-     * @param   name          The result name, this is usually the fuction/line which is profiled.
-     * @param   start_time    The starting time in microseconds of the profiled section.
-     * @param   elapsed_time  The time elapsed during the profiled section.
-     * @param   thread_id     The ID of the thread which had this profiled section.
-     */
-    void output_profile_result(
-        const std::string& name,
-        std::chrono::duration<f64, std::micro> start_time,
-        std::chrono::microseconds elapsed_time,
-        std::thread::id thread_id
-    );
+     * @param   name          The static name of the profiled section, usually the function signature.
+     * @param   start_ns      The steady clock time in nanoseconds the section started at.
+     * @param   duration_ns   The time in nanoseconds elapsed during the section.
+     * @param   track         The timeline the section was measured on, start_ns must be in steady clock time.
+     */
+    void record_event(const char* name, i64 start_ns, i64 duration_ns, Profile_Track track = Profile_Track::CPU);
+
+    /**
+     * @brief Record a point in time marker on the calling thread, such as an asset finishing loading.
+     *
+     * @param   name    The static name of the marker.
+     */
+    void record_instant(const char* name);
+
+    /**
+     * @brief Record a sample of a counter, each counter name is plotted as its own track.
+     *
+     * @param   name    The static name of the counter.
+     * @param   value   The current value of the counter.
+     */
+    void record_counter(const char* name, i64 value);
+
+    /**
+     * @brief Record the start of a flow, linking the enclosing scope to the scope which ends the flow.
+     *
+     * @param   name    The static name of the flow.
+     * @param   id      The id of the flow, must be unique among the flows of the same name in flight.
+     */
+    void record_flow_begin(const char* name, u64 id);
+
+    /**
+     * @brief Record the end of a flow started by record_flow_begin, usually on a different thread.
+     *
+     * @param   name    The static name of the flow.
+     * @param   id      The id the flow was started with.
+     */
+    void record_flow_end(const char* name, u64 id);
+
+    /**
+     * @brief Check whether a session is currently recording events.
+     */
+    [[nodiscard]] bool is_session_active() const;
+
+    /**
+     * @brief Mark the start of a new frame on the calling thread.
+     * Frame markers delimit the windows the scope statistics are aggregated over.
+     */
+    void mark_frame();
+
+    /**
+     * @brief Set how many frames the scope statistics are aggregated over, defaults to 60.
+     */
+    void set_stats_window(u32 frames);
+
+    /**
+     * @brief Get the statistics of every profiled scope over the rolling stats window.
+     */
+    [[nodiscard]] std::vector<Profile_Scope_Stats> get_scope_stats() const;
+
+    /**
+     * @brief Get the statistics of a single profiled scope over the rolling stats window.
+     *
+     * @param   name    The name of the scope, as output by PROFILE_SCOPE/PROFILE_FUNCTION.
+     */
+    [[nodiscard]] std::optional<Profile_Scope_Stats> get_scope_stats(const std::string& name) const;
+
+    /**
+     * @brief Write the statistics of every profiled scope over the rolling stats window to the debug log.
+     */
+    void log_scope_stats() const;
 
 private:
+    static constexpr u64 DEFAULT_MAX_SEGMENT_SIZE = 64ULL * 1024 * 1024;
+    static constexpr u32 DEFAULT_MAX_SEGMENTS = 8;
+
     Instrumentor() = default;
     ~Instrumentor();
 
     void internal_end_session();
 
+    /**
+     * @brief Get the event buffer of the calling thread, registering a new one on first use.
+     */
+    Profile_Event_Buffer& get_thread_buffer();
+
+    /**
+     * @brief Drain thread loop, periodically moves events from the thread buffers into the results file.
+     */
+    void drain_events();
+
+    /**
+     * @brief Pop all pending events from every thread buffer and write them to the results file.
+     * Must be called while holding m_mutex.
+     *
+     * @param   discard   Drop the events instead of writing them.
+     */
+    void drain_buffers(bool discard = false);
+
+    /**
+     * @brief Feed an event into the scope statistics and encode it into the session's output format.
+     * Must be called while holding m_mutex.
+     */
+    void write_event(const Profile_Event& event, u32 thread_index);
+
     std::mutex m_mutex;
     std::string m_current_session;
     std::ofstream m_output_stream;
+    std::string m_write_buffer;
+    Trace_Writer m_trace_writer;
+    bool m_binary_trace{ false };
+    u64 m_max_segment_size{ DEFAULT_MAX_SEGMENT_SIZE };
+    u32 m_max_segments{ DEFAULT_MAX_SEGMENTS };
+    Profile_Stats m_stats;
+
+    std::atomic<bool> m_session_active{ false };
+    std::unique_ptr<std::thread> m_drain_thread;
+
+    std::mutex m_mutex_buffers;
+    std::vector<std::unique_ptr<Profile_Event_Buffer>> m_buffers;
 };
 
 class Instrumentor_Timer {
 public:
-    explicit Instrumentor_Timer(std::string name);
+    explicit Instrumentor_Timer(const char* name);
     ~Instrumentor_Timer();
 
     Instrumentor_Timer(const Instrumentor_Timer&) = default;
@@ -103,12 +297,12 @@ public:
 
     /**
      * @brief Stop the current timer.
-     * This will cause the result to be written to the current session.
+     * This will cause the result to be recorded into the current session.
      */
     void stop();
 
 private:
-    std::string m_name;
+    const char* m_name;
     std::chrono::time_point<std::chrono::steady_clock> m_start_time;
     bool m_stopped;
 };
@@ -144,13 +338,19 @@ _cleanup_timer_name(const char (&expr)[N], const char (&remove)[K])
 }
 
 #ifdef YUKI_DEBUG
-#define PROFILE_BEGIN_SESSION(name, filepath) yuki::debug::Instrumentor::get().begin_session(name, filepath) // NOLINT
-#define PROFILE_END_SESSION() yuki::debug::Instrumentor::get().end_session()                                 // NOLINT
+#define PROFILE_BEGIN_SESSION(name, filepath) yuki::debug::Instrumentor::get().begin_session(name, filepath)        // NOLINT
+#define PROFILE_END_SESSION() yuki::debug::Instrumentor::get().end_session()                                        // NOLINT
+#define PROFILE_FRAME_MARK() yuki::debug::Instrumentor::get().mark_frame()                                          // NOLINT
+#define PROFILE_LOG_STATS() yuki::debug::Instrumentor::get().log_scope_stats()                                      // NOLINT
+#define PROFILE_INSTANT(name) yuki::debug::Instrumentor::get().record_instant(name)                                 // NOLINT
+#define PROFILE_COUNTER(name, value) yuki::debug::Instrumentor::get().record_counter(name, static_cast<i64>(value)) // NOLINT
+#define PROFILE_FLOW_BEGIN(name, id) yuki::debug::Instrumentor::get().record_flow_begin(name, id)                   // NOLINT
+#define PROFILE_FLOW_END(name, id) yuki::debug::Instrumentor::get().record_flow_end(name, id)                       // NOLINT
 
 // NOLINTNEXTLINE
 #define PROFILE_SCOPE_LINE_INTERNAL(name, line)                                                                                \
-    constexpr auto fixedName##line = yuki::debug::_cleanup_timer_name(name, "__cdecl ");                                       \
-    yuki::debug::Instrumentor_Timer timer##line(std::string(fixedName##line.data.data()))
+    static constexpr auto fixedName##line = yuki::debug::_cleanup_timer_name(name, "__cdecl ");                                \
+    yuki::debug::Instrumentor_Timer timer##line(fixedName##line.data.data())
 #define PROFILE_SCOPE_LINE(name, line) PROFILE_SCOPE_LINE_INTERNAL(name, line) // NOLINT
 #define PROFILE_SCOPE(name) PROFILE_SCOPE_LINE(name, __LINE__)                 // NOLINT
 #define PROFILE_FUNCTION() PROFILE_SCOPE(__PRETTY_FUNCTION__)                  // NOLINT
@@ -158,6 +358,12 @@ _cleanup_timer_name(const char (&expr)[N], const char (&remove)[K])
 #else
 #define PROFILE_BEGIN_SESSION(name, filepath)
 #define PROFILE_END_SESSION(YDI_FUNC_SIG)
+#define PROFILE_FRAME_MARK()
+#define PROFILE_LOG_STATS()
+#define PROFILE_INSTANT(name)
+#define PROFILE_COUNTER(name, value)
+#define PROFILE_FLOW_BEGIN(name, id)
+#define PROFILE_FLOW_END(name, id)
 
 #define PROFILE_SCOPE_LINE(name, line)
 #define PROFILE_SCOPE_LINE_INTERNAL(name, line)
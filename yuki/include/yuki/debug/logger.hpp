@@ -3,7 +3,7 @@
  * Project: yuki
  * File Created: 2023-02-25 11:46:28
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-07-14 10:22:44
+ * Last Modified: 2026-10-18 16:28:51
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -24,9 +24,13 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <unordered_map>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -35,9 +39,12 @@
 
 #include <magic_enum/magic_enum.hpp>
 
+#include "yuki/debug/mapped_log_file.hpp"
+
 #define SLEEP_IN_MS 100
 #define LOG_PATH_DEFAULT "logs/app.log"
 #define DEFAULT_BUFFER_LENGTH 256
+#define LOG_CHANNELS_MAX 64
 
 namespace yuki::debug {
 
@@ -166,6 +173,15 @@ public:
         m_queue.push(value);
     }
 
+    /**
+     * @brief Get the number of elements currently in the queue.
+     */
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_queue.size();
+    }
+
 private:
     std::mutex m_mutex;
     std::queue<std::string> m_queue;
@@ -226,6 +242,85 @@ private:
     static std::mutex& get_mutex();
 };
 
+/**
+ * @enum Log_File_Mode
+ *
+ * @brief Enumerator which defines how records are written to the application log file.
+ *   STREAM: buffered file stream, flushed whenever the log queue is drained
+ *   MAPPED: memory-mapped append-only file, synced whenever the log queue is drained
+ */
+enum class Log_File_Mode {
+    STREAM = 0,
+    MAPPED = 1
+};
+
+/**
+ * @struct Log_Rotation_Config
+ *
+ * @brief Describes when the application log file is rolled over into a new segment and how many of
+ * the rolled over segments are kept on disk. A value of zero disables the respective limit.
+ */
+struct Log_Rotation_Config {
+    // Maximum size in bytes of the active log file before it is rotated.
+    u64 max_file_size{ 0 };
+    // Maximum time a single log file is written to before it is rotated.
+    std::chrono::seconds max_file_age{ 0 };
+    // Number of rotated segments to keep, the oldest are deleted first.
+    u32 max_rotated_files{ 0 };
+    // Compress rotated segments (gzip) on a background thread, requires yuki to be built with zlib.
+    bool compress{ true };
+};
+
+/**
+ * @brief Identifier of a registered log channel, channel 0 is the default "yuki" channel.
+ */
+using Log_Channel = u32;
+
+static constexpr Log_Channel LOG_CHANNEL_DEFAULT = 0;
+
+/**
+ * @struct Log_Channel_Config
+ *
+ * @brief Describes which records of a log channel are written. Channel filtering is applied after the
+ * global severity level and before the record is formatted, so filtered records cost next to nothing.
+ */
+struct Log_Channel_Config {
+    // Minimum severity written for the channel.
+    Severity level{ Severity::LOG_DEBUG };
+    // Maximum records written per second, records over the limit are dropped & counted. Zero disables the limit.
+    u32 max_per_second{ 0 };
+    // Only every Nth record of the channel is written, 0 or 1 writes every record.
+    u32 sample_rate{ 1 };
+};
+
+/**
+ * @struct Log_Source
+ *
+ * @brief The source of a log record, either a registered channel id or a free-form source name.
+ * Source names are resolved to (and if required register) the channel of the same name. Each thread caches the names
+ * it resolved, so the channel lock is only taken the first time a thread logs from a source. Registering the channel
+ * once & passing the id is still the cheapest.
+ */
+struct Log_Source {
+    Log_Source(Log_Channel _channel) // NOLINT(hicpp-explicit-conversions)
+      : channel(_channel)
+    {
+    }
+
+    Log_Source(const char* _name) // NOLINT(hicpp-explicit-conversions)
+      : name(_name)
+    {
+    }
+
+    Log_Source(const std::string& _name) // NOLINT(hicpp-explicit-conversions)
+      : name(_name.c_str())
+    {
+    }
+
+    Log_Channel channel{ LOG_CHANNEL_DEFAULT };
+    const char* name{ nullptr };
+};
+
 class Logger;
 
 /**
@@ -267,6 +362,12 @@ public:
      */
     void write_to_log_file();
 
+    /**
+     * @brief Pop rotated log segments from the compression queue and compresses them.
+     * Runs on its own thread so rotation never stalls the writer.
+     */
+    void compress_rotated_files();
+
     /**
      * @brief Release and close all loggers
      *
@@ -274,26 +375,154 @@ public:
      */
     void drop_all();
 
+    /**
+     * @brief Register a new log channel, or look up the channel if one with the name already exists.
+     * Falls back to the default channel once LOG_CHANNELS_MAX channels are registered.
+     *
+     * @param	name		The unique name of the channel, used as the source of its records.
+     * @param	config		The filter configuration applied to a newly registered channel.
+     *
+     * @return	The id of the channel.
+     */
+    Log_Channel register_channel(const std::string& name, const Log_Channel_Config& config);
+
+    /**
+     * @brief Resolve the source name of a record to its channel, registering the channel if required.
+     * Names are cached per thread so repeated records from the same source skip the channel lock.
+     */
+    Log_Channel resolve_channel(const char* name);
+
+    /**
+     * @brief Set the filter configuration of a registered channel.
+     */
+    void set_channel_config(Log_Channel channel, const Log_Channel_Config& config);
+
+    /**
+     * @brief Check the channel's level, sample rate & rate limit to determine if a record is written.
+     * Reports the number of records dropped by the previous rate limit window once it has elapsed.
+     *
+     * @param	channel		The channel the record is written to.
+     * @param	level		The log severity level of the record.
+     * @param	suppressed	Set to the number of records dropped in the last window, else 0.
+     *
+     * @return	true if the record should be written, else false.
+     */
+    bool accept_channel_record(Log_Channel channel, Severity level, u32& suppressed);
+
+    /**
+     * @brief Get the name of a registered channel, the default channel's name for unknown ids.
+     */
+    [[nodiscard]] const std::string& get_channel_name(Log_Channel channel) const;
+
     Logger_Worker(const Logger_Worker&) = delete;
     Logger_Worker(Logger_Worker&&) = delete;
     Logger_Worker& operator=(const Logger_Worker&) = delete;
     Logger_Worker& operator=(Logger_Worker&&) = delete;
 
 private:
+    /**
+     * @brief Check whether writing a record of the given size should roll the log file over first.
+     *
+     * @param	record_size		The size in bytes of the record about to be written.
+     */
+    [[nodiscard]] bool should_rotate(size_t record_size) const;
+
+    /**
+     * @brief Close the active log file, move it to a timestamped segment and re-open a fresh log file.
+     * Must be called while holding m_mutex_log_file.
+     */
+    void rotate_log_file();
+
+    /**
+     * @brief Delete the oldest rotated log segments of the log file exceeding the retention count.
+     * The segment being compressed is skipped, the compression thread sweeps again once it's done.
+     */
+    void remove_expired_log_files(const std::string& log_filepath, u32 max_rotated_files);
+
+    /**
+     * @brief Open the log file stream (if required) and update the tracked size & age of the segment.
+     */
+    void open_log_file();
+
+    /**
+     * @brief Close the log file for the active file mode.
+     * Must be called while holding m_mutex_log_file.
+     */
+    void close_log_file();
+
+    /**
+     * @brief Check whether the log file for the active file mode is open.
+     */
+    [[nodiscard]] bool is_log_file_open() const;
+
+    /**
+     * @brief Write a single record to the log file for the active file mode.
+     *
+     * @return	true if the record was written, else false.
+     */
+    bool write_log_record(const std::string& record);
+
+    /**
+     * @brief Flush/sync any buffered records to disk.
+     * Must be called while holding m_mutex_log_file.
+     */
+    void flush_log_file();
+
+    /**
+     * @brief The filter configuration & rate limit window of a single channel.
+     * Written from any logging thread, so the filter state is kept in atomics.
+     */
+    struct Channel_State {
+        std::string name;
+        std::atomic<Severity> level{ Severity::LOG_DEBUG };
+        std::atomic<u32> max_per_second{ 0 };
+        std::atomic<u32> sample_rate{ 1 };
+        std::atomic<u32> sample_count{ 0 };
+        std::atomic<i64> window_start{ 0 };
+        std::atomic<u32> window_count{ 0 };
+        std::atomic<u32> suppressed_count{ 0 };
+    };
+
     std::unique_ptr<std::thread> m_app_log_thread;
+    std::unique_ptr<std::thread> m_compress_thread;
     volatile bool m_is_app_interrupted;
 
     Severity m_severity_level;
 
     Blocking_string_Queue log_queue;
     std::mutex m_mutex_log_queue;
+    // Records are written in the order they are queued, so the counts double as the records' flow ids.
+    u64 m_log_records_queued;
+    u64 m_log_records_written;
+    // One past the id of the last error or critical record queued, the log file is flushed once it's written.
+    std::atomic<u64> m_flush_record;
 
     volatile bool m_file_log_enabled;
     volatile bool m_console_log_enabled;
 
     std::string m_log_filepath;
+    Log_File_Mode m_file_mode;
     std::ofstream m_log_file_stream;
+    Mapped_Log_File m_mapped_log_file;
     std::mutex m_mutex_log_file;
+
+    Log_Rotation_Config m_rotation_config;
+    u64 m_log_file_size;
+    std::chrono::steady_clock::time_point m_log_file_opened;
+    // When the mapped log file was last synced, records are also synced under sustained logging.
+    std::chrono::steady_clock::time_point m_log_file_synced;
+
+    Blocking_string_Queue m_compress_queue;
+    std::mutex m_mutex_rotated_files;
+    // The segment the compression thread is working on, guarded by m_mutex_rotated_files.
+    std::string m_compressing_filepath;
+
+    std::array<Channel_State, LOG_CHANNELS_MAX> m_channels;
+    std::atomic<u32> m_channel_count;
+    std::unordered_map<std::string, Log_Channel> m_channel_ids;
+    std::mutex m_mutex_channels;
+    // Set once the channel table is full & reported, guarded by m_mutex_channels.
+    bool m_channels_full_reported;
 };
 
 /**
@@ -343,10 +572,46 @@ public:
      */
     static void enable_console_logging(bool value);
 
+    /**
+     * @brief Set when the application log file is rotated & how many rotated segments to keep.
+     * Rotation is disabled by default.
+     *
+     * @param	config	the rotation limits to apply to the application log file.
+     */
+    static void set_log_rotation(const Log_Rotation_Config& config);
+
+    /**
+     * @brief Set how records are written to the application log file, defaults to STREAM.
+     * The active log file is closed and re-opened in the new mode on the next write.
+     *
+     * @param	mode	the file mode to write the application log file with.
+     */
+    static void set_log_file_mode(Log_File_Mode mode);
+
+    /**
+     * @brief Register a named log channel with its own severity level, sample rate & rate limit.
+     * Registering an existing name returns the existing channel & leaves its configuration unchanged.
+     *
+     * @param	name		The unique name of the channel, used as the source of its records.
+     * @param	config		The filter configuration of the channel.
+     *
+     * @return	The id to pass as the source of log records for this channel.
+     */
+    static Log_Channel register_channel(const std::string& name, const Log_Channel_Config& config = {});
+
+    /**
+     * @brief Set the filter configuration of a registered log channel.
+     *
+     * @param	channel		The id of the channel to configure.
+     * @param	config		The filter configuration of the channel.
+     */
+    static void set_channel_config(Log_Channel channel, const Log_Channel_Config& config);
+
     /**
      * @brief Write debug level log record to the application log file.
      *
      * @param   level   The severity level to output this log record at.
+     * @param   source  The channel or source name of this log record.
      * @param	format	String that contains a format string that follows the
      *same specifications as format in printf (see printf for details)
      * @param	args	Depending on the format string, the function may expect a
@@ -354,7 +619,7 @@ public:
      *replace a format specifier in the format string.
      */
     template<typename... Args>
-    static void log(Severity level, const std::string& source, const std::string& format, Args&&... args)
+    static void log(Severity level, const Log_Source& source, const std::string& format, Args&&... args)
     {
         write_log(level, source, format, std::forward<Args>(args)...);
     }
@@ -369,7 +634,7 @@ public:
      *replace a format specifier in the format string.
      */
     template<typename... Args>
-    static void debug(const std::string& source, const std::string& format, Args&&... args)
+    static void debug(const Log_Source& source, const std::string& format, Args&&... args)
     {
         write_log(Severity::LOG_DEBUG, source, format, std::forward<Args>(args)...);
     }
@@ -384,7 +649,7 @@ public:
      *replace a format specifier in the format string.
      */
     template<typename... Args>
-    static void info(const std::string& source, const std::string& format, Args&&... args)
+    static void info(const Log_Source& source, const std::string& format, Args&&... args)
     {
         write_log(Severity::LOG_INFO, source, format, std::forward<Args>(args)...);
     }
@@ -399,7 +664,7 @@ public:
      *replace a format specifier in the format string.
      */
     template<typename... Args>
-    static void notice(const std::string& source, const std::string& format, Args&&... args)
+    static void notice(const Log_Source& source, const std::string& format, Args&&... args)
     {
         write_log(Severity::LOG_NOTICE, source, format, std::forward<Args>(args)...);
     }
@@ -414,7 +679,7 @@ public:
      *replace a format specifier in the format string.
      */
     template<typename... Args>
-    static void warn(const std::string& source, const std::string& format, Args&&... args)
+    static void warn(const Log_Source& source, const std::string& format, Args&&... args)
     {
         write_log(Severity::LOG_WARNING, source, format, std::forward<Args>(args)...);
     }
@@ -429,7 +694,7 @@ public:
      *replace a format specifier in the format string.
      */
     template<typename... Args>
-    static void error(const std::string& source, const std::string& format, Args&&... args)
+    static void error(const Log_Source& source, const std::string& format, Args&&... args)
     {
         write_log(Severity::LOG_ERROR, source, format, std::forward<Args>(args)...);
     }
@@ -444,7 +709,7 @@ public:
      *replace a format specifier in the format string.
      */
     template<typename... Args>
-    static void critical(const std::string& source, const std::string& format, Args&&... args)
+    static void critical(const Log_Source& source, const std::string& format, Args&&... args)
     {
         write_log(Severity::LOG_CRITICAL, source, format, std::forward<Args>(args)...);
     }
@@ -475,31 +740,55 @@ private:
      * Standard format: yyyy-MM-dd HH:mm:ss.SSS [LEVEL ](source): Message
      *
      * @param	level	The log severity level
+     * @param	source	The channel or source name of the log record
      * @param	format	String that contains a format string that follows the
      *same specifications as format in printf (see printf for details)
      * @param	args	The variable argument list (va_list)
      */
     template<typename... Args>
-    static void write_log(Severity level, const std::string& source, const std::string& format, Args&&... args)
+    static void write_log(Severity level, const Log_Source& source, const std::string& format, Args&&... args)
     {
-        if (level < get_worker().m_severity_level) {
+        auto& worker = get_worker();
+        if (level < worker.m_severity_level) {
             return;
         }
 
-        std::string formatted_message = fmt::format(format, std::forward<Args>(args)...);
-
         std::string log_string;
         if (level != Severity::LOG_MANUAL) {
+            const Log_Channel channel = source.name != nullptr ? worker.resolve_channel(source.name) : source.channel;
+
+            u32 suppressed = 0;
+            const bool accepted = worker.accept_channel_record(channel, level, suppressed);
+            const char* source_name = source.name != nullptr ? source.name : worker.get_channel_name(channel).c_str();
+
+            if (suppressed > 0) {
+                worker.output_log_line(
+                    Severity::LOG_WARNING,
+                    fmt::format(
+                        "{0} [{1: <8}] ({2}) > {3} records suppressed by channel rate limit",
+                        Logger_Util::get_time_string(),
+                        "WARNING",
+                        source_name,
+                        suppressed
+                    )
+                );
+            }
+
+            if (!accepted) {
+                return;
+            }
+
             const auto timestamp = Logger_Util::get_time_string();
             const auto log_level = std::string(magic_enum::enum_name(level)).substr(4);
-            log_string = fmt::format("{0} [{1: <8}] ({2}) > {3}", timestamp, log_level, source, formatted_message);
+            const auto formatted_message = fmt::format(format, std::forward<Args>(args)...);
+            log_string = fmt::format("{0} [{1: <8}] ({2}) > {3}", timestamp, log_level, source_name, formatted_message);
         }
         else {
-            log_string = formatted_message;
+            log_string = fmt::format(format, std::forward<Args>(args)...);
         }
 
         if (!log_string.empty()) {
-            get_worker().output_log_line(level, log_string);
+            worker.output_log_line(level, log_string);
         }
     }
 };
@@ -0,0 +1,94 @@
+/**
+ * File: mapped_log_file.hpp
+ * Project: yuki
+ * File Created: 2026-10-18 13:58:38
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:42:43
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include "yuki/platform/mapped_file.hpp"
+
+namespace yuki::debug {
+
+/**
+ * @class Mapped_Log_File
+ *
+ * @brief An append-only log file backed by a memory mapping.
+ * The file is pre-extended in large chunks so appending a record is a memcpy into the mapping rather than
+ * a write syscall. Written ranges are synced to disk periodically and the unused tail is truncated on close.
+ */
+class Mapped_Log_File {
+public:
+    static constexpr u64 DEFAULT_CHUNK_SIZE = 4 * 1024 * 1024;
+
+    explicit Mapped_Log_File(u64 chunk_size = DEFAULT_CHUNK_SIZE);
+    ~Mapped_Log_File();
+
+    /**
+     * @brief Open & map the log file, appending after any existing records.
+     * Zero-filled space left over from a previous run which didn't close cleanly is reclaimed.
+     *
+     * @param   filepath    path to the log file
+     *
+     * @return  true if the file was opened, else false
+     */
+    bool open(const std::string& filepath);
+
+    /**
+     * @brief Sync any outstanding records & truncate the file to the written size.
+     */
+    void close();
+
+    /**
+     * @brief Append a record & trailing newline to the log file, extending the mapping if required.
+     *
+     * @param   record  the record to append
+     *
+     * @return  true if the record was written, else false
+     */
+    bool write(const std::string& record);
+
+    /**
+     * @brief Write any records appended since the last sync back to disk.
+     */
+    void sync();
+
+    [[nodiscard]] bool is_open() const;
+    [[nodiscard]] u64 size() const;
+    /**
+     * @brief Get the number of bytes appended since the last sync.
+     */
+    [[nodiscard]] u64 unsynced_size() const;
+
+    Mapped_Log_File(const Mapped_Log_File&) = delete;
+    Mapped_Log_File(Mapped_Log_File&&) = delete;
+    Mapped_Log_File& operator=(const Mapped_Log_File&) = delete;
+    Mapped_Log_File& operator=(Mapped_Log_File&&) = delete;
+
+private:
+    platform::Mapped_File m_file;
+
+    u64 m_chunk_size;
+    u64 m_write_offset;
+    u64 m_synced_offset;
+};
+
+}
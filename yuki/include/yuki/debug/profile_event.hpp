@@ -0,0 +1,71 @@
+/**
+ * File: profile_event.hpp
+ * Project: yuki
+ * File Created: 2026-10-18 14:15:52
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 14:21:17
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+namespace yuki::debug {
+
+/**
+ * @enum Profile_Track
+ *
+ * @brief The timeline a profiling event belongs to, output as the process id of the trace event.
+ */
+enum class Profile_Track : u32 {
+    CPU = 0,
+    GPU = 1
+};
+
+/**
+ * @enum Profile_Event_Type
+ *
+ * @brief The kind of trace event a profiling event is written as.
+ *   COMPLETE: a timed scope ("X")
+ *   INSTANT: a point in time marker ("i")
+ *   COUNTER: a sampled value plotted over time ("C")
+ *   FLOW_BEGIN/FLOW_END: an arrow linking the enclosing scopes of two events with the same id ("s"/"f")
+ */
+enum class Profile_Event_Type : u32 {
+    COMPLETE = 0,
+    INSTANT = 1,
+    COUNTER = 2,
+    FLOW_BEGIN = 3,
+    FLOW_END = 4
+};
+
+/**
+ * @struct Profile_Event
+ *
+ * @brief A single profiling event.
+ * The name must point to storage which outlives the session, the PROFILE_* macros use static literals.
+ */
+struct Profile_Event {
+    const char* name{ nullptr };
+    i64 start_ns{ 0 };
+    // Duration in nanoseconds of COMPLETE events, the sampled value of COUNTER events & the id of FLOW events.
+    i64 value{ 0 };
+    Profile_Track track{ Profile_Track::CPU };
+    Profile_Event_Type type{ Profile_Event_Type::COMPLETE };
+};
+
+}
@@ -0,0 +1,184 @@
+/**
+ * File: profile_stats.hpp
+ * Project: yuki
+ * File Created: 2026-10-18 14:06:48
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:22:43
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "yuki/debug/profile_event.hpp"
+
+namespace yuki::debug {
+
+/**
+ * @class Latency_Histogram
+ *
+ * @brief HDR-style log-linear histogram of durations in nanoseconds.
+ * Each power of two range is split into SUB_BUCKET_COUNT linear buckets, so every recorded value is
+ * reported within ~3% of its true value with a fixed memory footprint and O(1) recording.
+ */
+class Latency_Histogram {
+public:
+    static constexpr u32 SUB_BUCKET_BITS = 5;
+    static constexpr u32 SUB_BUCKET_COUNT = 1U << SUB_BUCKET_BITS;
+    static constexpr u32 MAX_VALUE_BITS = 48;
+    static constexpr u32 BUCKET_COUNT = SUB_BUCKET_COUNT * (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1);
+
+    /**
+     * @brief Record a single duration, values past the histogram's range are clamped to the last bucket.
+     *
+     * @param   value_ns    The duration in nanoseconds.
+     */
+    void record(u64 value_ns);
+
+    /**
+     * @brief Add all values recorded in another histogram to this one.
+     */
+    void merge(const Latency_Histogram& other);
+
+    /**
+     * @brief Remove all recorded values.
+     */
+    void reset();
+
+    /**
+     * @brief Get the value at the given percentile.
+     *
+     * @param   percentile  The percentile in the range [0, 100].
+     *
+     * @return  The value in nanoseconds, or 0 if nothing was recorded.
+     */
+    [[nodiscard]] u64 value_at_percentile(f64 percentile) const;
+
+    [[nodiscard]] u64 count() const;
+    [[nodiscard]] u64 min() const;
+    [[nodiscard]] u64 max() const;
+    [[nodiscard]] f64 mean() const;
+
+private:
+    [[nodiscard]] static u32 bucket_index(u64 value_ns);
+    [[nodiscard]] static u64 bucket_value(u32 index);
+
+    std::array<u32, BUCKET_COUNT> m_buckets{};
+    u64 m_count{ 0 };
+    u64 m_total{ 0 };
+    u64 m_min{ 0 };
+    u64 m_max{ 0 };
+};
+
+/**
+ * @struct Profile_Scope_Stats
+ *
+ * @brief Summary of a single profiled scope over the rolling stats window, times are in microseconds.
+ */
+struct Profile_Scope_Stats {
+    std::string name;
+    u64 call_count{ 0 };
+    f64 calls_per_frame{ 0.0 };
+    f64 min_us{ 0.0 };
+    f64 mean_us{ 0.0 };
+    f64 p50_us{ 0.0 };
+    f64 p95_us{ 0.0 };
+    f64 p99_us{ 0.0 };
+    f64 max_us{ 0.0 };
+};
+
+/**
+ * @class Profile_Stats
+ *
+ * @brief Aggregates profiling events into per-scope histograms over a rolling window of frames.
+ * The window is split into SUB_WINDOW_COUNT sub-windows, each completed sub-window replaces the oldest one and the
+ * summaries are rebuilt from all of them. Queries cover the last window_frames frames and are refreshed every
+ * window_frames / SUB_WINDOW_COUNT frames. Events are recorded by the Instrumentor's drain thread.
+ */
+class Profile_Stats {
+public:
+    // Name of the scope tracking the time between consecutive frame markers.
+    static constexpr const char* FRAME_SCOPE_NAME = "frame";
+    static constexpr u32 SUB_WINDOW_COUNT = 6;
+
+    /**
+     * @brief Record a completed scope into the current sub-window.
+     *
+     * @param   name            The static name of the scope, scopes are keyed by this pointer & track.
+     * @param   duration_ns     The duration of the scope in nanoseconds.
+     * @param   track           The timeline the scope was measured on, GPU scopes are reported as "[GPU] name".
+     */
+    void record(const char* name, i64 duration_ns, Profile_Track track = Profile_Track::CPU);
+
+    /**
+     * @brief Mark the start of a new frame, completing the current sub-window every window_frames / SUB_WINDOW_COUNT
+     * frames.
+     *
+     * @param   timestamp_ns    The steady clock time in nanoseconds of the frame marker.
+     */
+    void mark_frame(i64 timestamp_ns);
+
+    /**
+     * @brief Set how many frames the rolling window covers, defaults to 60.
+     */
+    void set_window_frames(u32 frames);
+
+    /**
+     * @brief Get the summaries of all scopes over the rolling window, sorted by name.
+     */
+    [[nodiscard]] std::vector<Profile_Scope_Stats> get_scope_stats() const;
+
+    /**
+     * @brief Get the summary of a single scope over the rolling window.
+     *
+     * @param   name    The name of the scope, as output by PROFILE_SCOPE/PROFILE_FUNCTION.
+     */
+    [[nodiscard]] std::optional<Profile_Scope_Stats> get_scope_stats(const std::string& name) const;
+
+    /**
+     * @brief Remove all recorded values and summaries.
+     */
+    void reset();
+
+private:
+    struct Sub_Window {
+        // Histograms are reset rather than removed when the sub-window is reused, empty ones are skipped.
+        std::array<std::unordered_map<const char*, Latency_Histogram>, 2> scopes;
+        u32 frames{ 0 };
+    };
+
+    /**
+     * @brief Rebuild the summaries from all sub-windows and start the next sub-window in place of the oldest.
+     */
+    void complete_sub_window();
+
+    std::array<Sub_Window, SUB_WINDOW_COUNT> m_sub_windows;
+    u32 m_current{ 0 };
+    u32 m_window_frames{ 60 };
+    i64 m_last_frame_ns{ 0 };
+
+    mutable std::mutex m_mutex_completed;
+    std::vector<Profile_Scope_Stats> m_completed;
+};
+
+}
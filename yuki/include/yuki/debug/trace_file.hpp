@@ -0,0 +1,226 @@
+/**
+ * File: trace_file.hpp
+ * Project: yuki
+ * File Created: 2026-10-18 14:16:07
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:26:49
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <fstream>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "yuki/debug/profile_event.hpp"
+#include "yuki/platform/mapped_file.hpp"
+
+namespace yuki::debug {
+
+/**
+ * @enum Trace_Record
+ *
+ * @brief The records a binary trace segment is made of, after the segment header.
+ *   STRING: defines the id of an event name, written before the first event using the name
+ *   EVENT: a profiling event, timestamps are stored as a delta to the previous event of the segment
+ *   THREAD: the number of events a thread dropped because its event buffer was full
+ *
+ * Integers are stored as LEB128 varints, signed integers are zigzag encoded first. Every segment starts
+ * with its own string table & timestamp base, so segments can be dropped & converted independently.
+ */
+enum class Trace_Record : u8 {
+    STRING = 0,
+    EVENT = 1,
+    THREAD = 2
+};
+
+/**
+ * @class Trace_Writer
+ *
+ * @brief Streams profiling events into a sequence of bounded binary trace segments.
+ * Segments are written as <stem>.<index><extension>, the oldest segments are deleted once there are
+ * more than max_segments, bounding the on-disk size of a session to max_segment_size * max_segments.
+ * Opening a trace deletes the segments of any earlier trace at the same path first.
+ */
+class Trace_Writer {
+public:
+    static constexpr std::array<char, 4> MAGIC = { 'Y', 'T', 'R', 'C' };
+    static constexpr u8 VERSION = 1;
+
+    Trace_Writer();
+    ~Trace_Writer();
+
+    /**
+     * @brief Open the first segment of a new trace.
+     *
+     * @param   filepath            The path segment names are derived from, e.g. logs/timings.ytrace
+     * @param   max_segment_size    The size in bytes after which a new segment is started.
+     * @param   max_segments        The number of segments kept on disk, 0 keeps every segment.
+     *
+     * @return  true if the first segment was opened, else false.
+     */
+    bool open(const std::string& filepath, u64 max_segment_size, u32 max_segments);
+
+    /**
+     * @brief Write back all buffered records & close the current segment.
+     */
+    void close();
+
+    /**
+     * @brief Encode an event into the write buffer.
+     */
+    void write_event(const Profile_Event& event, u32 thread_index);
+
+    /**
+     * @brief Encode the dropped event count of a thread into the write buffer.
+     */
+    void write_thread(u32 thread_index, u64 dropped_events);
+
+    /**
+     * @brief Write the buffered records to the current segment, starting a new segment if it is full.
+     */
+    void flush();
+
+    [[nodiscard]] bool is_open() const;
+
+    /**
+     * @brief Get the path of the segment with the given index.
+     */
+    [[nodiscard]] std::string get_segment_filepath(u32 segment_index) const;
+
+    Trace_Writer(const Trace_Writer&) = delete;
+    Trace_Writer(Trace_Writer&&) = delete;
+    Trace_Writer& operator=(const Trace_Writer&) = delete;
+    Trace_Writer& operator=(Trace_Writer&&) = delete;
+
+private:
+    /**
+     * @brief Close the current segment (if any) & open the next one, resetting the string table & timestamp base.
+     */
+    bool open_segment(u32 segment_index);
+
+    /**
+     * @brief Delete every existing segment of the trace, so none from an earlier session are mixed into this one.
+     */
+    void remove_segments() const;
+
+    u32 get_string_id(const char* name);
+
+    void write_varint(u64 value);
+    void write_zigzag(i64 value);
+
+    std::string m_filepath;
+    u64 m_max_segment_size;
+    u32 m_max_segments;
+
+    std::ofstream m_stream;
+    std::string m_buffer;
+    u32 m_segment_index;
+    u64 m_segment_size;
+
+    i64 m_last_timestamp;
+    std::unordered_map<const char*, u32> m_string_ids;
+};
+
+/**
+ * @class Trace_Reader
+ *
+ * @brief Decodes a single binary trace segment written by Trace_Writer.
+ */
+class Trace_Reader {
+public:
+    /**
+     * @brief Map a trace segment & validate its header.
+     *
+     * @return  true if the segment was opened, else false.
+     */
+    bool open(const std::string& filepath);
+
+    /**
+     * @brief Decode the next event or thread record, string records are consumed internally.
+     *
+     * @return  The type of record decoded, or nullopt at the end of the segment or a malformed record.
+     */
+    std::optional<Trace_Record> next();
+
+    /**
+     * @brief The last decoded event, its name is valid until the reader is re-opened.
+     */
+    [[nodiscard]] const Profile_Event& event() const;
+
+    /**
+     * @brief The thread of the last decoded event or thread record.
+     */
+    [[nodiscard]] u32 thread_index() const;
+
+    /**
+     * @brief The dropped event count of the last decoded thread record.
+     */
+    [[nodiscard]] u64 dropped_events() const;
+
+    [[nodiscard]] u32 segment_index() const;
+    [[nodiscard]] bool has_error() const;
+
+private:
+    bool read_varint(u64& value);
+    bool read_zigzag(i64& value);
+
+    platform::Mapped_File m_file;
+    u64 m_offset{ 0 };
+    u32 m_segment_index{ 0 };
+    bool m_has_error{ false };
+
+    // Deque keeps the names' addresses stable as new strings are defined.
+    std::deque<std::string> m_strings;
+    std::vector<const char*> m_string_table;
+    i64 m_last_timestamp{ 0 };
+
+    Profile_Event m_event;
+    u32 m_thread_index{ 0 };
+    u64 m_dropped_events{ 0 };
+};
+
+/**
+ * @brief Append the opening of a Chrome trace JSON document to output.
+ */
+void append_json_header(std::string& output);
+
+/**
+ * @brief Append an event as a Chrome trace JSON object to output.
+ *
+ * @param   output          The string to append the event to.
+ * @param   event           The event to append.
+ * @param   thread_index    The index of the thread that recorded the event.
+ */
+void append_json_event(std::string& output, const Profile_Event& event, u32 thread_index);
+
+/**
+ * @brief Append the metadata naming a thread & recording its dropped event count to output.
+ */
+void append_json_thread(std::string& output, u32 thread_index, u64 dropped_events);
+
+/**
+ * @brief Append the process names of the profile tracks & the closing of the document to output.
+ */
+void append_json_footer(std::string& output);
+
+}
@@ -0,0 +1,68 @@
+/**
+ * File: hash.hpp
+ * Project: yuki
+ * File Created: 2026-10-18 14:30:20
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 14:33:56
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <string_view>
+
+namespace yuki {
+
+static constexpr u64 FNV1A_64_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+static constexpr u64 FNV1A_64_PRIME = 0x100000001b3ULL;
+
+/**
+ * @brief Hash a string with 64 bit FNV-1a.
+ * Usable in constant expressions, so names can be hashed at compile time & compared against runtime hashes.
+ *
+ * @param   value   The string to hash.
+ *
+ * @return  The 64 bit hash of value.
+ */
+constexpr u64
+hash_fnv1a_64(std::string_view value)
+{
+    u64 hash = FNV1A_64_OFFSET_BASIS;
+    for (const char character : value) {
+        hash ^= static_cast<u8>(character);
+        hash *= FNV1A_64_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Mix the bits of a 64 bit value, the finalizer of MurmurHash3.
+ * Spreads values such as hashes combined with a seed evenly over every bit.
+ */
+constexpr u64
+hash_mix_64(u64 value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+}
@@ -0,0 +1,78 @@
+/**
+ * File: file_watcher.hpp
+ * Project: yuki
+ * File Created: 2026-10-18 14:43:09
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 14:45:10
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+namespace yuki::platform {
+
+/**
+ * @class File_Watcher
+ *
+ * @brief Watches a directory tree for files which have been written, for reloading assets while the
+ * application runs. Each supported platform implements this class in a corresponding file_watcher_<platform>.cpp
+ * file.
+ */
+class File_Watcher {
+public:
+    File_Watcher();
+    ~File_Watcher();
+
+    /**
+     * @brief Start watching directory & every directory below it, including directories created later.
+     *
+     * @param   directory   path to the root directory to watch
+     *
+     * @return  true if the directory is being watched, else false
+     */
+    bool watch(const std::string& directory);
+
+    /**
+     * @brief Stop watching & release the platform resources.
+     */
+    void close();
+
+    /**
+     * @brief Get the files written or moved into the watched directories since the last poll, without blocking.
+     * Files are only reported once they've been closed, so they're complete when returned.
+     *
+     * @return  the paths of the changed files, the watched directory joined with the path below it & each
+     *          file listed once
+     */
+    [[nodiscard]] std::vector<std::string> poll();
+
+    [[nodiscard]] bool is_open() const;
+
+    File_Watcher(const File_Watcher&) = delete;
+    File_Watcher(File_Watcher&&) = delete;
+    File_Watcher& operator=(const File_Watcher&) = delete;
+    File_Watcher& operator=(File_Watcher&&) = delete;
+
+private:
+    std::shared_ptr<void> m_internal_state;
+};
+
+}
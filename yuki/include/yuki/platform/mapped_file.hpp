@@ -0,0 +1,114 @@
+/**
+ * File: mapped_file.hpp
+ * Project: yuki
+ * File Created: 2026-10-18 13:58:23
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 14:00:24
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <memory>
+
+namespace yuki::platform {
+
+/**
+ * @class Mapped_File
+ *
+ * @brief A file mapped into the process address space. Each supported platform implements this class
+ * in a corresponding mapped_file_<platform>.cpp file.
+ */
+class Mapped_File {
+public:
+    /**
+     * @enum Access
+     *
+     * @brief The access the mapping is created with.
+     *   READ: the file must exist and the mapping is read-only
+     *   READ_WRITE: the file is created if required, writes to the mapping are written back to the file
+     */
+    enum class Access {
+        READ,
+        READ_WRITE
+    };
+
+    Mapped_File();
+    ~Mapped_File();
+
+    /**
+     * @brief Open & map the file at filepath.
+     *
+     * @param   filepath    path to the file to map
+     * @param   access      the access to create the mapping with
+     *
+     * @return  true if the file was opened & mapped, else false
+     */
+    bool open(const std::string& filepath, Access access);
+
+    /**
+     * @brief Unmap & close the file, any previously returned data pointers are invalidated.
+     */
+    void close();
+
+    /**
+     * @brief Grow or shrink a READ_WRITE mapped file to size bytes & remap it.
+     * Any previously returned data pointers are invalidated.
+     *
+     * @param   size    the new size of the file in bytes
+     *
+     * @return  true if the file was resized & remapped, else false
+     */
+    bool resize(u64 size);
+
+    /**
+     * @brief Write a range of the mapping back to disk, blocking until complete.
+     *
+     * @param   offset  offset in bytes of the range to write
+     * @param   length  length in bytes of the range to write
+     *
+     * @return  true if the range was written, else false
+     */
+    bool sync(u64 offset, u64 length);
+
+    [[nodiscard]] u8* data();
+    [[nodiscard]] const u8* data() const;
+    [[nodiscard]] u64 size() const;
+    [[nodiscard]] bool is_open() const;
+    [[nodiscard]] const std::string& filepath() const;
+
+    /**
+     * @brief Get the granularity which sync offsets are aligned to.
+     */
+    [[nodiscard]] static u64 page_size();
+
+    Mapped_File(const Mapped_File&) = delete;
+    Mapped_File(Mapped_File&&) = delete;
+    Mapped_File& operator=(const Mapped_File&) = delete;
+    Mapped_File& operator=(Mapped_File&&) = delete;
+
+private:
+    std::shared_ptr<void> m_internal_state;
+
+    std::string m_filepath;
+    Access m_access;
+    u8* m_data;
+    u64 m_size;
+};
+
+}
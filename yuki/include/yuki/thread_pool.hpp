@@ -0,0 +1,105 @@
+/**
+ * File: thread_pool.hpp
+ * Project: yuki
+ * File Created: 2026-10-18 14:37:38
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 14:39:39
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace yuki {
+
+/**
+ * @class Thread_Pool
+ *
+ * @brief A fixed set of worker threads running tasks from a shared queue in submission order.
+ * Meant for batches of independent CPU work such as decoding assets, tasks must not touch the graphics context.
+ */
+class Thread_Pool {
+public:
+    /**
+     * @brief Start the worker threads.
+     *
+     * @param   thread_count    The number of workers, 0 uses one less than the number of hardware threads so the
+     *                          submitting thread keeps a core to itself.
+     */
+    explicit Thread_Pool(u32 thread_count = 0);
+
+    /**
+     * @brief Finish every queued task & join the worker threads.
+     */
+    ~Thread_Pool();
+
+    Thread_Pool(const Thread_Pool&) = delete;
+    Thread_Pool(Thread_Pool&&) = delete;
+    Thread_Pool& operator=(const Thread_Pool&) = delete;
+    Thread_Pool& operator=(Thread_Pool&&) = delete;
+
+    /**
+     * @brief Queue a task to run on a worker thread.
+     *
+     * @param   task    A callable taking no arguments.
+     *
+     * @return  A future for the task's result, exceptions thrown by the task are rethrown from get().
+     */
+    template<typename Task>
+    auto submit(Task&& task) -> std::future<std::invoke_result_t<Task>>
+    {
+        using Result = std::invoke_result_t<Task>;
+
+        // std::function must be copyable, so the packaged_task is shared rather than moved into it.
+        auto packaged_task = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+        auto future = packaged_task->get_future();
+        push([packaged_task]() { (*packaged_task)(); });
+
+        return future;
+    }
+
+    /**
+     * @brief Get the number of worker threads.
+     */
+    [[nodiscard]] u32 thread_count() const;
+
+private:
+    void push(std::function<void()> task);
+
+    /**
+     * @brief Worker thread loop, runs queued tasks until the pool is destroyed & the queue is empty.
+     */
+    void run_worker();
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping{ false };
+};
+
+}
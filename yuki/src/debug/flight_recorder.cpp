@@ -0,0 +1,230 @@
+/**
+ * File: flight_recorder.cpp
+ * Project: yuki
+ * File Created: 2026-10-18 14:22:14
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:44:33
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "debug/flight_recorder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+
+#include "debug/logger.hpp"
+#include "debug/trace_file.hpp"
+
+namespace yuki::debug {
+
+namespace {
+
+constexpr f64 NS_PER_MS = 1000000.0;
+// Minimum time between automatic dumps, so a slow loading screen doesn't produce a dump per frame.
+constexpr i64 HITCH_DUMP_INTERVAL_NS = 10LL * 1000 * 1000 * 1000;
+constexpr const char* FRAME_NAME = "frame";
+
+i64
+get_time_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+#ifdef __linux__
+void
+handle_dump_signal(int signal)
+{
+    (void)signal;
+    Flight_Recorder::get().request_dump();
+}
+#endif
+
+}
+
+// Flight_Recorder
+Flight_Recorder&
+Flight_Recorder::get()
+{
+    static Flight_Recorder instance;
+    return instance;
+}
+
+Flight_Recorder::~Flight_Recorder()
+{
+    shutdown();
+}
+
+void
+Flight_Recorder::set_output_directory(const std::string& directory)
+{
+    m_output_directory = directory;
+}
+
+void
+Flight_Recorder::set_hitch_threshold(f64 threshold_ms)
+{
+    m_hitch_threshold_ns = static_cast<i64>(threshold_ms * NS_PER_MS);
+}
+
+void
+Flight_Recorder::install_signal_handler()
+{
+#ifdef __linux__
+    std::signal(SIGUSR1, handle_dump_signal);
+#endif
+}
+
+void
+Flight_Recorder::mark_frame()
+{
+    const i64 now_ns = get_time_ns();
+
+    // The first mark only starts the first frame.
+    if (m_frame_start_ns != 0) {
+        const i64 duration_ns = now_ns - m_frame_start_ns;
+        m_frames.at(m_frame_count % MAX_FRAMES) = {
+            FRAME_NAME, m_frame_start_ns, duration_ns, Profile_Track::CPU, Profile_Event_Type::COMPLETE
+        };
+        m_frame_count++;
+
+        if (m_hitch_threshold_ns > 0 && duration_ns > m_hitch_threshold_ns &&
+            now_ns - m_last_hitch_dump_ns > HITCH_DUMP_INTERVAL_NS) {
+            m_last_hitch_dump_ns = now_ns;
+            start_dump("hitch");
+        }
+    }
+    m_frame_start_ns = now_ns;
+
+    if (m_dump_requested.exchange(false)) {
+        start_dump("request");
+    }
+}
+
+void
+Flight_Recorder::record_scope(const char* name, i64 start_ns, i64 duration_ns)
+{
+    m_scopes.at(m_scope_count % MAX_SCOPES) = {
+        name, start_ns, duration_ns, Profile_Track::CPU, Profile_Event_Type::COMPLETE
+    };
+    m_scope_count++;
+}
+
+void
+Flight_Recorder::request_dump()
+{
+    m_dump_requested = true;
+}
+
+void
+Flight_Recorder::shutdown()
+{
+    if (m_dump_thread != nullptr && m_dump_thread->joinable()) {
+        m_dump_thread->join();
+    }
+    m_dump_thread.reset();
+}
+
+void
+Flight_Recorder::start_dump(const char* reason)
+{
+    // Only one dump is written at a time, the buffers it's writing from are reused by the next one.
+    if (m_dump_in_progress.exchange(true)) {
+        Logger::warn(
+            LOG_CHANNEL_DEFAULT, "Flight_Recorder skipped a {} dump, the previous dump is still being written", reason
+        );
+        return;
+    }
+    shutdown();
+
+    const size_t frame_count = std::min(m_frame_count, MAX_FRAMES);
+    for (size_t i = 0; i < frame_count; ++i) {
+        m_dump_frames.at(i) = m_frames.at((m_frame_count - frame_count + i) % MAX_FRAMES);
+    }
+
+    const size_t scope_count = std::min(m_scope_count, MAX_SCOPES);
+    for (size_t i = 0; i < scope_count; ++i) {
+        m_dump_scopes.at(i) = m_scopes.at((m_scope_count - scope_count + i) % MAX_SCOPES);
+    }
+
+    const auto timestamp = fmt::format(
+        "{:%Y%m%dT%H%M%S}", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now())
+    );
+    const auto filepath =
+        (std::filesystem::path(m_output_directory) / fmt::format("flight.{}.{}.json", timestamp, reason)).string();
+
+    m_dump_thread = std::make_unique<std::thread>([this, filepath, frame_count, scope_count]() {
+        write_dump(filepath, frame_count, scope_count);
+        m_dump_in_progress = false;
+    });
+}
+
+void
+Flight_Recorder::write_dump(const std::string& filepath, size_t frame_count, size_t scope_count) const
+{
+    std::ofstream output_stream(filepath);
+    if (!output_stream.is_open()) {
+        Logger::error(LOG_CHANNEL_DEFAULT, "Flight_Recorder failed to open dump file {}", filepath);
+        return;
+    }
+
+    std::string output;
+    append_json_header(output);
+
+    // Scopes older than the oldest frame still in the ring have no frame to be compared against.
+    const i64 first_frame_ns = frame_count > 0 ? m_dump_frames.at(0).start_ns : 0;
+    f64 max_frame_ms = 0.0;
+    for (size_t i = 0; i < frame_count; ++i) {
+        append_json_event(output, m_dump_frames.at(i), 0);
+        max_frame_ms = std::max(max_frame_ms, static_cast<f64>(m_dump_frames.at(i).value) / NS_PER_MS);
+    }
+    for (size_t i = 0; i < scope_count; ++i) {
+        if (m_dump_scopes.at(i).start_ns >= first_frame_ns) {
+            append_json_event(output, m_dump_scopes.at(i), 0);
+        }
+    }
+
+    append_json_thread(output, 0, 0);
+    append_json_footer(output);
+    output_stream << output;
+
+    Logger::notice(
+        LOG_CHANNEL_DEFAULT,
+        "Flight_Recorder wrote {} frames to {}, slowest frame {:.2f}ms",
+        frame_count,
+        filepath,
+        max_frame_ms
+    );
+}
+
+// Flight_Recorder_Scope
+Flight_Recorder_Scope::Flight_Recorder_Scope(const char* name)
+  : m_name(name)
+  , m_start_ns(get_time_ns())
+{
+}
+
+Flight_Recorder_Scope::~Flight_Recorder_Scope()
+{
+    Flight_Recorder::get().record_scope(m_name, m_start_ns, get_time_ns() - m_start_ns);
+}
+
+}
@@ -3,7 +3,7 @@
  * Project: yuki
  * File Created: 2023-03-06 20:09:27
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-04-26 15:23:04
+ * Last Modified: 2026-10-18 16:24:43
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -24,13 +24,97 @@
 
 #include "debug/instrumentor.hpp"
 
-#include <iomanip>
-#include <sstream>
+#include <algorithm>
+#include <filesystem>
 
 #include "debug/logger.hpp"
 
 namespace yuki::debug {
 
+namespace {
+
+constexpr u32 DRAIN_INTERVAL_MS = 10;
+constexpr const char* BINARY_TRACE_EXTENSION = ".ytrace";
+
+// Releases the thread's event buffer for reuse when the thread exits.
+struct Thread_Event_Buffer {
+    Thread_Event_Buffer() = default;
+
+    ~Thread_Event_Buffer()
+    {
+        if (buffer != nullptr) {
+            buffer->release();
+        }
+    }
+
+    Thread_Event_Buffer(const Thread_Event_Buffer&) = delete;
+    Thread_Event_Buffer(Thread_Event_Buffer&&) = delete;
+    Thread_Event_Buffer& operator=(const Thread_Event_Buffer&) = delete;
+    Thread_Event_Buffer& operator=(Thread_Event_Buffer&&) = delete;
+
+    Profile_Event_Buffer* buffer{ nullptr };
+};
+
+thread_local Thread_Event_Buffer t_event_buffer;
+
+i64
+to_ns(std::chrono::steady_clock::time_point time_point)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time_point.time_since_epoch()).count();
+}
+
+}
+
+// Profile_Event_Buffer
+Profile_Event_Buffer::Profile_Event_Buffer(u32 thread_index)
+  : m_events()
+  , m_head(0)
+  , m_tail(0)
+  , m_dropped(0)
+  , m_owned(true)
+  , m_thread_index(thread_index)
+{
+}
+
+void
+Profile_Event_Buffer::push(const Profile_Event& event)
+{
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= CAPACITY) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    m_events[head & (CAPACITY - 1)] = event; // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    m_head.store(head + 1, std::memory_order_release);
+}
+
+u64
+Profile_Event_Buffer::take_dropped_count()
+{
+    return m_dropped.exchange(0, std::memory_order_relaxed);
+}
+
+u32
+Profile_Event_Buffer::thread_index() const
+{
+    return m_thread_index;
+}
+
+bool
+Profile_Event_Buffer::try_acquire()
+{
+    // Acquire the previous owner's writes to the ring before pushing after them.
+    return !m_owned.exchange(true, std::memory_order_acq_rel);
+}
+
+void
+Profile_Event_Buffer::release()
+{
+    m_owned.store(false, std::memory_order_release);
+}
+
+// Instrumentor
 Instrumentor&
 Instrumentor::get()
 {
@@ -46,58 +130,195 @@ Instrumentor::~Instrumentor()
 void
 Instrumentor::begin_session(const std::string& name, const std::string& filepath)
 {
-    std::lock_guard lock(m_mutex);
-    if (!m_current_session.empty()) {
+    if (m_session_active.load()) {
         Logger::error(
-            "yuki", "Instrumentor::begin_session called with session {} when session {} already open.", name, m_current_session
+            LOG_CHANNEL_DEFAULT,
+            "Instrumentor::begin_session called with session {} when session {} already open.",
+            name,
+            m_current_session
         );
-        internal_end_session();
+        end_session();
     }
 
-    m_output_stream.open(filepath);
+    std::lock_guard lock(m_mutex);
+    m_binary_trace = std::filesystem::path(filepath).extension() == BINARY_TRACE_EXTENSION;
+
+    bool opened = false;
+    if (m_binary_trace) {
+        opened = m_trace_writer.open(filepath, m_max_segment_size, m_max_segments);
+    }
+    else {
+        m_output_stream.open(filepath);
+        opened = m_output_stream.is_open();
+    }
+
+    if (opened) {
+        // Throw away anything recorded by threads which raced the end of a previous session.
+        drain_buffers(true);
+        m_stats.reset();
 
-    if (m_output_stream.is_open()) {
         m_current_session = name;
         // Write our file header
-        m_output_stream << R"({"otherData": {},"traceEvents":[{})";
-        m_output_stream.flush();
+        if (!m_binary_trace) {
+            append_json_header(m_write_buffer);
+        }
+
+        m_session_active = true;
+        m_drain_thread = std::make_unique<std::thread>(&Instrumentor::drain_events, this);
     }
     else {
-        Logger::error("yuki", "Instrumentor::begin_session failed to open result files {}", filepath);
+        Logger::error(LOG_CHANNEL_DEFAULT, "Instrumentor::begin_session failed to open result files {}", filepath);
     }
 }
 
+void
+Instrumentor::set_trace_limits(u64 max_segment_size, u32 max_segments)
+{
+    std::lock_guard lock(m_mutex);
+    m_max_segment_size = max_segment_size;
+    m_max_segments = max_segments;
+}
+
 void
 Instrumentor::end_session()
 {
+    m_session_active = false;
+    if (m_drain_thread != nullptr && m_drain_thread->joinable()) {
+        m_drain_thread->join();
+    }
+    m_drain_thread.reset();
+
     std::lock_guard lock(m_mutex);
     internal_end_session();
 }
 
 void
-Instrumentor::output_profile_result(
-    const std::string& name,
-    std::chrono::duration<f64, std::micro> start_time,
-    std::chrono::microseconds elapsed_time,
-    std::thread::id thread_id
-)
+Instrumentor::record_event(const char* name, i64 start_ns, i64 duration_ns, Profile_Track track)
 {
-    std::stringstream json;
-    json << std::setprecision(3) << std::fixed;
-    json << ",{";
-    json << R"("cat":"function",)";
-    json << R"("dur":)" << elapsed_time.count() << ',';
-    json << R"("name":")" << name << "\",";
-    json << R"("ph":"X",)";
-    json << R"("pid":0,)";
-    json << R"("tid":)" << thread_id << ",";
-    json << R"("ts":)" << start_time.count();
-    json << "}";
+    if (!m_session_active.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    get_thread_buffer().push({ name, start_ns, duration_ns, track, Profile_Event_Type::COMPLETE });
+}
 
+void
+Instrumentor::record_instant(const char* name)
+{
+    if (!m_session_active.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const i64 timestamp_ns = to_ns(std::chrono::steady_clock::now());
+    get_thread_buffer().push({ name, timestamp_ns, 0, Profile_Track::CPU, Profile_Event_Type::INSTANT });
+}
+
+void
+Instrumentor::record_counter(const char* name, i64 value)
+{
+    if (!m_session_active.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const i64 timestamp_ns = to_ns(std::chrono::steady_clock::now());
+    get_thread_buffer().push({ name, timestamp_ns, value, Profile_Track::CPU, Profile_Event_Type::COUNTER });
+}
+
+void
+Instrumentor::record_flow_begin(const char* name, u64 id)
+{
+    if (!m_session_active.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const i64 timestamp_ns = to_ns(std::chrono::steady_clock::now());
+    const auto flow_id = static_cast<i64>(id);
+    get_thread_buffer().push({ name, timestamp_ns, flow_id, Profile_Track::CPU, Profile_Event_Type::FLOW_BEGIN });
+}
+
+void
+Instrumentor::record_flow_end(const char* name, u64 id)
+{
+    if (!m_session_active.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const i64 timestamp_ns = to_ns(std::chrono::steady_clock::now());
+    const auto flow_id = static_cast<i64>(id);
+    get_thread_buffer().push({ name, timestamp_ns, flow_id, Profile_Track::CPU, Profile_Event_Type::FLOW_END });
+}
+
+bool
+Instrumentor::is_session_active() const
+{
+    return m_session_active.load(std::memory_order_relaxed);
+}
+
+void
+Instrumentor::mark_frame()
+{
+    if (!m_session_active.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const i64 timestamp_ns = to_ns(std::chrono::steady_clock::now());
+    const char* name = Profile_Stats::FRAME_SCOPE_NAME;
+    get_thread_buffer().push({ name, timestamp_ns, 0, Profile_Track::CPU, Profile_Event_Type::INSTANT });
+}
+
+void
+Instrumentor::set_stats_window(u32 frames)
+{
     std::lock_guard lock(m_mutex);
-    if (!m_current_session.empty()) {
-        m_output_stream << json.str();
-        m_output_stream.flush();
+    m_stats.set_window_frames(frames);
+}
+
+std::vector<Profile_Scope_Stats>
+Instrumentor::get_scope_stats() const
+{
+    return m_stats.get_scope_stats();
+}
+
+std::optional<Profile_Scope_Stats>
+Instrumentor::get_scope_stats(const std::string& name) const
+{
+    return m_stats.get_scope_stats(name);
+}
+
+void
+Instrumentor::log_scope_stats() const
+{
+    const auto scopes = m_stats.get_scope_stats();
+    if (scopes.empty()) {
+        return;
+    }
+
+    Logger::debug(
+        LOG_CHANNEL_DEFAULT,
+        "{: <48} {: >10} {: >10} {: >10} {: >10} {: >10} {: >10} {: >10}",
+        "scope (us)",
+        "calls/frm",
+        "min",
+        "mean",
+        "p50",
+        "p95",
+        "p99",
+        "max"
+    );
+
+    for (const auto& scope : scopes) {
+        Logger::debug(
+            LOG_CHANNEL_DEFAULT,
+            "{: <48.48} {: >10.2f} {: >10.2f} {: >10.2f} {: >10.2f} {: >10.2f} {: >10.2f} {: >10.2f}",
+            scope.name,
+            scope.calls_per_frame,
+            scope.min_us,
+            scope.mean_us,
+            scope.p50_us,
+            scope.p95_us,
+            scope.p99_us,
+            scope.max_us
+        );
     }
 }
 
@@ -105,17 +326,128 @@ void
 Instrumentor::internal_end_session()
 {
     if (!m_current_session.empty()) {
-        // Write our file footer
-        m_output_stream << "]}";
-        m_output_stream.flush();
+        drain_buffers();
+
+        // Name each thread's track & record how many of its events were lost to a full buffer.
+        std::lock_guard lock(m_mutex_buffers);
+        for (const auto& buffer : m_buffers) {
+            const u64 dropped = buffer->take_dropped_count();
+            if (m_binary_trace) {
+                m_trace_writer.write_thread(buffer->thread_index(), dropped);
+            }
+            else {
+                append_json_thread(m_write_buffer, buffer->thread_index(), dropped);
+            }
+
+            if (dropped > 0) {
+                Logger::warn(
+                    LOG_CHANNEL_DEFAULT,
+                    "Instrumentor dropped {} events from thread {}, buffer full",
+                    dropped,
+                    buffer->thread_index()
+                );
+            }
+        }
 
-        m_output_stream.close();
+        if (m_binary_trace) {
+            m_trace_writer.close();
+        }
+        else {
+            // Write our file footer
+            append_json_footer(m_write_buffer);
+            m_output_stream << m_write_buffer;
+            m_output_stream.flush();
+            m_output_stream.close();
+        }
+
+        m_write_buffer.clear();
         m_current_session.clear();
     }
 }
 
-Instrumentor_Timer::Instrumentor_Timer(std::string name)
-  : m_name(std::move(name))
+Profile_Event_Buffer&
+Instrumentor::get_thread_buffer()
+{
+    if (t_event_buffer.buffer == nullptr) {
+        std::lock_guard lock(m_mutex_buffers);
+
+        // Reuse the buffer of an exited thread before allocating a new one.
+        const auto released = std::find_if(m_buffers.begin(), m_buffers.end(), [](const auto& buffer) {
+            return buffer->try_acquire();
+        });
+
+        if (released != m_buffers.end()) {
+            t_event_buffer.buffer = released->get();
+        }
+        else {
+            m_buffers.emplace_back(std::make_unique<Profile_Event_Buffer>(static_cast<u32>(m_buffers.size())));
+            t_event_buffer.buffer = m_buffers.back().get();
+        }
+    }
+
+    return *t_event_buffer.buffer;
+}
+
+void
+Instrumentor::drain_events()
+{
+    while (m_session_active.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(DRAIN_INTERVAL_MS));
+
+        std::lock_guard lock(m_mutex);
+        drain_buffers();
+    }
+}
+
+void
+Instrumentor::drain_buffers(bool discard)
+{
+    std::lock_guard lock(m_mutex_buffers);
+    for (const auto& buffer : m_buffers) {
+        if (discard) {
+            buffer->drain([](const Profile_Event&) {});
+            buffer->take_dropped_count();
+            continue;
+        }
+
+        const u32 thread_index = buffer->thread_index();
+        buffer->drain([this, thread_index](const Profile_Event& event) { write_event(event, thread_index); });
+    }
+
+    if (discard) {
+        return;
+    }
+
+    if (m_binary_trace) {
+        m_trace_writer.flush();
+    }
+    else if (!m_write_buffer.empty()) {
+        m_output_stream << m_write_buffer;
+        m_write_buffer.clear();
+    }
+}
+
+void
+Instrumentor::write_event(const Profile_Event& event, u32 thread_index)
+{
+    if (event.type == Profile_Event_Type::COMPLETE) {
+        m_stats.record(event.name, event.value, event.track);
+    }
+    else if (event.type == Profile_Event_Type::INSTANT && event.name == Profile_Stats::FRAME_SCOPE_NAME) {
+        m_stats.mark_frame(event.start_ns);
+    }
+
+    if (m_binary_trace) {
+        m_trace_writer.write_event(event, thread_index);
+    }
+    else {
+        append_json_event(m_write_buffer, event, thread_index);
+    }
+}
+
+// Instrumentor_Timer
+Instrumentor_Timer::Instrumentor_Timer(const char* name)
+  : m_name(name)
   , m_start_time(std::chrono::steady_clock::now())
   , m_stopped(false)
 {
@@ -132,11 +464,9 @@ void
 Instrumentor_Timer::stop()
 {
     const auto end_time{ std::chrono::steady_clock::now() };
-    const auto elapsed_time{ std::chrono::time_point_cast<std::chrono::microseconds>(end_time).time_since_epoch() -
-                             std::chrono::time_point_cast<std::chrono::microseconds>(m_start_time).time_since_epoch() };
-    const auto high_res_start_time{ std::chrono::duration<f64, std::micro>{ m_start_time.time_since_epoch() } };
+    const i64 start_ns = to_ns(m_start_time);
 
-    Instrumentor::get().output_profile_result(m_name, high_res_start_time, elapsed_time, std::this_thread::get_id());
+    Instrumentor::get().record_event(m_name, start_ns, to_ns(end_time) - start_ns);
 
     m_stopped = true;
 }
@@ -3,7 +3,7 @@
  * Project: yuki
  * File Created: 2023-02-25 11:46:28
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-04-26 15:20:44
+ * Last Modified: 2026-10-18 16:28:51
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -22,11 +22,20 @@
  * ==================
  */
 
+#include <algorithm>
+#include <array>
 #include <filesystem>
 #include <iostream>
+#include <vector>
+
+#ifdef YUKI_HAS_ZLIB
+#include <zlib.h>
+#endif
 
 #include "debug/logger.hpp"
 
+#include "debug/instrumentor.hpp"
+
 using namespace yuki;
 using namespace std::chrono;
 
@@ -40,6 +49,103 @@ write_direct_log(const std::string& format, Args&&... args)
     std::cout << formatted_message << std::endl;
 }
 
+#ifdef YUKI_HAS_ZLIB
+constexpr bool compression_supported = true;
+#else
+constexpr bool compression_supported = false;
+#endif
+
+constexpr size_t COMPRESS_BUFFER_LENGTH = 64 * 1024;
+constexpr const char* COMPRESSED_EXTENSION = ".gz";
+constexpr const char* TEMPORARY_EXTENSION = ".tmp";
+// The mapped log file is synced when the queue drains, or once this much is unsynced while it never does.
+constexpr u64 MAPPED_SYNC_BYTES = 256 * 1024;
+constexpr std::chrono::milliseconds MAPPED_SYNC_INTERVAL{ 1000 };
+// Source names recently resolved by a thread, looked up by the address of the name.
+constexpr size_t CHANNEL_SOURCE_CACHE_SIZE = 16;
+
+struct Channel_Source {
+    const char* address{ nullptr };
+    std::string name;
+    yuki::debug::Log_Channel channel{ yuki::debug::LOG_CHANNEL_DEFAULT };
+};
+
+thread_local std::array<Channel_Source, CHANNEL_SOURCE_CACHE_SIZE> t_channel_sources;
+
+/**
+ * @brief Build a unique, timestamped filepath to move the active log file to when rotating.
+ * e.g. logs/app.log -> logs/app.20230225T114628.log
+ */
+std::string
+get_rotated_filepath(const std::string& log_filepath)
+{
+    const std::filesystem::path path(log_filepath);
+    const auto timestamp = fmt::format(
+        "{:%Y%m%dT%H%M%S}", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now())
+    );
+
+    const auto base_filepath = path.parent_path() / fmt::format("{}.{}", path.stem().string(), timestamp);
+    auto rotated_filepath = base_filepath.string() + path.extension().string();
+
+    u32 duplicate_count = 0;
+    while (std::filesystem::exists(rotated_filepath) ||
+           std::filesystem::exists(rotated_filepath + COMPRESSED_EXTENSION)) {
+        rotated_filepath = fmt::format("{}_{:03}{}", base_filepath.string(), ++duplicate_count, path.extension().string());
+    }
+
+    return rotated_filepath;
+}
+
+#ifdef YUKI_HAS_ZLIB
+/**
+ * @brief Gzip a rotated log segment to <filepath>.gz, removing the original once the archive is complete.
+ */
+bool
+compress_log_file(const std::string& filepath)
+{
+    std::ifstream input(filepath, std::ifstream::in | std::ifstream::binary);
+    if (!input.is_open()) {
+        return false;
+    }
+
+    const std::string compressed_filepath = filepath + COMPRESSED_EXTENSION;
+    const std::string temporary_filepath = compressed_filepath + TEMPORARY_EXTENSION;
+
+    gzFile output = gzopen(temporary_filepath.c_str(), "wb");
+    if (output == nullptr) {
+        return false;
+    }
+
+    bool success = true;
+    std::vector<char> buffer(COMPRESS_BUFFER_LENGTH);
+    while (input) {
+        input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const auto bytes_read = input.gcount();
+        if (bytes_read > 0 && gzwrite(output, buffer.data(), static_cast<u32>(bytes_read)) != bytes_read) {
+            success = false;
+            break;
+        }
+    }
+
+    success = (gzclose(output) == Z_OK) && success;
+    input.close();
+
+    std::error_code error;
+    if (success) {
+        std::filesystem::rename(temporary_filepath, compressed_filepath, error);
+        success = !error;
+    }
+
+    if (!success) {
+        std::filesystem::remove(temporary_filepath, error);
+        return false;
+    }
+
+    std::filesystem::remove(filepath, error);
+    return true;
+}
+#endif
+
 } // namespace
 
 namespace yuki::debug {
@@ -99,11 +205,20 @@ Logger_Util::get_mutex()
 
 Logger_Worker::Logger_Worker()
   : m_app_log_thread(nullptr)
+  , m_compress_thread(nullptr)
   , m_is_app_interrupted(false)
   , m_severity_level(Severity::LOG_ERROR)
+  , m_log_records_queued(0)
+  , m_log_records_written(0)
+  , m_flush_record(0)
   , m_file_log_enabled(false)
   , m_console_log_enabled(false)
+  , m_file_mode(Log_File_Mode::STREAM)
+  , m_log_file_size(0)
+  , m_channel_count(0)
+  , m_channels_full_reported(false)
 {
+    register_channel("yuki", {});
 }
 
 Logger_Worker::~Logger_Worker()
@@ -122,9 +237,18 @@ Logger_Worker::initialize(const std::string& log_filepath)
     try {
         this->m_log_filepath = log_filepath;
 
-        m_app_log_thread = std::make_unique<std::thread>(&Logger_Worker::write_to_log_file, this);
-        m_app_log_thread->detach();
+        // Reset before the threads start, they exit once they see it set.
         m_is_app_interrupted = false;
+
+        // Joined by drop_all, so the records queued before exit are still written.
+        if (m_app_log_thread == nullptr || !m_app_log_thread->joinable()) {
+            m_app_log_thread = std::make_unique<std::thread>(&Logger_Worker::write_to_log_file, this);
+        }
+
+        // Joined by drop_all, so segments rotated just before exit are still compressed.
+        if (compression_supported && (m_compress_thread == nullptr || !m_compress_thread->joinable())) {
+            m_compress_thread = std::make_unique<std::thread>(&Logger_Worker::compress_rotated_files, this);
+        }
     }
     catch (const std::exception& e) {
         write_direct_log("Failed to create logger threads({})", e.what());
@@ -144,10 +268,20 @@ Logger_Worker::initialize(const std::string& log_filepath)
 void
 Logger_Worker::output_log_line(Severity level, const std::string& log_record)
 {
+    PROFILE_FUNCTION();
     std::lock_guard<std::mutex> lock(m_mutex_log_queue);
 
     if (m_file_log_enabled) {
         log_queue.push(log_record);
+
+        const u64 record_id = m_log_records_queued++;
+        PROFILE_FLOW_BEGIN("log record", record_id);
+
+        // Errors are written through to disk as soon as they're written, in case the application is about to crash.
+        if (level >= Severity::LOG_ERROR && level != Severity::LOG_MANUAL) {
+            m_flush_record.store(record_id + 1, std::memory_order_relaxed);
+        }
+        PROFILE_COUNTER("log queue depth", log_queue.size());
     }
 
     if (m_console_log_enabled) {
@@ -193,30 +327,58 @@ Logger_Worker::output_log_line(Severity level, const std::string& log_record)
 void
 Logger_Worker::write_to_log_file()
 {
-    while (!m_is_app_interrupted) {
+    while (true) {
         try {
             std::string tmp;
             if (!log_queue.pop(tmp)) {
+                // Write back anything buffered now that the queue is drained, instead of once per record
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex_log_file);
+                    flush_log_file();
+                }
+
+                // The queue is drained before exiting, so the records logged right before shutdown are kept.
+                if (m_is_app_interrupted) {
+                    break;
+                }
+
                 // Wait for 100 ms to get data filled in queue
                 Logger_Util::sleep(SLEEP_IN_MS);
                 continue;
             }
 
-            if (!m_log_file_stream.is_open()) {
-                m_log_file_stream.open(m_log_filepath, std::ofstream::out | std::ofstream::app | std::ofstream::binary);
+            PROFILE_SCOPE("Logger_Worker::write_log_record");
+            const u64 record_id = m_log_records_written++;
+            PROFILE_FLOW_END("log record", record_id);
+
+            std::lock_guard<std::mutex> lock(m_mutex_log_file);
+
+            if (is_log_file_open() && should_rotate(tmp.size() + 1)) {
+                rotate_log_file();
+            }
+
+            if (!is_log_file_open()) {
+                open_log_file();
             }
 
             // Write errors to stdout when stream error occurred
-            if (m_log_file_stream.bad() || m_log_file_stream.fail()) {
-                write_direct_log(tmp);
-                m_log_file_stream.close();
+            if (write_log_record(tmp)) {
+                m_log_file_size += tmp.size() + 1;
+
+                if (record_id + 1 == m_flush_record.load(std::memory_order_relaxed)) {
+                    flush_log_file();
+                }
+                // Bound how much a crash can lose while records keep arriving faster than they're written.
+                else if (m_file_mode == Log_File_Mode::MAPPED &&
+                    (m_mapped_log_file.unsynced_size() >= MAPPED_SYNC_BYTES ||
+                     std::chrono::steady_clock::now() - m_log_file_synced >= MAPPED_SYNC_INTERVAL)) {
+                    m_mapped_log_file.sync();
+                    m_log_file_synced = std::chrono::steady_clock::now();
+                }
             }
             else {
-                {
-                    std::lock_guard<std::mutex> lock(m_mutex_log_file);
-                    m_log_file_stream << std::string(tmp.begin(), tmp.end()) << std::endl;
-                }
-                m_log_file_stream.flush();
+                write_direct_log(tmp);
+                close_log_file();
             }
         }
         catch (std::exception& ex) {
@@ -236,6 +398,217 @@ Logger_Worker::write_to_log_file()
     }
 }
 
+void
+Logger_Worker::compress_rotated_files()
+{
+#ifdef YUKI_HAS_ZLIB
+    while (true) {
+        std::string filepath;
+        if (!m_compress_queue.pop(filepath)) {
+            // The queue is drained before exiting, an interrupted compression would leave a truncated file.
+            if (m_is_app_interrupted) {
+                break;
+            }
+            Logger_Util::sleep(SLEEP_IN_MS);
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex_rotated_files);
+
+            // The segment may already have been removed by the retention limit.
+            if (!std::filesystem::exists(filepath)) {
+                continue;
+            }
+
+            // Keep the writer's retention sweep away from the segment & its .gz while they're in flux.
+            m_compressing_filepath = filepath;
+        }
+
+        const bool compressed = compress_log_file(filepath);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex_rotated_files);
+            m_compressing_filepath.clear();
+        }
+
+        if (!compressed) {
+            write_direct_log("LoggerWorker::CompressRotatedFiles() failed to compress rotated log file({})", filepath);
+        }
+
+        // The log file & rotation config are owned by m_mutex_log_file, sweep with a snapshot of them.
+        std::string log_filepath;
+        u32 max_rotated_files = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex_log_file);
+            log_filepath = m_log_filepath;
+            max_rotated_files = m_rotation_config.max_rotated_files;
+        }
+
+        remove_expired_log_files(log_filepath, max_rotated_files);
+    }
+#endif
+}
+
+bool
+Logger_Worker::should_rotate(size_t record_size) const
+{
+    if (m_rotation_config.max_file_size > 0 && m_log_file_size > 0 &&
+        m_log_file_size + record_size > m_rotation_config.max_file_size) {
+        return true;
+    }
+
+    if (m_rotation_config.max_file_age.count() > 0 &&
+        std::chrono::steady_clock::now() - m_log_file_opened >= m_rotation_config.max_file_age) {
+        return true;
+    }
+
+    return false;
+}
+
+void
+Logger_Worker::rotate_log_file()
+{
+    close_log_file();
+
+    const auto rotated_filepath = get_rotated_filepath(m_log_filepath);
+
+    std::error_code error;
+    std::filesystem::rename(m_log_filepath, rotated_filepath, error);
+    if (error) {
+        write_direct_log(
+            "LoggerWorker::RotateLogFile() failed to rotate log file({}) to ({}). Error ({})",
+            m_log_filepath,
+            rotated_filepath,
+            error.message()
+        );
+    }
+    else if (m_rotation_config.compress && compression_supported) {
+        m_compress_queue.push(rotated_filepath);
+    }
+
+    remove_expired_log_files(m_log_filepath, m_rotation_config.max_rotated_files);
+    open_log_file();
+}
+
+void
+Logger_Worker::remove_expired_log_files(const std::string& log_filepath, u32 max_rotated_files)
+{
+    std::lock_guard<std::mutex> lock(m_mutex_rotated_files);
+
+    if (max_rotated_files == 0) {
+        return;
+    }
+
+    const std::filesystem::path log_path(log_filepath);
+    const auto directory = log_path.has_parent_path() ? log_path.parent_path() : std::filesystem::path(".");
+    const auto segment_prefix = log_path.stem().string() + ".";
+    const auto extension = log_path.extension().string();
+    const auto compressed_extension = extension + COMPRESSED_EXTENSION;
+
+    const auto ends_with = [](const std::string& value, const std::string& suffix) {
+        return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+
+    // Rotated segments are named <stem>.<timestamp><ext>[.gz] so sorting by name sorts them by age.
+    std::vector<std::filesystem::path> segments;
+    std::error_code error;
+    const auto compressing_filename = std::filesystem::path(m_compressing_filepath).filename().string();
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        const auto filename = entry.path().filename().string();
+        if (entry.path().filename() == log_path.filename() || filename.rfind(segment_prefix, 0) != 0) {
+            continue;
+        }
+
+        if (!compressing_filename.empty() &&
+            (filename == compressing_filename || filename == compressing_filename + COMPRESSED_EXTENSION)) {
+            continue;
+        }
+
+        if (ends_with(filename, extension) || ends_with(filename, compressed_extension)) {
+            segments.push_back(entry.path());
+        }
+    }
+
+    if (segments.size() <= max_rotated_files) {
+        return;
+    }
+
+    std::sort(segments.begin(), segments.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.filename().string() < rhs.filename().string();
+    });
+
+    const auto expired_count = segments.size() - max_rotated_files;
+    for (size_t i = 0; i < expired_count; ++i) {
+        std::filesystem::remove(segments[i], error);
+    }
+}
+
+void
+Logger_Worker::open_log_file()
+{
+    if (m_file_mode == Log_File_Mode::MAPPED) {
+        m_mapped_log_file.open(m_log_filepath);
+        m_log_file_size = m_mapped_log_file.size();
+    }
+    else {
+        m_log_file_stream.open(m_log_filepath, std::ofstream::out | std::ofstream::app | std::ofstream::binary);
+
+        std::error_code error;
+        const auto file_size = std::filesystem::file_size(m_log_filepath, error);
+        m_log_file_size = error ? 0 : static_cast<u64>(file_size);
+    }
+
+    m_log_file_opened = std::chrono::steady_clock::now();
+}
+
+void
+Logger_Worker::close_log_file()
+{
+    if (m_log_file_stream.is_open()) {
+        m_log_file_stream.close();
+    }
+    m_log_file_stream.clear();
+
+    m_mapped_log_file.close();
+}
+
+bool
+Logger_Worker::is_log_file_open() const
+{
+    if (m_file_mode == Log_File_Mode::MAPPED) {
+        return m_mapped_log_file.is_open();
+    }
+
+    return m_log_file_stream.is_open();
+}
+
+bool
+Logger_Worker::write_log_record(const std::string& record)
+{
+    if (m_file_mode == Log_File_Mode::MAPPED) {
+        return m_mapped_log_file.write(record);
+    }
+
+    if (m_log_file_stream.bad() || m_log_file_stream.fail()) {
+        return false;
+    }
+
+    m_log_file_stream << record << '\n';
+    return true;
+}
+
+void
+Logger_Worker::flush_log_file()
+{
+    if (m_file_mode == Log_File_Mode::MAPPED) {
+        m_mapped_log_file.sync();
+        m_log_file_synced = std::chrono::steady_clock::now();
+    }
+    else if (m_log_file_stream.is_open()) {
+        m_log_file_stream.flush();
+    }
+}
+
 void
 Logger_Worker::drop_all()
 {
@@ -244,10 +617,14 @@ Logger_Worker::drop_all()
 
     m_is_app_interrupted = true;
 
+    // The writer drains the queue before exiting, closing the log file afterwards writes back the last records.
+    if (m_app_log_thread != nullptr && m_app_log_thread->joinable()) {
+        m_app_log_thread->join();
+    }
+
     try {
-        if (m_log_file_stream.is_open()) {
-            m_log_file_stream.close();
-        }
+        std::lock_guard<std::mutex> lock(m_mutex_log_file);
+        close_log_file();
     }
     catch (...) {
         throw Logger_Exception(
@@ -260,6 +637,123 @@ Logger_Worker::drop_all()
     // Disable all logging operations
     m_file_log_enabled = false;
     m_console_log_enabled = false;
+
+    if (m_compress_thread != nullptr && m_compress_thread->joinable()) {
+        m_compress_thread->join();
+    }
+}
+
+Log_Channel
+Logger_Worker::register_channel(const std::string& name, const Log_Channel_Config& config)
+{
+    std::lock_guard<std::mutex> lock(m_mutex_channels);
+
+    const auto existing = m_channel_ids.find(name);
+    if (existing != m_channel_ids.end()) {
+        return existing->second;
+    }
+
+    const Log_Channel channel = m_channel_count.load(std::memory_order_relaxed);
+    if (channel >= LOG_CHANNELS_MAX) {
+        if (!m_channels_full_reported) {
+            m_channels_full_reported = true;
+            write_direct_log(
+                "LoggerWorker::RegisterChannel() all {} channels are registered, ({}) and any later channels write to "
+                "the default channel",
+                LOG_CHANNELS_MAX,
+                name
+            );
+        }
+        return LOG_CHANNEL_DEFAULT;
+    }
+
+    m_channels.at(channel).name = name;
+    m_channel_ids.emplace(name, channel);
+    set_channel_config(channel, config);
+
+    // Publish the channel only once its name & configuration are written.
+    m_channel_count.store(channel + 1, std::memory_order_release);
+    return channel;
+}
+
+Log_Channel
+Logger_Worker::resolve_channel(const char* name)
+{
+    // The address alone isn't enough, a temporary string may reuse the address of an earlier name.
+    auto& source = t_channel_sources[std::hash<const void*>{}(name) % CHANNEL_SOURCE_CACHE_SIZE];
+    if (source.address == name && source.name == name) {
+        return source.channel;
+    }
+
+    source.channel = register_channel(name, {});
+    source.address = name;
+    source.name = name;
+    return source.channel;
+}
+
+void
+Logger_Worker::set_channel_config(Log_Channel channel, const Log_Channel_Config& config)
+{
+    if (channel >= LOG_CHANNELS_MAX) {
+        return;
+    }
+
+    auto& state = m_channels.at(channel);
+    state.level.store(config.level, std::memory_order_relaxed);
+    state.max_per_second.store(config.max_per_second, std::memory_order_relaxed);
+    state.sample_rate.store(std::max(config.sample_rate, 1U), std::memory_order_relaxed);
+}
+
+bool
+Logger_Worker::accept_channel_record(Log_Channel channel, Severity level, u32& suppressed)
+{
+    static constexpr i64 rate_window_ms = 1000;
+
+    suppressed = 0;
+    if (channel >= m_channel_count.load(std::memory_order_acquire)) {
+        channel = LOG_CHANNEL_DEFAULT;
+    }
+
+    auto& state = m_channels.at(channel);
+    if (level < state.level.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    const u32 sample_rate = state.sample_rate.load(std::memory_order_relaxed);
+    if (sample_rate > 1 && state.sample_count.fetch_add(1, std::memory_order_relaxed) % sample_rate != 0) {
+        return false;
+    }
+
+    const u32 max_per_second = state.max_per_second.load(std::memory_order_relaxed);
+    if (max_per_second == 0) {
+        return true;
+    }
+
+    const i64 now = duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+    i64 window_start = state.window_start.load(std::memory_order_relaxed);
+    if (now - window_start >= rate_window_ms &&
+        state.window_start.compare_exchange_strong(window_start, now, std::memory_order_relaxed)) {
+        // Only the thread which moved the window on resets the count & reports the dropped records.
+        state.window_count.store(0, std::memory_order_relaxed);
+        suppressed = state.suppressed_count.exchange(0, std::memory_order_relaxed);
+    }
+
+    if (state.window_count.fetch_add(1, std::memory_order_relaxed) >= max_per_second) {
+        state.suppressed_count.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+const std::string&
+Logger_Worker::get_channel_name(Log_Channel channel) const
+{
+    if (channel >= m_channel_count.load(std::memory_order_acquire)) {
+        channel = LOG_CHANNEL_DEFAULT;
+    }
+
+    return m_channels.at(channel).name;
 }
 
 Logger::Logger() = default;
@@ -345,11 +839,11 @@ Logger::initialize(const std::string& log_filepath, Severity level, bool log_to_
 
     enable_file_logging(log_to_file);
     if (!log_file_just_created) {
-        Logger::log(Severity::LOG_MANUAL, "yuki", "");
+        Logger::log(Severity::LOG_MANUAL, LOG_CHANNEL_DEFAULT, "");
     }
     enable_console_logging(log_to_console);
 
-    Logger::notice("yuki", "Logger initialized: {}", filepath);
+    Logger::notice(LOG_CHANNEL_DEFAULT, "Logger initialized: {}", filepath);
 }
 
 Logger_Worker&
@@ -377,6 +871,39 @@ Logger::enable_console_logging(bool value)
     get_worker().m_console_log_enabled = value;
 }
 
+void
+Logger::set_log_rotation(const Log_Rotation_Config& config)
+{
+    auto& worker = get_worker();
+
+    std::lock_guard<std::mutex> lock(worker.m_mutex_log_file);
+    worker.m_rotation_config = config;
+}
+
+void
+Logger::set_log_file_mode(Log_File_Mode mode)
+{
+    auto& worker = get_worker();
+
+    std::lock_guard<std::mutex> lock(worker.m_mutex_log_file);
+    if (worker.m_file_mode != mode) {
+        worker.close_log_file();
+        worker.m_file_mode = mode;
+    }
+}
+
+Log_Channel
+Logger::register_channel(const std::string& name, const Log_Channel_Config& config)
+{
+    return get_worker().register_channel(name, config);
+}
+
+void
+Logger::set_channel_config(Log_Channel channel, const Log_Channel_Config& config)
+{
+    get_worker().set_channel_config(channel, config);
+}
+
 void
 Logger::drop_all()
 {
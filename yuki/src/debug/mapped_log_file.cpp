@@ -0,0 +1,134 @@
+/**
+ * File: mapped_log_file.cpp
+ * Project: yuki
+ * File Created: 2026-10-18 13:58:38
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:42:43
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "debug/mapped_log_file.hpp"
+
+#include <cstring>
+
+namespace yuki::debug {
+
+Mapped_Log_File::Mapped_Log_File(u64 chunk_size)
+  : m_chunk_size(chunk_size)
+  , m_write_offset(0)
+  , m_synced_offset(0)
+{
+}
+
+Mapped_Log_File::~Mapped_Log_File()
+{
+    close();
+}
+
+bool
+Mapped_Log_File::open(const std::string& filepath)
+{
+    close();
+
+    if (!m_file.open(filepath, platform::Mapped_File::Access::READ_WRITE)) {
+        return false;
+    }
+
+    // The file may have been pre-extended by a previous run which never truncated it, records are never
+    // zero bytes so we can find the end of the written data by skipping back over the zero-filled tail.
+    u64 end_offset = m_file.size();
+    const u8* data = m_file.data();
+    while (end_offset > 0 && data[end_offset - 1] == 0) {
+        --end_offset;
+    }
+
+    m_write_offset = end_offset;
+    m_synced_offset = end_offset;
+
+    return true;
+}
+
+void
+Mapped_Log_File::close()
+{
+    if (!m_file.is_open()) {
+        return;
+    }
+
+    sync();
+    m_file.resize(m_write_offset);
+    m_file.close();
+
+    m_write_offset = 0;
+    m_synced_offset = 0;
+}
+
+bool
+Mapped_Log_File::write(const std::string& record)
+{
+    if (!m_file.is_open()) {
+        return false;
+    }
+
+    const u64 record_size = record.size() + 1;
+    if (m_write_offset + record_size > m_file.size()) {
+        const u64 chunk_count = (m_write_offset + record_size) / m_chunk_size + 1;
+        if (!m_file.resize(chunk_count * m_chunk_size)) {
+            return false;
+        }
+    }
+
+    u8* destination = m_file.data() + m_write_offset;
+    std::memcpy(destination, record.data(), record.size());
+    destination[record.size()] = '\n';
+
+    m_write_offset += record_size;
+    return true;
+}
+
+void
+Mapped_Log_File::sync()
+{
+    if (m_write_offset == m_synced_offset) {
+        return;
+    }
+
+    if (m_file.sync(m_synced_offset, m_write_offset - m_synced_offset)) {
+        m_synced_offset = m_write_offset;
+    }
+}
+
+bool
+Mapped_Log_File::is_open() const
+{
+    return m_file.is_open();
+}
+
+u64
+Mapped_Log_File::size() const
+{
+    return m_write_offset;
+}
+
+u64
+Mapped_Log_File::unsynced_size() const
+{
+    return m_write_offset - m_synced_offset;
+}
+
+}
@@ -0,0 +1,284 @@
+/**
+ * File: profile_stats.cpp
+ * Project: yuki
+ * File Created: 2026-10-18 14:06:48
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:22:43
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "debug/profile_stats.hpp"
+
+#include <algorithm>
+#include <map>
+
+namespace yuki::debug {
+
+namespace {
+
+constexpr f64 NS_PER_US = 1000.0;
+constexpr f64 PERCENTILE_MAX = 100.0;
+
+f64
+to_us(u64 value_ns)
+{
+    return static_cast<f64>(value_ns) / NS_PER_US;
+}
+
+}
+
+// Latency_Histogram
+void
+Latency_Histogram::record(u64 value_ns)
+{
+    ++m_buckets.at(bucket_index(value_ns));
+
+    m_min = m_count == 0 ? value_ns : std::min(m_min, value_ns);
+    m_max = std::max(m_max, value_ns);
+    m_total += value_ns;
+    ++m_count;
+}
+
+void
+Latency_Histogram::merge(const Latency_Histogram& other)
+{
+    if (other.m_count == 0) {
+        return;
+    }
+
+    for (u32 i = 0; i < BUCKET_COUNT; ++i) {
+        m_buckets.at(i) += other.m_buckets.at(i);
+    }
+
+    m_min = m_count == 0 ? other.m_min : std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    m_total += other.m_total;
+    m_count += other.m_count;
+}
+
+void
+Latency_Histogram::reset()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_total = 0;
+    m_min = 0;
+    m_max = 0;
+}
+
+u64
+Latency_Histogram::value_at_percentile(f64 percentile) const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+
+    const f64 clamped = std::clamp(percentile, 0.0, PERCENTILE_MAX);
+    const auto target = std::max<u64>(1, static_cast<u64>(clamped / PERCENTILE_MAX * static_cast<f64>(m_count) + 0.5));
+
+    u64 cumulative = 0;
+    for (u32 i = 0; i < BUCKET_COUNT; ++i) {
+        cumulative += m_buckets.at(i);
+        if (cumulative >= target) {
+            // Bucket values are approximate, never report outside of the exact recorded range.
+            return std::clamp(bucket_value(i), m_min, m_max);
+        }
+    }
+
+    return m_max;
+}
+
+u64
+Latency_Histogram::count() const
+{
+    return m_count;
+}
+
+u64
+Latency_Histogram::min() const
+{
+    return m_min;
+}
+
+u64
+Latency_Histogram::max() const
+{
+    return m_max;
+}
+
+f64
+Latency_Histogram::mean() const
+{
+    return m_count == 0 ? 0.0 : static_cast<f64>(m_total) / static_cast<f64>(m_count);
+}
+
+u32
+Latency_Histogram::bucket_index(u64 value_ns)
+{
+    if (value_ns < SUB_BUCKET_COUNT) {
+        return static_cast<u32>(value_ns);
+    }
+
+    u32 magnitude = SUB_BUCKET_BITS;
+    while (magnitude + 1 < MAX_VALUE_BITS && (value_ns >> (magnitude + 1)) != 0) {
+        ++magnitude;
+    }
+
+    if ((value_ns >> (magnitude + 1)) != 0) {
+        return BUCKET_COUNT - 1;
+    }
+
+    // The top SUB_BUCKET_BITS + 1 bits of the value select the bucket within its power of two.
+    const u32 shift = magnitude - SUB_BUCKET_BITS;
+    const auto sub_bucket = static_cast<u32>(value_ns >> shift) - SUB_BUCKET_COUNT;
+    return SUB_BUCKET_COUNT + shift * SUB_BUCKET_COUNT + sub_bucket;
+}
+
+u64
+Latency_Histogram::bucket_value(u32 index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    // Report the middle of the bucket's range.
+    const u32 shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT;
+    const u64 sub_bucket = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT;
+    return ((SUB_BUCKET_COUNT + sub_bucket) << shift) + ((1ULL << shift) >> 1);
+}
+
+// Profile_Stats
+void
+Profile_Stats::record(const char* name, i64 duration_ns, Profile_Track track)
+{
+    auto& scopes = m_sub_windows.at(m_current).scopes.at(static_cast<size_t>(track));
+    scopes[name].record(static_cast<u64>(std::max<i64>(duration_ns, 0)));
+}
+
+void
+Profile_Stats::mark_frame(i64 timestamp_ns)
+{
+    auto& sub_window = m_sub_windows.at(m_current);
+    if (m_last_frame_ns != 0) {
+        record(FRAME_SCOPE_NAME, timestamp_ns - m_last_frame_ns);
+        ++sub_window.frames;
+    }
+    m_last_frame_ns = timestamp_ns;
+
+    const u32 sub_window_frames = std::max((m_window_frames + SUB_WINDOW_COUNT - 1) / SUB_WINDOW_COUNT, 1U);
+    if (sub_window.frames >= sub_window_frames) {
+        complete_sub_window();
+    }
+}
+
+void
+Profile_Stats::set_window_frames(u32 frames)
+{
+    m_window_frames = std::max(frames, 1U);
+}
+
+std::vector<Profile_Scope_Stats>
+Profile_Stats::get_scope_stats() const
+{
+    std::lock_guard lock(m_mutex_completed);
+    return m_completed;
+}
+
+std::optional<Profile_Scope_Stats>
+Profile_Stats::get_scope_stats(const std::string& name) const
+{
+    std::lock_guard lock(m_mutex_completed);
+
+    const auto stats = std::find_if(m_completed.begin(), m_completed.end(), [&name](const Profile_Scope_Stats& scope) {
+        return scope.name == name;
+    });
+
+    if (stats == m_completed.end()) {
+        return std::nullopt;
+    }
+
+    return *stats;
+}
+
+void
+Profile_Stats::reset()
+{
+    for (auto& sub_window : m_sub_windows) {
+        for (auto& scopes : sub_window.scopes) {
+            scopes.clear();
+        }
+        sub_window.frames = 0;
+    }
+    m_current = 0;
+    m_last_frame_ns = 0;
+
+    std::lock_guard lock(m_mutex_completed);
+    m_completed.clear();
+}
+
+void
+Profile_Stats::complete_sub_window()
+{
+    // The same scope name can come from multiple literals, so merge by name before summarising.
+    std::map<std::string, Latency_Histogram> merged;
+    u32 window_frames = 0;
+    for (const auto& sub_window : m_sub_windows) {
+        for (const auto& [name, histogram] : sub_window.scopes.at(static_cast<size_t>(Profile_Track::CPU))) {
+            if (histogram.count() > 0) {
+                merged[name].merge(histogram);
+            }
+        }
+        for (const auto& [name, histogram] : sub_window.scopes.at(static_cast<size_t>(Profile_Track::GPU))) {
+            if (histogram.count() > 0) {
+                merged[std::string("[GPU] ") + name].merge(histogram);
+            }
+        }
+        window_frames += sub_window.frames;
+    }
+
+    std::vector<Profile_Scope_Stats> completed;
+    completed.reserve(merged.size());
+    for (const auto& [name, histogram] : merged) {
+        Profile_Scope_Stats stats;
+        stats.name = name;
+        stats.call_count = histogram.count();
+        stats.calls_per_frame = static_cast<f64>(histogram.count()) / static_cast<f64>(std::max(window_frames, 1U));
+        stats.min_us = to_us(histogram.min());
+        stats.mean_us = histogram.mean() / NS_PER_US;
+        stats.p50_us = to_us(histogram.value_at_percentile(50.0));
+        stats.p95_us = to_us(histogram.value_at_percentile(95.0));
+        stats.p99_us = to_us(histogram.value_at_percentile(99.0));
+        stats.max_us = to_us(histogram.max());
+        completed.emplace_back(std::move(stats));
+    }
+
+    // The oldest sub-window drops out of the window and is reused for the next frames.
+    m_current = (m_current + 1) % SUB_WINDOW_COUNT;
+    auto& next = m_sub_windows.at(m_current);
+    for (auto& scopes : next.scopes) {
+        for (auto& scope : scopes) {
+            scope.second.reset();
+        }
+    }
+    next.frames = 0;
+
+    std::lock_guard lock(m_mutex_completed);
+    m_completed = std::move(completed);
+}
+
+}
@@ -0,0 +1,511 @@
+/**
+ * File: trace_file.cpp
+ * Project: yuki
+ * File Created: 2026-10-18 14:16:37
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:26:49
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "debug/trace_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "debug/logger.hpp"
+#include "debug/profile_stats.hpp"
+
+namespace yuki::debug {
+
+namespace {
+
+constexpr f64 NS_PER_US = 1000.0;
+constexpr u32 VARINT_BITS = 7;
+constexpr u8 VARINT_MASK = 0x7F;
+constexpr u8 VARINT_CONTINUE = 0x80;
+// Event records pack the record, event type & track into their tag byte.
+constexpr u32 TAG_TYPE_SHIFT = 2;
+constexpr u32 TAG_TRACK_SHIFT = 5;
+constexpr u8 TAG_RECORD_MASK = 0x03;
+constexpr u8 TAG_TYPE_MASK = 0x07;
+constexpr u8 TAG_TRACK_MASK = 0x03;
+
+u64
+zigzag_encode(i64 value)
+{
+    return (static_cast<u64>(value) << 1) ^ static_cast<u64>(value >> 63);
+}
+
+i64
+zigzag_decode(u64 value)
+{
+    return static_cast<i64>(value >> 1) ^ -static_cast<i64>(value & 1);
+}
+
+}
+
+// Trace_Writer
+Trace_Writer::Trace_Writer()
+  : m_max_segment_size(0)
+  , m_max_segments(0)
+  , m_segment_index(0)
+  , m_segment_size(0)
+  , m_last_timestamp(0)
+{
+}
+
+Trace_Writer::~Trace_Writer()
+{
+    close();
+}
+
+bool
+Trace_Writer::open(const std::string& filepath, u64 max_segment_size, u32 max_segments)
+{
+    close();
+
+    m_filepath = filepath;
+    m_max_segment_size = max_segment_size;
+    m_max_segments = max_segments;
+
+    remove_segments();
+    return open_segment(0);
+}
+
+void
+Trace_Writer::close()
+{
+    if (m_stream.is_open()) {
+        m_stream << m_buffer;
+        m_stream.close();
+    }
+
+    m_buffer.clear();
+    m_string_ids.clear();
+}
+
+void
+Trace_Writer::write_event(const Profile_Event& event, u32 thread_index)
+{
+    const u32 name_id = get_string_id(event.name);
+
+    const auto tag = static_cast<u8>(
+        static_cast<u32>(Trace_Record::EVENT) | (static_cast<u32>(event.type) << TAG_TYPE_SHIFT) |
+        (static_cast<u32>(event.track) << TAG_TRACK_SHIFT)
+    );
+    m_buffer.push_back(static_cast<char>(tag));
+
+    write_varint(thread_index);
+    write_varint(name_id);
+    // Events from different threads are drained out of order, so deltas can be negative.
+    write_zigzag(event.start_ns - m_last_timestamp);
+    write_zigzag(event.value);
+
+    m_last_timestamp = event.start_ns;
+}
+
+void
+Trace_Writer::write_thread(u32 thread_index, u64 dropped_events)
+{
+    m_buffer.push_back(static_cast<char>(Trace_Record::THREAD));
+    write_varint(thread_index);
+    write_varint(dropped_events);
+}
+
+void
+Trace_Writer::flush()
+{
+    if (!m_stream.is_open()) {
+        m_buffer.clear();
+        return;
+    }
+
+    m_stream << m_buffer;
+    m_segment_size += m_buffer.size();
+    m_buffer.clear();
+
+    if (m_max_segment_size > 0 && m_segment_size >= m_max_segment_size) {
+        open_segment(m_segment_index + 1);
+    }
+}
+
+bool
+Trace_Writer::is_open() const
+{
+    return m_stream.is_open();
+}
+
+std::string
+Trace_Writer::get_segment_filepath(u32 segment_index) const
+{
+    const std::filesystem::path path(m_filepath);
+
+    auto segment_path = path.parent_path() / path.stem();
+    segment_path += fmt::format(".{:03}", segment_index);
+    segment_path += path.extension();
+    return segment_path.string();
+}
+
+bool
+Trace_Writer::open_segment(u32 segment_index)
+{
+    if (m_stream.is_open()) {
+        m_stream.close();
+    }
+
+    m_segment_index = segment_index;
+    m_segment_size = 0;
+    m_last_timestamp = 0;
+    m_string_ids.clear();
+
+    m_stream.open(get_segment_filepath(segment_index), std::ios::binary | std::ios::trunc);
+    if (!m_stream.is_open()) {
+        Logger::error(LOG_CHANNEL_DEFAULT, "Trace_Writer failed to open trace segment {}", get_segment_filepath(segment_index));
+        return false;
+    }
+
+    if (m_max_segments > 0 && segment_index >= m_max_segments) {
+        std::error_code error;
+        std::filesystem::remove(get_segment_filepath(segment_index - m_max_segments), error);
+    }
+
+    // Records still buffered belong to the new segment, so the header has to go in front of them.
+    std::string header(MAGIC.begin(), MAGIC.end());
+    header.push_back(static_cast<char>(VERSION));
+    m_buffer.swap(header);
+    write_varint(segment_index);
+    m_buffer.append(header);
+
+    return true;
+}
+
+void
+Trace_Writer::remove_segments() const
+{
+    const std::filesystem::path path(m_filepath);
+    const auto directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+    const auto prefix = path.stem().string() + ".";
+    const auto extension = path.extension().string();
+
+    // Segments are <stem>.<index><extension>, any index may be left over from an earlier, longer session.
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        const auto filename = entry.path().filename().string();
+        if (filename.size() <= prefix.size() + extension.size() || filename.rfind(prefix, 0) != 0 ||
+            filename.compare(filename.size() - extension.size(), extension.size(), extension) != 0) {
+            continue;
+        }
+
+        const auto index = std::string_view(filename).substr(prefix.size(), filename.size() - prefix.size() - extension.size());
+        if (std::all_of(index.begin(), index.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            std::error_code remove_error;
+            std::filesystem::remove(entry.path(), remove_error);
+        }
+    }
+}
+
+u32
+Trace_Writer::get_string_id(const char* name)
+{
+    const auto existing = m_string_ids.find(name);
+    if (existing != m_string_ids.end()) {
+        return existing->second;
+    }
+
+    const auto id = static_cast<u32>(m_string_ids.size());
+    m_string_ids.emplace(name, id);
+
+    const size_t length = std::strlen(name);
+    m_buffer.push_back(static_cast<char>(Trace_Record::STRING));
+    write_varint(id);
+    write_varint(length);
+    m_buffer.append(name, length);
+
+    return id;
+}
+
+void
+Trace_Writer::write_varint(u64 value)
+{
+    while (value >= VARINT_CONTINUE) {
+        m_buffer.push_back(static_cast<char>((value & VARINT_MASK) | VARINT_CONTINUE));
+        value >>= VARINT_BITS;
+    }
+    m_buffer.push_back(static_cast<char>(value));
+}
+
+void
+Trace_Writer::write_zigzag(i64 value)
+{
+    write_varint(zigzag_encode(value));
+}
+
+// Trace_Reader
+bool
+Trace_Reader::open(const std::string& filepath)
+{
+    m_file.close();
+    m_strings.clear();
+    m_string_table.clear();
+    m_last_timestamp = 0;
+    m_has_error = false;
+
+    if (!m_file.open(filepath, platform::Mapped_File::Access::READ)) {
+        return false;
+    }
+
+    const auto magic_size = Trace_Writer::MAGIC.size();
+    if (m_file.size() < magic_size + 1 ||
+        std::memcmp(m_file.data(), Trace_Writer::MAGIC.data(), magic_size) != 0 ||
+        m_file.data()[magic_size] != Trace_Writer::VERSION) {
+        m_has_error = true;
+        return false;
+    }
+
+    m_offset = magic_size + 1;
+
+    u64 segment_index = 0;
+    if (!read_varint(segment_index)) {
+        m_has_error = true;
+        return false;
+    }
+    m_segment_index = static_cast<u32>(segment_index);
+
+    return true;
+}
+
+std::optional<Trace_Record>
+Trace_Reader::next()
+{
+    while (m_file.is_open() && m_offset < m_file.size()) {
+        const u8 tag = m_file.data()[m_offset++];
+        const auto record = static_cast<Trace_Record>(tag & TAG_RECORD_MASK);
+
+        switch (record) {
+            case Trace_Record::STRING: {
+                u64 id = 0;
+                u64 length = 0;
+                if (!read_varint(id) || !read_varint(length) || id != m_string_table.size() ||
+                    length > m_file.size() - m_offset) {
+                    m_has_error = true;
+                    return std::nullopt;
+                }
+
+                const auto* const begin = reinterpret_cast<const char*>(m_file.data() + m_offset); // NOLINT
+                m_strings.emplace_back(begin, length);
+                m_string_table.push_back(m_strings.back().c_str());
+                m_offset += length;
+            } break;
+
+            case Trace_Record::EVENT: {
+                u64 thread_index = 0;
+                u64 name_id = 0;
+                i64 delta = 0;
+                if (!read_varint(thread_index) || !read_varint(name_id) || !read_zigzag(delta) ||
+                    !read_zigzag(m_event.value) || name_id >= m_string_table.size()) {
+                    m_has_error = true;
+                    return std::nullopt;
+                }
+
+                m_last_timestamp += delta;
+                m_thread_index = static_cast<u32>(thread_index);
+                m_event.name = m_string_table.at(name_id);
+                m_event.start_ns = m_last_timestamp;
+                m_event.type = static_cast<Profile_Event_Type>((tag >> TAG_TYPE_SHIFT) & TAG_TYPE_MASK);
+                m_event.track = static_cast<Profile_Track>((tag >> TAG_TRACK_SHIFT) & TAG_TRACK_MASK);
+                return record;
+            }
+
+            case Trace_Record::THREAD: {
+                u64 thread_index = 0;
+                if (!read_varint(thread_index) || !read_varint(m_dropped_events)) {
+                    m_has_error = true;
+                    return std::nullopt;
+                }
+
+                m_thread_index = static_cast<u32>(thread_index);
+                return record;
+            }
+
+            default:
+                m_has_error = true;
+                return std::nullopt;
+        }
+    }
+
+    return std::nullopt;
+}
+
+const Profile_Event&
+Trace_Reader::event() const
+{
+    return m_event;
+}
+
+u32
+Trace_Reader::thread_index() const
+{
+    return m_thread_index;
+}
+
+u64
+Trace_Reader::dropped_events() const
+{
+    return m_dropped_events;
+}
+
+u32
+Trace_Reader::segment_index() const
+{
+    return m_segment_index;
+}
+
+bool
+Trace_Reader::has_error() const
+{
+    return m_has_error;
+}
+
+bool
+Trace_Reader::read_varint(u64& value)
+{
+    value = 0;
+    for (u32 shift = 0; shift < 64; shift += VARINT_BITS) {
+        if (m_offset >= m_file.size()) {
+            return false;
+        }
+
+        const u8 byte = m_file.data()[m_offset++];
+        value |= static_cast<u64>(byte & VARINT_MASK) << shift;
+        if ((byte & VARINT_CONTINUE) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool
+Trace_Reader::read_zigzag(i64& value)
+{
+    u64 encoded = 0;
+    if (!read_varint(encoded)) {
+        return false;
+    }
+
+    value = zigzag_decode(encoded);
+    return true;
+}
+
+// Chrome trace JSON
+void
+append_json_header(std::string& output)
+{
+    output.append(R"({"otherData": {},"traceEvents":[{})");
+}
+
+void
+append_json_event(std::string& output, const Profile_Event& event, u32 thread_index)
+{
+    auto inserter = std::back_inserter(output);
+    const f64 timestamp_us = static_cast<f64>(event.start_ns) / NS_PER_US;
+
+    switch (event.type) {
+        case Profile_Event_Type::COMPLETE: {
+            // GPU events are read back on the render thread but belong to a single GPU timeline.
+            const bool is_gpu = event.track == Profile_Track::GPU;
+            fmt::format_to(
+                inserter,
+                R"(,{{"cat":"{}","dur":{:.3f},"name":"{}","ph":"X","pid":{},"tid":{},"ts":{:.3f}}})",
+                is_gpu ? "gpu" : "function",
+                static_cast<f64>(event.value) / NS_PER_US,
+                event.name,
+                static_cast<u32>(event.track),
+                is_gpu ? 0 : thread_index,
+                timestamp_us
+            );
+        } break;
+
+        case Profile_Event_Type::INSTANT: {
+            // Frame markers span every track, other markers only the thread they happened on.
+            const bool is_frame = std::string_view(event.name) == Profile_Stats::FRAME_SCOPE_NAME;
+            fmt::format_to(
+                inserter,
+                R"(,{{"cat":"{}","name":"{}","ph":"i","s":"{}","pid":0,"tid":{},"ts":{:.3f}}})",
+                is_frame ? "frame" : "marker",
+                event.name,
+                is_frame ? "g" : "t",
+                thread_index,
+                timestamp_us
+            );
+        } break;
+
+        case Profile_Event_Type::COUNTER: {
+            fmt::format_to(
+                inserter,
+                R"(,{{"cat":"counter","name":"{}","ph":"C","pid":0,"tid":{},"ts":{:.3f},"args":{{"value":{}}}}})",
+                event.name,
+                thread_index,
+                timestamp_us,
+                event.value
+            );
+        } break;
+
+        case Profile_Event_Type::FLOW_BEGIN:
+        case Profile_Event_Type::FLOW_END: {
+            // Flow ends bind to the enclosing scope ("bp":"e") rather than the next scope to start.
+            const bool is_begin = event.type == Profile_Event_Type::FLOW_BEGIN;
+            fmt::format_to(
+                inserter,
+                R"(,{{"cat":"flow","name":"{}","ph":"{}",{}"id":{},"pid":0,"tid":{},"ts":{:.3f}}})",
+                event.name,
+                is_begin ? "s" : "f",
+                is_begin ? "" : R"("bp":"e",)",
+                event.value,
+                thread_index,
+                timestamp_us
+            );
+        } break;
+    }
+}
+
+void
+append_json_thread(std::string& output, u32 thread_index, u64 dropped_events)
+{
+    fmt::format_to(
+        std::back_inserter(output),
+        R"(,{{"name":"thread_name","ph":"M","pid":0,"tid":{0},"args":{{"name":"thread {0}","dropped_events":{1}}}}})",
+        thread_index,
+        dropped_events
+    );
+}
+
+void
+append_json_footer(std::string& output)
+{
+    output.append(R"(,{"name":"process_name","ph":"M","pid":0,"args":{"name":"CPU"}})");
+    output.append(R"(,{"name":"process_name","ph":"M","pid":1,"args":{"name":"GPU"}})");
+    output.append("]}");
+}
+
+}
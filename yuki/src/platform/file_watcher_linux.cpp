@@ -0,0 +1,183 @@
+/**
+ * File: file_watcher_linux.cpp
+ * Project: yuki
+ * File Created: 2026-10-18 14:43:09
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:44:33
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "platform/file_watcher.hpp"
+
+#ifdef __linux__
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+
+#include "debug/logger.hpp"
+
+namespace {
+
+// Written & closed covers editors which save in place, moved to covers editors which save to a temporary file &
+// rename it over the original.
+constexpr u32 WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+constexpr size_t EVENT_BUFFER_SIZE = 16 * 1024;
+
+struct Internal_State {
+    i32 file_descriptor{ -1 };
+    std::unordered_map<i32, std::string> directories;
+};
+
+bool
+add_watch(Internal_State& state, const std::string& directory)
+{
+    const i32 watch_descriptor = inotify_add_watch(state.file_descriptor, directory.c_str(), WATCH_MASK);
+    if (watch_descriptor < 0) {
+        yuki::debug::Logger::error(
+            yuki::debug::LOG_CHANNEL_DEFAULT,
+            "File_Watcher::watch() failed to watch {}. Error ({})",
+            directory,
+            std::strerror(errno)
+        );
+        return false;
+    }
+
+    state.directories[watch_descriptor] = directory;
+    return true;
+}
+
+}
+
+namespace yuki::platform {
+
+File_Watcher::File_Watcher()
+  : m_internal_state(nullptr)
+{
+}
+
+File_Watcher::~File_Watcher()
+{
+    close();
+}
+
+bool
+File_Watcher::watch(const std::string& directory)
+{
+    close();
+
+    const i32 file_descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (file_descriptor < 0) {
+        debug::Logger::error(
+            debug::LOG_CHANNEL_DEFAULT,
+            "File_Watcher::watch() failed to create an inotify instance. Error ({})",
+            std::strerror(errno)
+        );
+        return false;
+    }
+
+    auto state = std::make_shared<Internal_State>();
+    state->file_descriptor = file_descriptor;
+    m_internal_state = state;
+
+    // inotify doesn't watch recursively, every directory in the tree needs its own watch.
+    if (!add_watch(*state, directory)) {
+        close();
+        return false;
+    }
+
+    std::error_code error;
+    for (std::filesystem::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (it->is_directory()) {
+            add_watch(*state, it->path().string());
+        }
+    }
+
+    return true;
+}
+
+void
+File_Watcher::close()
+{
+    if (m_internal_state != nullptr) {
+        const auto& state{ std::static_pointer_cast<Internal_State>(m_internal_state) };
+        ::close(state->file_descriptor);
+        m_internal_state = nullptr;
+    }
+}
+
+std::vector<std::string>
+File_Watcher::poll()
+{
+    std::vector<std::string> changed_files;
+    if (m_internal_state == nullptr) {
+        return changed_files;
+    }
+
+    const auto& state{ std::static_pointer_cast<Internal_State>(m_internal_state) };
+
+    alignas(inotify_event) std::array<char, EVENT_BUFFER_SIZE> buffer{};
+    while (true) {
+        const ssize_t length = read(state->file_descriptor, buffer.data(), buffer.size());
+        if (length <= 0) {
+            // EAGAIN once every pending event has been read.
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset); // NOLINT
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            const auto directory = state->directories.find(event->wd);
+            if (directory == state->directories.end() || event->len == 0) {
+                continue;
+            }
+
+            const std::string filepath = directory->second + "/" + event->name; // NOLINT - flexible array member.
+            if ((event->mask & IN_ISDIR) != 0) {
+                if ((event->mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+                    add_watch(*state, filepath);
+                }
+            }
+            else if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0) {
+                changed_files.push_back(filepath);
+            }
+        }
+    }
+
+    // Editors can write a file several times while saving it.
+    std::sort(changed_files.begin(), changed_files.end());
+    changed_files.erase(std::unique(changed_files.begin(), changed_files.end()), changed_files.end());
+    return changed_files;
+}
+
+bool
+File_Watcher::is_open() const
+{
+    return m_internal_state != nullptr;
+}
+
+}
+
+#endif
@@ -0,0 +1,226 @@
+/**
+ * File: file_watcher_win32.cpp
+ * Project: yuki
+ * File Created: 2026-10-18 14:43:10
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:48:48
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "platform/file_watcher.hpp"
+
+#ifdef _WIN32
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+#include <algorithm>
+#include <array>
+
+#include "debug/logger.hpp"
+
+namespace {
+
+// Windows has no close-after-write event, written files are held back until their writer closes them.
+constexpr DWORD NOTIFY_FILTER = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE;
+constexpr DWORD EVENT_BUFFER_SIZE = 16 * 1024;
+
+struct Internal_State {
+    HANDLE directory_handle{ INVALID_HANDLE_VALUE };
+    OVERLAPPED overlapped{};
+    std::string directory;
+    alignas(FILE_NOTIFY_INFORMATION) std::array<u8, EVENT_BUFFER_SIZE> buffer{};
+    std::vector<std::string> pending_files;
+};
+
+// Queue the next read, it completes in the background & poll() collects it without blocking.
+bool
+read_changes(Internal_State& state)
+{
+    const BOOL result = ReadDirectoryChangesW(
+        state.directory_handle, state.buffer.data(), EVENT_BUFFER_SIZE, TRUE, NOTIFY_FILTER, nullptr, &state.overlapped, nullptr
+    );
+    if (result == 0) {
+        yuki::debug::Logger::error(
+            yuki::debug::LOG_CHANNEL_DEFAULT,
+            "File_Watcher::poll() failed to read changes in {}. Error ({})",
+            state.directory,
+            GetLastError()
+        );
+        return false;
+    }
+    return true;
+}
+
+std::string
+to_utf8(const WCHAR* text, i32 length)
+{
+    const i32 size = WideCharToMultiByte(CP_UTF8, 0, text, length, nullptr, 0, nullptr, nullptr);
+    std::string result(static_cast<size_t>(std::max(size, 0)), '\0');
+    WideCharToMultiByte(CP_UTF8, 0, text, length, result.data(), size, nullptr, nullptr);
+    std::replace(result.begin(), result.end(), '\\', '/');
+    return result;
+}
+
+void
+read_events(Internal_State& state, DWORD length)
+{
+    if (length == 0) {
+        // The buffer overflowed & the events since the last read are lost.
+        yuki::debug::Logger::warn(
+            yuki::debug::LOG_CHANNEL_DEFAULT, "File_Watcher::poll() missed changes in {}", state.directory
+        );
+        return;
+    }
+
+    for (DWORD offset = 0; offset < length;) {
+        const auto* event = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(state.buffer.data() + offset); // NOLINT
+        const bool is_written = event->Action == FILE_ACTION_ADDED || event->Action == FILE_ACTION_MODIFIED ||
+                                event->Action == FILE_ACTION_RENAMED_NEW_NAME;
+        if (is_written) {
+            // NOLINTNEXTLINE - variable length array member.
+            const auto filename = to_utf8(event->FileName, static_cast<i32>(event->FileNameLength / sizeof(WCHAR)));
+            state.pending_files.push_back(state.directory + "/" + filename);
+        }
+
+        if (event->NextEntryOffset == 0) {
+            break;
+        }
+        offset += event->NextEntryOffset;
+    }
+}
+
+}
+
+namespace yuki::platform {
+
+File_Watcher::File_Watcher()
+  : m_internal_state(nullptr)
+{
+}
+
+File_Watcher::~File_Watcher()
+{
+    close();
+}
+
+bool
+File_Watcher::watch(const std::string& directory)
+{
+    close();
+
+    HANDLE directory_handle = CreateFileA(
+        directory.c_str(),
+        FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+        nullptr
+    );
+    if (directory_handle == INVALID_HANDLE_VALUE) {
+        debug::Logger::error(
+            debug::LOG_CHANNEL_DEFAULT, "File_Watcher::watch() failed to open {}. Error ({})", directory, GetLastError()
+        );
+        return false;
+    }
+
+    auto state = std::make_shared<Internal_State>();
+    state->directory_handle = directory_handle;
+    state->directory = directory;
+    m_internal_state = state;
+
+    // Unlike inotify a single watch covers the whole tree, including directories created later.
+    if (!read_changes(*state)) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void
+File_Watcher::close()
+{
+    if (m_internal_state != nullptr) {
+        const auto& state{ std::static_pointer_cast<Internal_State>(m_internal_state) };
+        // The pending read writes into the state's buffer, it has to finish before the state is freed.
+        DWORD length = 0;
+        CancelIoEx(state->directory_handle, &state->overlapped);
+        GetOverlappedResult(state->directory_handle, &state->overlapped, &length, TRUE);
+        CloseHandle(state->directory_handle);
+        m_internal_state = nullptr;
+    }
+}
+
+std::vector<std::string>
+File_Watcher::poll()
+{
+    std::vector<std::string> changed_files;
+    if (m_internal_state == nullptr) {
+        return changed_files;
+    }
+
+    const auto& state{ std::static_pointer_cast<Internal_State>(m_internal_state) };
+
+    DWORD length = 0;
+    while (GetOverlappedResult(state->directory_handle, &state->overlapped, &length, FALSE) != 0) {
+        read_events(*state, length);
+        if (!read_changes(*state)) {
+            break;
+        }
+    }
+
+    // Editors can write a file several times while saving it.
+    auto& pending_files = state->pending_files;
+    std::sort(pending_files.begin(), pending_files.end());
+    pending_files.erase(std::unique(pending_files.begin(), pending_files.end()), pending_files.end());
+
+    // A file still open for writing can't be opened without sharing write access, those wait for the next poll.
+    std::vector<std::string> open_files;
+    for (auto& filepath : pending_files) {
+        const DWORD attributes = GetFileAttributesA(filepath.c_str());
+        if (attributes == INVALID_FILE_ATTRIBUTES || (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0) {
+            continue;
+        }
+
+        HANDLE file = CreateFileA(
+            filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+        );
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+            changed_files.push_back(std::move(filepath));
+        }
+        else if (GetLastError() == ERROR_SHARING_VIOLATION) {
+            open_files.push_back(std::move(filepath));
+        }
+    }
+    pending_files = std::move(open_files);
+
+    return changed_files;
+}
+
+bool
+File_Watcher::is_open() const
+{
+    return m_internal_state != nullptr;
+}
+
+}
+
+#endif
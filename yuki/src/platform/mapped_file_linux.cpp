@@ -0,0 +1,229 @@
+/**
+ * File: mapped_file_linux.cpp
+ * Project: yuki
+ * File Created: 2026-10-18 13:58:23
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:44:33
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "platform/mapped_file.hpp"
+
+#ifdef __linux__
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "debug/logger.hpp"
+
+namespace {
+
+struct Internal_State {
+    i32 file_descriptor{ -1 };
+};
+
+}
+
+namespace yuki::platform {
+
+Mapped_File::Mapped_File()
+  : m_internal_state(nullptr)
+  , m_access(Access::READ)
+  , m_data(nullptr)
+  , m_size(0)
+{
+}
+
+Mapped_File::~Mapped_File()
+{
+    close();
+}
+
+bool
+Mapped_File::open(const std::string& filepath, Access access)
+{
+    close();
+
+    const i32 flags = access == Access::READ ? O_RDONLY : (O_RDWR | O_CREAT);
+    // NOLINTNEXTLINE - open is variadic.
+    const i32 file_descriptor = ::open(filepath.c_str(), flags | O_CLOEXEC, 0644);
+    if (file_descriptor < 0) {
+        debug::Logger::error(
+            debug::LOG_CHANNEL_DEFAULT, "Mapped_File::open() failed to open {}. Error ({})", filepath, std::strerror(errno)
+        );
+        return false;
+    }
+
+    struct stat file_stat {};
+    if (fstat(file_descriptor, &file_stat) != 0) {
+        debug::Logger::error(
+            debug::LOG_CHANNEL_DEFAULT, "Mapped_File::open() failed to stat {}. Error ({})", filepath, std::strerror(errno)
+        );
+        ::close(file_descriptor);
+        return false;
+    }
+
+    auto state = std::make_shared<Internal_State>();
+    state->file_descriptor = file_descriptor;
+
+    m_internal_state = state;
+    m_filepath = filepath;
+    m_access = access;
+    m_size = static_cast<u64>(file_stat.st_size);
+
+    if (m_size == 0) {
+        return true;
+    }
+
+    const i32 protection = access == Access::READ ? PROT_READ : (PROT_READ | PROT_WRITE);
+    void* mapping = mmap(nullptr, m_size, protection, MAP_SHARED, file_descriptor, 0);
+    if (mapping == MAP_FAILED) { // NOLINT - MAP_FAILED is a C-style cast.
+        debug::Logger::error(
+            debug::LOG_CHANNEL_DEFAULT, "Mapped_File::open() failed to map {}. Error ({})", filepath, std::strerror(errno)
+        );
+        close();
+        return false;
+    }
+
+    m_data = static_cast<u8*>(mapping);
+    return true;
+}
+
+void
+Mapped_File::close()
+{
+    if (m_data != nullptr) {
+        munmap(m_data, m_size);
+        m_data = nullptr;
+    }
+
+    if (m_internal_state != nullptr) {
+        const auto& state{ std::static_pointer_cast<Internal_State>(m_internal_state) };
+        ::close(state->file_descriptor);
+        m_internal_state = nullptr;
+    }
+
+    m_size = 0;
+}
+
+bool
+Mapped_File::resize(u64 size)
+{
+    if (m_internal_state == nullptr || m_access != Access::READ_WRITE) {
+        debug::Logger::error(
+            debug::LOG_CHANNEL_DEFAULT, "Mapped_File::resize() attempting to resize a file not opened for writing"
+        );
+        return false;
+    }
+
+    const auto& state{ std::static_pointer_cast<Internal_State>(m_internal_state) };
+
+    if (m_data != nullptr) {
+        munmap(m_data, m_size);
+        m_data = nullptr;
+    }
+
+    if (ftruncate(state->file_descriptor, static_cast<off_t>(size)) != 0) {
+        debug::Logger::error(
+            debug::LOG_CHANNEL_DEFAULT,
+            "Mapped_File::resize() failed to resize {}. Error ({})",
+            m_filepath,
+            std::strerror(errno)
+        );
+        m_size = 0;
+        return false;
+    }
+
+    m_size = size;
+    if (m_size == 0) {
+        return true;
+    }
+
+    void* mapping = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, state->file_descriptor, 0);
+    if (mapping == MAP_FAILED) { // NOLINT - MAP_FAILED is a C-style cast.
+        debug::Logger::error(
+            debug::LOG_CHANNEL_DEFAULT, "Mapped_File::resize() failed to map {}. Error ({})", m_filepath, std::strerror(errno)
+        );
+        m_size = 0;
+        return false;
+    }
+
+    m_data = static_cast<u8*>(mapping);
+    return true;
+}
+
+bool
+Mapped_File::sync(u64 offset, u64 length)
+{
+    if (m_data == nullptr || length == 0) {
+        return true;
+    }
+
+    // msync requires a page aligned address.
+    const u64 aligned_offset = offset - (offset % page_size());
+    const u64 aligned_length = std::min(length + (offset - aligned_offset), m_size - aligned_offset);
+
+    return msync(m_data + aligned_offset, aligned_length, MS_SYNC) == 0;
+}
+
+u8*
+Mapped_File::data()
+{
+    return m_data;
+}
+
+const u8*
+Mapped_File::data() const
+{
+    return m_data;
+}
+
+u64
+Mapped_File::size() const
+{
+    return m_size;
+}
+
+bool
+Mapped_File::is_open() const
+{
+    return m_internal_state != nullptr;
+}
+
+const std::string&
+Mapped_File::filepath() const
+{
+    return m_filepath;
+}
+
+u64
+Mapped_File::page_size()
+{
+    static const u64 s_page_size = static_cast<u64>(sysconf(_SC_PAGESIZE));
+    return s_page_size;
+}
+
+}
+
+#endif
@@ -0,0 +1,258 @@
+/**
+ * File: mapped_file_win32.cpp
+ * Project: yuki
+ * File Created: 2026-10-18 13:58:23
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 15:44:33
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "platform/mapped_file.hpp"
+
+#ifdef _WIN32
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+#include "debug/logger.hpp"
+
+namespace {
+
+struct Internal_State {
+    HANDLE file{ INVALID_HANDLE_VALUE };
+    HANDLE mapping{ nullptr };
+};
+
+bool
+map_view(Internal_State& state, yuki::platform::Mapped_File::Access access, u64 size, u8** data)
+{
+    const bool is_read = access == yuki::platform::Mapped_File::Access::READ;
+
+    state.mapping = CreateFileMappingA(
+        state.file,
+        nullptr,
+        is_read ? PAGE_READONLY : PAGE_READWRITE,
+        static_cast<DWORD>(size >> 32),
+        static_cast<DWORD>(size & 0xFFFFFFFF),
+        nullptr
+    );
+    if (state.mapping == nullptr) {
+        return false;
+    }
+
+    void* view = MapViewOfFile(state.mapping, is_read ? FILE_MAP_READ : FILE_MAP_WRITE, 0, 0, static_cast<SIZE_T>(size));
+    if (view == nullptr) {
+        CloseHandle(state.mapping);
+        state.mapping = nullptr;
+        return false;
+    }
+
+    *data = static_cast<u8*>(view);
+    return true;
+}
+
+void
+unmap_view(Internal_State& state, u8** data)
+{
+    if (*data != nullptr) {
+        UnmapViewOfFile(*data);
+        *data = nullptr;
+    }
+
+    if (state.mapping != nullptr) {
+        CloseHandle(state.mapping);
+        state.mapping = nullptr;
+    }
+}
+
+}
+
+namespace yuki::platform {
+
+Mapped_File::Mapped_File()
+  : m_internal_state(nullptr)
+  , m_access(Access::READ)
+  , m_data(nullptr)
+  , m_size(0)
+{
+}
+
+Mapped_File::~Mapped_File()
+{
+    close();
+}
+
+bool
+Mapped_File::open(const std::string& filepath, Access access)
+{
+    close();
+
+    const bool is_read = access == Access::READ;
+    HANDLE file = CreateFileA(
+        filepath.c_str(),
+        is_read ? GENERIC_READ : (GENERIC_READ | GENERIC_WRITE),
+        FILE_SHARE_READ | FILE_SHARE_DELETE,
+        nullptr,
+        is_read ? OPEN_EXISTING : OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) {
+        debug::Logger::error(
+            debug::LOG_CHANNEL_DEFAULT, "Mapped_File::open() failed to open {}. Error ({})", filepath, GetLastError()
+        );
+        return false;
+    }
+
+    LARGE_INTEGER file_size{};
+    if (GetFileSizeEx(file, &file_size) == 0) {
+        debug::Logger::error(
+            debug::LOG_CHANNEL_DEFAULT, "Mapped_File::open() failed to get size of {}. Error ({})", filepath, GetLastError()
+        );
+        CloseHandle(file);
+        return false;
+    }
+
+    auto state = std::make_shared<Internal_State>();
+    state->file = file;
+
+    m_internal_state = state;
+    m_filepath = filepath;
+    m_access = access;
+    m_size = static_cast<u64>(file_size.QuadPart);
+
+    if (m_size == 0) {
+        return true;
+    }
+
+    if (!map_view(*state, m_access, m_size, &m_data)) {
+        debug::Logger::error(
+            debug::LOG_CHANNEL_DEFAULT, "Mapped_File::open() failed to map {}. Error ({})", filepath, GetLastError()
+        );
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void
+Mapped_File::close()
+{
+    if (m_internal_state != nullptr) {
+        const auto& state{ std::static_pointer_cast<Internal_State>(m_internal_state) };
+        unmap_view(*state, &m_data);
+        CloseHandle(state->file);
+        m_internal_state = nullptr;
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool
+Mapped_File::resize(u64 size)
+{
+    if (m_internal_state == nullptr || m_access != Access::READ_WRITE) {
+        debug::Logger::error(
+            debug::LOG_CHANNEL_DEFAULT, "Mapped_File::resize() attempting to resize a file not opened for writing"
+        );
+        return false;
+    }
+
+    const auto& state{ std::static_pointer_cast<Internal_State>(m_internal_state) };
+    unmap_view(*state, &m_data);
+
+    LARGE_INTEGER file_size{};
+    file_size.QuadPart = static_cast<LONGLONG>(size);
+    if (SetFilePointerEx(state->file, file_size, nullptr, FILE_BEGIN) == 0 || SetEndOfFile(state->file) == 0) {
+        debug::Logger::error(
+            debug::LOG_CHANNEL_DEFAULT, "Mapped_File::resize() failed to resize {}. Error ({})", m_filepath, GetLastError()
+        );
+        m_size = 0;
+        return false;
+    }
+
+    m_size = size;
+    if (m_size == 0) {
+        return true;
+    }
+
+    if (!map_view(*state, m_access, m_size, &m_data)) {
+        debug::Logger::error(
+            debug::LOG_CHANNEL_DEFAULT, "Mapped_File::resize() failed to map {}. Error ({})", m_filepath, GetLastError()
+        );
+        m_size = 0;
+        return false;
+    }
+
+    return true;
+}
+
+bool
+Mapped_File::sync(u64 offset, u64 length)
+{
+    if (m_data == nullptr || length == 0) {
+        return true;
+    }
+
+    const auto& state{ std::static_pointer_cast<Internal_State>(m_internal_state) };
+    return FlushViewOfFile(m_data + offset, static_cast<SIZE_T>(length)) != 0 && FlushFileBuffers(state->file) != 0;
+}
+
+u8*
+Mapped_File::data()
+{
+    return m_data;
+}
+
+const u8*
+Mapped_File::data() const
+{
+    return m_data;
+}
+
+u64
+Mapped_File::size() const
+{
+    return m_size;
+}
+
+bool
+Mapped_File::is_open() const
+{
+    return m_internal_state != nullptr;
+}
+
+const std::string&
+Mapped_File::filepath() const
+{
+    return m_filepath;
+}
+
+u64
+Mapped_File::page_size()
+{
+    SYSTEM_INFO system_info{};
+    GetSystemInfo(&system_info);
+    return static_cast<u64>(system_info.dwPageSize);
+}
+
+}
+
+#endif
@@ -3,7 +3,7 @@
  * Project: yuki
  * File Created: 2023-03-12 21:20:07
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-04-26 15:20:01
+ * Last Modified: 2026-10-18 15:44:33
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -60,7 +60,7 @@ Platform::initialize(
 )
 {
     PROFILE_FUNCTION();
-    yuki::debug::Logger::info("yuki", "Initializing Windows platform layer...");
+    yuki::debug::Logger::info(yuki::debug::LOG_CHANNEL_DEFAULT, "Initializing Windows platform layer...");
 
     if (platform_state->internal_state == nullptr) {
         initialize_state(platform_state);
@@ -74,7 +74,7 @@ Platform::initialize(
     state->connection = XGetXCBConnection(state->display);
 
     if (xcb_connection_has_error(state->connection)) {
-        yuki::debug::Logger::critical("yuki", "Failed to connect to X server via XCB.");
+        yuki::debug::Logger::critical(yuki::debug::LOG_CHANNEL_DEFAULT, "Failed to connect to X server via XCB.");
         return false;
     }
 
@@ -145,11 +145,13 @@ Platform::initialize(
     // Flush the stream
     i32 stream_result = xcb_flush(state->connection);
     if (stream_result <= 0) {
-        yuki::debug::Logger::critical("yuki", "An error occurred when flushing the stream: {}", stream_result);
+        yuki::debug::Logger::critical(
+            yuki::debug::LOG_CHANNEL_DEFAULT, "An error occurred when flushing the stream: {}", stream_result
+        );
         return false;
     }
 
-    yuki::debug::Logger::notice("yuki", "Windows platform layer initialized.");
+    yuki::debug::Logger::notice(yuki::debug::LOG_CHANNEL_DEFAULT, "Windows platform layer initialized.");
 
     return true;
 }
@@ -258,7 +260,7 @@ Platform::load_shared_library(const std::string& filepath)
 
     auto* const handle = dlopen(filepath.c_str(), RTLD_LAZY);
     if (handle == nullptr) {
-        yuki::debug::Logger::error("yuki", "Failed to load handle to library {}", filepath);
+        yuki::debug::Logger::error(yuki::debug::LOG_CHANNEL_DEFAULT, "Failed to load handle to library {}", filepath);
         return result;
     }
 
@@ -280,12 +282,14 @@ std::shared_ptr<void (*)()>
 Platform::load_library_function_internal(const Library_Handle& library_handle, const std::string& function_name)
 {
     if (function_name.empty()) {
-        yuki::debug::Logger::error("yuki", "Attempting to load unnamed function from library handle");
+        yuki::debug::Logger::error(yuki::debug::LOG_CHANNEL_DEFAULT, "Attempting to load unnamed function from library handle");
         return nullptr;
     }
 
     if (library_handle.internal_state == nullptr) {
-        yuki::debug::Logger::error("yuki", "Trying to load function {} from null library handle", function_name);
+        yuki::debug::Logger::error(
+            yuki::debug::LOG_CHANNEL_DEFAULT, "Trying to load function {} from null library handle", function_name
+        );
         return nullptr;
     }
 
@@ -294,7 +298,10 @@ Platform::load_library_function_internal(const Library_Handle& library_handle, c
     const auto proc_address{ dlsym(library.get(), function_name.c_str()) };
     if (proc_address == nullptr) {
         yuki::debug::Logger::error(
-            "yuki", "Failed to load handle to function {} from library {}", function_name, library_handle.filepath
+            yuki::debug::LOG_CHANNEL_DEFAULT,
+            "Failed to load handle to function {} from library {}",
+            function_name,
+            library_handle.filepath
         );
         return nullptr;
     }
@@ -3,7 +3,7 @@
  * Project: yuki
  * File Created: 2023-03-12 21:20:07
  * Author: Rob Graham (robgrahamdev@gmail.com)
- * Last Modified: 2023-04-09 16:07:16
+ * Last Modified: 2026-10-18 15:44:33
  * ------------------
  * Copyright 2023 Rob Graham
  * ==================
@@ -161,7 +161,7 @@ Platform::initialize(
 )
 {
     PROFILE_FUNCTION();
-    yuki::debug::Logger::info("yuki", "Initializing Windows platform layer...");
+    yuki::debug::Logger::info(yuki::debug::LOG_CHANNEL_DEFAULT, "Initializing Windows platform layer...");
 
     if (platform_state->internal_state == nullptr) {
         initialize_state(platform_state);
@@ -224,12 +224,12 @@ Platform::initialize(
     if (handle == nullptr) {
         MessageBox(nullptr, "Window creation failed.", "Error", MB_ICONEXCLAMATION | MB_OK);
 
-        yuki::debug::Logger::critical("yuki", "Platform::initialize() failed for win32");
+        yuki::debug::Logger::critical(yuki::debug::LOG_CHANNEL_DEFAULT, "Platform::initialize() failed for win32");
         return false;
     }
     state->window_handle = handle;
 
-    yuki::debug::Logger::notice("yuki", "Windows platform layer initialized.");
+    yuki::debug::Logger::notice(yuki::debug::LOG_CHANNEL_DEFAULT, "Windows platform layer initialized.");
 
     return true;
 }
@@ -310,7 +310,7 @@ Platform::load_shared_library(const std::string& filepath)
     auto* const h_instance{ LoadLibrary(TEXT(filepath.c_str())) };
     if (h_instance == nullptr) {
         const auto err = GetLastError();
-        yuki::debug::Logger::error("yuki", "Failed to load handle to library {} {}", filepath, err);
+        yuki::debug::Logger::error(yuki::debug::LOG_CHANNEL_DEFAULT, "Failed to load handle to library {} {}", filepath, err);
         return result;
     }
 
@@ -332,12 +332,16 @@ std::shared_ptr<void (*)()>
 Platform::load_library_function_internal(const Library_Handle& library_handle, const std::string& function_name)
 {
     if (function_name.empty()) {
-        yuki::debug::Logger::error("yuki", "Attempting to load unnamed function from library handle", function_name);
+        yuki::debug::Logger::error(
+            yuki::debug::LOG_CHANNEL_DEFAULT, "Attempting to load unnamed function from library handle", function_name
+        );
         return nullptr;
     }
 
     if (library_handle.internal_state == nullptr) {
-        yuki::debug::Logger::error("yuki", "Trying to load function {} from null library handle", function_name);
+        yuki::debug::Logger::error(
+            yuki::debug::LOG_CHANNEL_DEFAULT, "Trying to load function {} from null library handle", function_name
+        );
         return nullptr;
     }
 
@@ -346,7 +350,10 @@ Platform::load_library_function_internal(const Library_Handle& library_handle, c
     const auto proc_address{ GetProcAddress(*library, function_name.c_str()) };
     if (proc_address == nullptr) {
         yuki::debug::Logger::error(
-            "yuki", "Failed to load handle to function {} from library {}", function_name, library_handle.filepath
+            yuki::debug::LOG_CHANNEL_DEFAULT,
+            "Failed to load handle to function {} from library {}",
+            function_name,
+            library_handle.filepath
         );
         return nullptr;
     }
@@ -0,0 +1,93 @@
+/**
+ * File: thread_pool.cpp
+ * Project: yuki
+ * File Created: 2026-10-18 14:37:38
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 14:39:39
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace yuki {
+
+Thread_Pool::Thread_Pool(u32 thread_count)
+{
+    if (thread_count == 0) {
+        // hardware_concurrency may report 0 when it can't be determined.
+        thread_count = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+    }
+
+    m_threads.reserve(thread_count);
+    for (u32 i = 0; i < thread_count; ++i) {
+        m_threads.emplace_back(&Thread_Pool::run_worker, this);
+    }
+}
+
+Thread_Pool::~Thread_Pool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+u32
+Thread_Pool::thread_count() const
+{
+    return static_cast<u32>(m_threads.size());
+}
+
+void
+Thread_Pool::push(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+void
+Thread_Pool::run_worker()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty()) {
+                return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        task();
+    }
+}
+
+}
@@ -0,0 +1,135 @@
+/**
+ * File: main.cpp
+ * Project: yuki
+ * File Created: 2026-10-18 14:18:09
+ * Author: Rob Graham (robgrahamdev@gmail.com)
+ * Last Modified: 2026-10-18 16:26:49
+ * ------------------
+ * Copyright 2023 Rob Graham
+ * ==================
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ==================
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "yuki/types.hpp"
+
+#include "yuki/debug/trace_file.hpp"
+
+namespace {
+
+void
+print_usage()
+{
+    std::cerr << "usage: yuki_trace_convert <segment.ytrace>... -o <output.json>\n"
+              << "Converts binary trace segments into a single Chrome trace json file, which can be opened in\n"
+              << "chrome://tracing or https://ui.perfetto.dev\n";
+}
+
+// The JSON is written out whenever this much is buffered, so the output never has to fit in memory.
+constexpr size_t OUTPUT_FLUSH_SIZE = 1024 * 1024;
+
+struct Segment {
+    std::string filepath;
+    u32 index;
+};
+
+}
+
+int
+main(int argc, char** argv)
+{
+    const std::vector<std::string> args(argv + 1, argv + argc); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    std::string output_filepath;
+    std::vector<Segment> segments;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "-o" && i + 1 < args.size()) {
+            output_filepath = args[++i];
+        }
+        else if (args[i] == "-h" || args[i] == "--help") {
+            print_usage();
+            return 0;
+        }
+        else {
+            segments.push_back({ args[i], 0 });
+        }
+    }
+
+    if (output_filepath.empty() || segments.empty()) {
+        print_usage();
+        return 1;
+    }
+
+    // Validate every segment up front & convert them in the order they were written, whatever order they were passed in.
+    for (auto& segment : segments) {
+        yuki::debug::Trace_Reader reader;
+        if (!reader.open(segment.filepath)) {
+            std::cerr << "Failed to open trace segment " << segment.filepath << "\n";
+            return 1;
+        }
+        segment.index = reader.segment_index();
+    }
+    std::sort(segments.begin(), segments.end(), [](const Segment& a, const Segment& b) { return a.index < b.index; });
+
+    std::ofstream output_stream(output_filepath);
+    if (!output_stream.is_open()) {
+        std::cerr << "Failed to open output file " << output_filepath << "\n";
+        return 1;
+    }
+
+    std::string output;
+    yuki::debug::append_json_header(output);
+
+    u64 event_count = 0;
+    for (const auto& segment : segments) {
+        yuki::debug::Trace_Reader reader;
+        reader.open(segment.filepath);
+
+        while (const auto record = reader.next()) {
+            if (*record == yuki::debug::Trace_Record::EVENT) {
+                yuki::debug::append_json_event(output, reader.event(), reader.thread_index());
+                event_count++;
+            }
+            else if (*record == yuki::debug::Trace_Record::THREAD) {
+                yuki::debug::append_json_thread(output, reader.thread_index(), reader.dropped_events());
+            }
+
+            if (output.size() >= OUTPUT_FLUSH_SIZE) {
+                output_stream << output;
+                output.clear();
+            }
+        }
+
+        // A segment cut short by a crash is still worth converting up to the last complete record.
+        if (reader.has_error()) {
+            std::cerr << "Trace segment " << segment.filepath << " is truncated or malformed, skipping the rest of it\n";
+        }
+
+        output_stream << output;
+        output.clear();
+    }
+
+    yuki::debug::append_json_footer(output);
+    output_stream << output;
+
+    std::cout << "Converted " << event_count << " events from " << segments.size() << " segments to " << output_filepath
+              << "\n";
+    return 0;
+}